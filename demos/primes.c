@@ -33,11 +33,8 @@ this program.  If not, see https://www.gnu.org/licenses/.  */
  * Pre-fill sieving array with an appropriately aligned ...00100100... pattern,
    then omit 3 from primes array.  (May require similar special handling of 3
    as we now have for 2.)
- * A large SIEVE_LIMIT currently implies very large memory usage, mainly due
-   to the sieving array in make_primelist, but also because of the primes[]
-   array.  We might want to stage the program, using sieve_region/find_primes
-   to build primes[].  Make report() a function pointer, as part of achieving
-   this.
+ * A large SIEVE_LIMIT currently implies very large memory usage, because
+   of the primes[] array.
  * Store primes[] as two arrays, one array with primes represented as delta
    values using just 8 bits (if gaps are too big, store bogus primes!)
    and one array with "rem" values.  The latter needs 32-bit values.
@@ -160,6 +157,27 @@ main (int argc, char *argv[])
       exit (1);
     }
 
+  /* Ranges within an unsigned long are simply iterated over.  */
+  if (mpz_fits_ulong_p (to))
+    {
+      gmp_primeiter_t it;
+      unsigned long p;
+
+      if (mpz_sgn (fr) < 0)
+	mpz_set_ui (fr, 0);
+      if (mpz_cmp (fr, to) <= 0)
+	{
+	  gmp_primeiter_init (it, mpz_get_ui (fr), mpz_get_ui (to));
+	  while ((p = gmp_primeiter_next (it)) != 0)
+	    {
+	      mpz_set_ui (fr2, p);
+	      report (fr2);
+	    }
+	  gmp_primeiter_clear (it);
+	}
+      goto done;
+    }
+
   mpz_set (fr2, fr);
   if (mpz_cmp_ui (fr2, 3) < 0)
     {
@@ -225,6 +243,7 @@ main (int argc, char *argv[])
     }
   free (s);
 
+ done:
   if (flag_count)
     printf ("Pi(interval) = %lu\n", total_primes);
 
@@ -340,48 +359,16 @@ find_primes (unsigned char *s, mpz_t  fr, unsigned long ssize,
 void
 make_primelist (unsigned long maxprime)
 {
-#if 1
-  unsigned char *s;
-  unsigned long ssize = maxprime / 2;
-  unsigned long i, ii, j;
+  gmp_primeiter_t it;
+  unsigned long p;
 
-  s = malloc (ssize);
-  memset (s, ~0, ssize);
-  for (i = 3; ; i += 2)
-    {
-      unsigned long isqr = i * i;
-      if (isqr >= maxprime)
-	break;
-      if (s[i * i / 2 - 1] == 0)
-	continue;				/* only sieve with primes */
-      for (ii = i * i / 2 - 1; ii < ssize; ii += i)
-	s[ii] = 0;
-    }
-  n_primes = 0;
-  for (j = 0; j < ssize; j++)
-    {
-      if (s[j] != 0)
-	{
-	  primes[n_primes].prime = j * 2 + 3;
-	  primes[n_primes].rem = -1;
-	  n_primes++;
-	}
-    }
-  /* FIXME: This should not be needed if fencepost errors were fixed... */
-  if (primes[n_primes - 1].prime > maxprime)
-    n_primes--;
-  free (s);
-#else
-  unsigned long i;
   n_primes = 0;
-  for (i = 3; i <= maxprime; i += 2)
+  gmp_primeiter_init (it, 3, maxprime);
+  while ((p = gmp_primeiter_next (it)) != 0)
     {
-      if (i < 7 || (i % 3 != 0 && i % 5 != 0 && i % 7 != 0))
-	{
-	  primes[n_primes].prime = i;
-	  primes[n_primes].rem = -1;
-	  n_primes++;
-	}
+      primes[n_primes].prime = p;
+      primes[n_primes].rem = -1;
+      n_primes++;
     }
-#endif
+  gmp_primeiter_clear (it);
 }
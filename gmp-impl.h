@@ -255,6 +255,16 @@ typedef size_t              gmp_intptr_t;
 typedef struct {mp_limb_t inv32;} gmp_pi1_t;
 typedef struct {mp_limb_t inv21, inv32, inv53;} gmp_pi2_t;
 
+/* a modulus 2^k - c, or 2^k + c if neg, with a small c, see mod_2expc.c */
+typedef struct {mp_srcptr cp; mp_size_t cn; mp_bitcnt_t k; int neg;} gmp_2expc_t;
+
+/* Whether the one limb c special case in mod_2expc.c applies, a one limb c
+   below 2^(k mod B), with k in the top limb of the n limb modulus.  */
+#define MOD_2EXPC_1_P(red, n)						\
+  ((red)->cn == 1 && (red)->k > ((n) - 1) * GMP_NUMB_BITS		\
+   && ((red)->k % GMP_NUMB_BITS == 0					\
+       || ((red)->cp[0] >> (red)->k % GMP_NUMB_BITS) == 0))
+
 
 /* "const" basically means a function does nothing but examine its arguments
    and give a return value, it doesn't read or write any memory (neither
@@ -625,6 +635,14 @@ __GMP_DECLSPEC void  __gmp_tmp_debug_free (const char *, int, int,
 #define SQR_FFT_THRESHOLD                MP_SIZE_T_MAX
 #endif
 
+/* mpn/generic/mul_ntt.c is only for 64-bit limbs. */
+#if GMP_NUMB_BITS != 64
+#undef  MUL_NTT_THRESHOLD
+#undef  SQR_NTT_THRESHOLD
+#define MUL_NTT_THRESHOLD                MP_SIZE_T_MAX
+#define SQR_NTT_THRESHOLD                MP_SIZE_T_MAX
+#endif
+
 /* Swap macros. */
 
 #define MP_LIMB_T_SWAP(x, y)						\
@@ -701,6 +719,15 @@ __GMP_DECLSPEC void *__gmp_default_allocate (size_t);
 __GMP_DECLSPEC void *__gmp_default_reallocate (void *, size_t, size_t);
 __GMP_DECLSPEC void __gmp_default_free (void *, size_t);
 
+/* Run func(arg,i) for 0 <= i < n, spread over the threads of the pool in
+   parallel.c, and return when all are done.  Items must not write to any
+   common memory.  __gmp_parallel_threads is how many threads it's worth
+   splitting work into, 1 unless GMP is built with --enable-threads and the
+   application called mp_set_num_threads.  */
+typedef void (*gmp_parallel_func_t) (void *, mp_size_t);
+__GMP_DECLSPEC void __gmp_parallel_run (gmp_parallel_func_t, void *, mp_size_t);
+__GMP_DECLSPEC int __gmp_parallel_threads (void);
+
 #define __GMP_ALLOCATE_FUNC_TYPE(n,type) \
   ((type *) (*__gmp_allocate_func) ((n) * sizeof (type)))
 #define __GMP_ALLOCATE_FUNC_LIMBS(n)   __GMP_ALLOCATE_FUNC_TYPE (n, mp_limb_t)
@@ -1128,6 +1155,11 @@ __GMP_DECLSPEC mp_limb_t mpn_redc_2 (mp_ptr, mp_ptr, mp_srcptr, mp_size_t, mp_sr
 #define mpn_redc_n __MPN(redc_n)
 __GMP_DECLSPEC void mpn_redc_n (mp_ptr, mp_ptr, mp_srcptr, mp_size_t, mp_srcptr);
 
+#define mpn_redc_inverse __MPN(redc_inverse)
+__GMP_DECLSPEC void mpn_redc_inverse (mp_ptr, mp_srcptr, mp_size_t, mp_ptr);
+#define mpn_redc __MPN(redc)
+__GMP_DECLSPEC void mpn_redc (mp_ptr, mp_ptr, mp_srcptr, mp_size_t, mp_srcptr);
+
 
 #ifndef mpn_mod_1_1p_cps  /* if not done with cpuvec in a fat binary */
 #define mpn_mod_1_1p_cps __MPN(mod_1_1p_cps)
@@ -1328,6 +1360,28 @@ __GMP_DECLSPEC void      mpn_toom_interpolate_16pts (mp_ptr, mp_ptr, mp_ptr, mp_
 #define   mpn_toom_couple_handling __MPN(toom_couple_handling)
 __GMP_DECLSPEC void mpn_toom_couple_handling (mp_ptr, mp_size_t, mp_ptr, int, mp_size_t, int, int);
 
+/* One of the independent products of a Toom multiplication, for
+   mpn_toom_mul_par.  */
+struct toom_mul_item
+{
+  mp_ptr p;
+  mp_srcptr a;
+  mp_size_t an;
+  mp_srcptr b;
+  mp_size_t bn;
+};
+#define TOOM_MUL_ITEM(it, rp, up, un, vp, vn)				\
+  do {									\
+    (it).p = (rp);							\
+    (it).a = (up);							\
+    (it).an = (un);							\
+    (it).b = (vp);							\
+    (it).bn = (vn);							\
+  } while (0)
+
+#define   mpn_toom_mul_par __MPN(toom_mul_par)
+__GMP_DECLSPEC void mpn_toom_mul_par (struct toom_mul_item *, int);
+
 #define   mpn_toom_eval_dgr3_pm1 __MPN(toom_eval_dgr3_pm1)
 __GMP_DECLSPEC int mpn_toom_eval_dgr3_pm1 (mp_ptr, mp_ptr, mp_srcptr, mp_size_t, mp_size_t, mp_ptr);
 
@@ -1412,9 +1466,42 @@ __GMP_DECLSPEC mp_limb_t mpn_mul_fft (mp_ptr, mp_size_t, mp_srcptr, mp_size_t, m
 #define   mpn_mul_fft_full __MPN(mul_fft_full)
 __GMP_DECLSPEC void      mpn_mul_fft_full (mp_ptr, mp_srcptr, mp_size_t, mp_srcptr, mp_size_t);
 
+/* One operand of mpn_mul_fft, already split and transformed, for repeated
+   multiplications by the same value.  */
+struct mul_fft_precomp
+{
+  mp_size_t pl;
+  int k;
+  mp_size_t nprime;
+  mp_size_t omega;
+  mp_ptr *Bp;			/* the K transformed coefficients */
+  mp_ptr B;			/* their storage, K*(nprime+1) limbs */
+};
+
+#define   mpn_mul_fft_precomp_init __MPN(mul_fft_precomp_init)
+__GMP_DECLSPEC void      mpn_mul_fft_precomp_init (struct mul_fft_precomp *, mp_size_t, mp_srcptr, mp_size_t, int);
+
+#define   mpn_mul_fft_precomp __MPN(mul_fft_precomp)
+__GMP_DECLSPEC mp_limb_t mpn_mul_fft_precomp (mp_ptr, mp_srcptr, mp_size_t, const struct mul_fft_precomp *);
+
+#define   mpn_mul_fft_precomp_clear __MPN(mul_fft_precomp_clear)
+__GMP_DECLSPEC void      mpn_mul_fft_precomp_clear (struct mul_fft_precomp *);
+
+#define   mpn_mulmod_bnm1_precomp_init __MPN(mulmod_bnm1_precomp_init)
+__GMP_DECLSPEC struct mul_fft_precomp *mpn_mulmod_bnm1_precomp_init (mp_size_t, mp_srcptr, mp_size_t);
+
+#define   mpn_mulmod_bnm1_precomp __MPN(mulmod_bnm1_precomp)
+__GMP_DECLSPEC void      mpn_mulmod_bnm1_precomp (mp_ptr, mp_size_t, mp_srcptr, mp_size_t, mp_srcptr, mp_size_t, const struct mul_fft_precomp *, mp_ptr);
+
+#define   mpn_mulmod_bnm1_precomp_clear __MPN(mulmod_bnm1_precomp_clear)
+__GMP_DECLSPEC void      mpn_mulmod_bnm1_precomp_clear (struct mul_fft_precomp *);
+
 #define   mpn_nussbaumer_mul __MPN(nussbaumer_mul)
 __GMP_DECLSPEC void      mpn_nussbaumer_mul (mp_ptr, mp_srcptr, mp_size_t, mp_srcptr, mp_size_t);
 
+#define   mpn_mul_ntt __MPN(mul_ntt)
+__GMP_DECLSPEC void      mpn_mul_ntt (mp_ptr, mp_srcptr, mp_size_t, mp_srcptr, mp_size_t);
+
 #define   mpn_fft_next_size __MPN(fft_next_size)
 __GMP_DECLSPEC mp_size_t mpn_fft_next_size (mp_size_t, int) ATTRIBUTE_CONST;
 
@@ -1556,9 +1643,64 @@ __GMP_DECLSPEC mp_limb_t mpn_bdiv_dbm1c (mp_ptr, mp_srcptr, mp_size_t, mp_limb_t
 
 #define   mpn_powm __MPN(powm)
 __GMP_DECLSPEC void      mpn_powm (mp_ptr, mp_srcptr, mp_size_t, mp_srcptr, mp_size_t, mp_srcptr, mp_size_t, mp_ptr);
+#define   mpn_powm_52x8 __MPN(powm_52x8)
+__GMP_DECLSPEC void      mpn_powm_52x8 (mp_ptr *, mp_srcptr *, mp_srcptr *, mp_size_t, mp_srcptr *, mp_size_t);
+#define   mpn_amm52_8 __MPN(amm52_8)
+__GMP_DECLSPEC void      mpn_amm52_8 (mp_ptr, mp_srcptr, mp_srcptr, mp_srcptr, mp_srcptr, mp_size_t);
+#define   mpn_powm_multi __MPN(powm_multi)
+__GMP_DECLSPEC void      mpn_powm_multi (mp_ptr, mp_srcptr *, mp_srcptr *, const mp_size_t *, mp_size_t, mp_srcptr, mp_size_t);
+#define   mpn_powm_multi_redc __MPN(powm_multi_redc)
+__GMP_DECLSPEC void      mpn_powm_multi_redc (mp_ptr, mp_srcptr *, mp_srcptr *, const mp_size_t *, mp_size_t, mp_srcptr, mp_size_t, mp_srcptr);
+#define   mpn_powm_2expc __MPN(powm_2expc)
+__GMP_DECLSPEC void      mpn_powm_2expc (mp_ptr, mp_srcptr, mp_size_t, mp_srcptr, mp_size_t, mp_srcptr, mp_size_t, const gmp_2expc_t *);
+#define   mpn_mod_2expc_init __MPN(mod_2expc_init)
+__GMP_DECLSPEC int       mpn_mod_2expc_init (gmp_2expc_t *, mp_ptr, mp_srcptr, mp_size_t);
+#define   mpn_mod_2expc __MPN(mod_2expc)
+__GMP_DECLSPEC void      mpn_mod_2expc (mp_ptr, mp_srcptr, mp_size_t, mp_srcptr, mp_size_t, const gmp_2expc_t *, mp_ptr);
+#define   mpn_mod_2expc_itch(xn, n)  (3 * MIN (xn, 2 * (n)) + 9 * (n) + 9)
 #define   mpn_powlo __MPN(powlo)
 __GMP_DECLSPEC void      mpn_powlo (mp_ptr, mp_srcptr, mp_srcptr, mp_size_t, mp_size_t, mp_ptr);
 
+/* Exponent windows for the sliding window loops of mpn_powm and
+   mpn_powm_2expc.  Bit bi-1 of p, the nbits bits below bit bi (or all of
+   them if there are fewer), and the window size for an eb bit exponent.  */
+#define mpn_powm_getbit(p,bi) \
+  ((p[(bi - 1) / GMP_LIMB_BITS] >> (bi - 1) % GMP_LIMB_BITS) & 1)
+
+static inline mp_limb_t
+mpn_powm_getbits (const mp_limb_t *p, mp_bitcnt_t bi, int nbits)
+{
+  int nbits_in_r;
+  mp_limb_t r;
+  mp_size_t i;
+
+  if (bi < nbits)
+    {
+      return p[0] & (((mp_limb_t) 1 << bi) - 1);
+    }
+  else
+    {
+      bi -= nbits;			/* bit index of low bit to extract */
+      i = bi / GMP_NUMB_BITS;		/* word index of low bit to extract */
+      bi %= GMP_NUMB_BITS;		/* bit index in low word */
+      r = p[i] >> bi;			/* extract (low) bits */
+      nbits_in_r = GMP_NUMB_BITS - bi;	/* number of bits now in r */
+      if (nbits_in_r < nbits)		/* did we get enough bits? */
+	r += p[i + 1] << nbits_in_r;	/* prepend bits from higher word */
+      return r & (((mp_limb_t ) 1 << nbits) - 1);
+    }
+}
+
+static inline int
+mpn_powm_win_size (mp_bitcnt_t eb)
+{
+  int k;
+  static const mp_bitcnt_t x[] = {0,7,25,81,241,673,1793,4609,11521,28161,~(mp_bitcnt_t)0};
+  for (k = 1; eb > x[k]; k++)
+    ;
+  return k;
+}
+
 #define mpn_sec_pi1_div_qr __MPN(sec_pi1_div_qr)
 __GMP_DECLSPEC mp_limb_t mpn_sec_pi1_div_qr (mp_ptr, mp_ptr, mp_size_t, mp_srcptr, mp_size_t, mp_limb_t, mp_ptr);
 #define mpn_sec_pi1_div_r __MPN(sec_pi1_div_r)
@@ -1663,6 +1805,24 @@ __GMP_DECLSPEC void    mpz_divexact_gcd (mpz_ptr, mpz_srcptr, mpz_srcptr);
 #define mpz_prodlimbs  __gmpz_prodlimbs
 __GMP_DECLSPEC mp_size_t mpz_prodlimbs (mpz_ptr, mp_ptr, mp_size_t);
 
+/* The first node of the level of a product tree of k leaves at which to
+   split it into subtrees for threads, or 0 if it's not worth it.  */
+#define mpz_product_tree_split  __gmpz_product_tree_split
+__GMP_DECLSPEC size_t mpz_product_tree_split (size_t, mp_size_t);
+
+#define mpz_stronglucas  __gmpz_stronglucas
+__GMP_DECLSPEC int mpz_stronglucas (mpz_srcptr);
+
+/* mpz_millerrabin, but giving up with 0 between rounds once stop(arg) is
+   non-zero.  stop can be NULL.  */
+#define mpz_millerrabin_stop  __gmpz_millerrabin_stop
+__GMP_DECLSPEC int mpz_millerrabin_stop (mpz_srcptr, int, int (*) (void *), void *);
+
+/* The index of the first of n numbers mpz_millerrabin finds prime, with
+   its result stored, or n if there's none.  */
+#define mpz_millerrabin_first  __gmpz_millerrabin_first
+__GMP_DECLSPEC mp_size_t mpz_millerrabin_first (int *, const mpz_srcptr *, mp_size_t, int);
+
 #define mpz_oddfac_1  __gmpz_oddfac_1
 __GMP_DECLSPEC void mpz_oddfac_1 (mpz_ptr, mp_limb_t, unsigned);
 
@@ -2243,6 +2403,21 @@ __GMP_DECLSPEC mp_limb_t gmp_primesieve (mp_ptr, mp_limb_t);
 
 #endif /* HAVE_NATIVE_mpn_addmul_2 || HAVE_NATIVE_mpn_redc_2 */
 
+/* Sizes from which folding by mpn_mod_2expc beats REDC for products, in
+   mpz_powm and mpz_modctx_t.  For a one limb c that's from quite small
+   sizes, otherwise only once REDC costs well more than a multiplication
+   by c.  */
+#ifndef POWM_2EXPC_1_THRESHOLD
+#define POWM_2EXPC_1_THRESHOLD            3
+#endif
+#ifndef POWM_2EXPC_THRESHOLD
+#define POWM_2EXPC_THRESHOLD             12
+#endif
+#define POWM_2EXPC_P(red, n)						\
+  (ABOVE_THRESHOLD (n, POWM_2EXPC_THRESHOLD)				\
+   || (ABOVE_THRESHOLD (n, POWM_2EXPC_1_THRESHOLD)			\
+       && MOD_2EXPC_1_P (red, n)))
+
 
 /* First k to use for an FFT modF multiply.  A modF FFT is an order
    log(2^k)/log(2^(k-1)) algorithm, so k=3 is merely 1.5 like karatsuba,
@@ -2269,6 +2444,62 @@ __GMP_DECLSPEC mp_limb_t gmp_primesieve (mp_ptr, mp_limb_t);
 #define SQR_FFT_THRESHOLD   (SQR_FFT_MODF_THRESHOLD * 10)
 #endif
 
+/* Threshold at which the three-prime NTT should be used instead of the FFT
+   for an NxN -> 2N multiply.  Off unless tuned, since whether and where it
+   wins depends a lot on the speed of umul_ppmm.  */
+#ifndef MUL_NTT_THRESHOLD
+#define MUL_NTT_THRESHOLD   MP_SIZE_T_MAX
+#endif
+#ifndef SQR_NTT_THRESHOLD
+#define SQR_NTT_THRESHOLD   MP_SIZE_T_MAX
+#endif
+
+/* Size of a modF FFT multiply, in limbs, from which its transforms and
+   pointwise products are spread over threads, when mp_set_num_threads has
+   asked for more than one.  */
+#ifndef MUL_FFT_PARALLEL_THRESHOLD
+#define MUL_FFT_PARALLEL_THRESHOLD   10000
+#endif
+
+/* Operand size, in limbs, from which toom44, toom6h and toom8h hand their
+   pointwise products to threads, when there's more than one.  */
+#ifndef MUL_TOOM_PARALLEL_THRESHOLD
+#define MUL_TOOM_PARALLEL_THRESHOLD  2000
+#endif
+
+/* The same for toom4_sqr, toom6_sqr and toom8_sqr.  */
+#ifndef SQR_TOOM_PARALLEL_THRESHOLD
+#define SQR_TOOM_PARALLEL_THRESHOLD  2000
+#endif
+
+/* Size of the smaller operand, in limbs, from which mpn_mul splits a
+   product with un >= 2vn into pieces done on separate threads, when there's
+   more than one.  */
+#ifndef PARALLEL_MUL_THRESHOLD
+#define PARALLEL_MUL_THRESHOLD       500
+#endif
+
+/* Number of elements times their size in limbs from which
+   mpz_invert_batch forms its prefix products on separate threads, when
+   there's more than one.  */
+#ifndef INVERT_BATCH_PARALLEL_THRESHOLD
+#define INVERT_BATCH_PARALLEL_THRESHOLD  2000
+#endif
+
+/* Size in limbs of the product of all the moduli from which a product
+   tree is built, and a remainder tree descended, a subtree per thread,
+   when there's more than one.  */
+#ifndef PRODUCT_TREE_PARALLEL_THRESHOLD
+#define PRODUCT_TREE_PARALLEL_THRESHOLD  1000
+#endif
+
+/* Size in limbs of the numbers from which mpz_nextprime and mpz_prevprime
+   test their candidates on separate threads, when there's more than
+   one.  */
+#ifndef NEXTPRIME_PARALLEL_THRESHOLD
+#define NEXTPRIME_PARALLEL_THRESHOLD  4
+#endif
+
 /* Table of thresholds for successive modF FFT "k"s.  The first entry is
    where FFT_FIRST_K+1 should be used, the second FFT_FIRST_K+2,
    etc.  See mpn_fft_best_k(). */
@@ -4744,6 +4975,14 @@ extern mp_size_t			mul_fft_threshold;
 #define MUL_FFT_MODF_THRESHOLD		mul_fft_modf_threshold
 extern mp_size_t			mul_fft_modf_threshold;
 
+#undef	MUL_NTT_THRESHOLD
+#define MUL_NTT_THRESHOLD		mul_ntt_threshold
+extern mp_size_t			mul_ntt_threshold;
+
+#undef	PARALLEL_MUL_THRESHOLD
+#define PARALLEL_MUL_THRESHOLD		parallel_mul_threshold
+extern mp_size_t			parallel_mul_threshold;
+
 #undef	MUL_FFT_TABLE
 #define MUL_FFT_TABLE			{ 0 }
 
@@ -4791,6 +5030,10 @@ extern mp_size_t			sqr_fft_threshold;
 #define SQR_FFT_MODF_THRESHOLD		sqr_fft_modf_threshold
 extern mp_size_t			sqr_fft_modf_threshold;
 
+#undef  SQR_NTT_THRESHOLD
+#define SQR_NTT_THRESHOLD		sqr_ntt_threshold
+extern mp_size_t			sqr_ntt_threshold;
+
 #undef	SQR_FFT_TABLE
 #define SQR_FFT_TABLE			{ 0 }
 
@@ -1364,6 +1364,7 @@ define_mpn(addmul_2s)
 define_mpn(add_n_sub_n)
 define_mpn(add_n_sub_nc)
 define_mpn(addaddmul_1msb0)
+define_mpn(amm52_8)
 define_mpn(and_n)
 define_mpn(andn_n)
 define_mpn(bdiv_q_1)
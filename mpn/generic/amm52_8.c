@@ -0,0 +1,124 @@
+/* mpn_amm52_8 -- eight almost Montgomery multiplications side by side, in
+   52-bit digits.
+
+   THIS IS AN INTERNAL FUNCTION WITH A MUTABLE INTERFACE.  IT IS ONLY
+   SAFE TO REACH THIS FUNCTION THROUGH DOCUMENTED INTERFACES.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "longlong.h"
+
+/* The operands are 8 lanes of d digits of 52 bits, interleaved, so digit j
+   of lane l is at xp[8j+l], and each lane is an independent computation
+   with its own modulus m and k = -1/m mod 2^52.  In each lane,
+
+	r = (a b + q m) / 2^(52d)
+
+   for the q < 2^(52d) making the division exact.  That's a b / 2^(52d) mod
+   m, and below a b / 2^(52d) + m, so with a, b < 2m and 4m < 2^(52d) the
+   result is again below 2m and can go straight into the next
+   multiplication, without the final subtraction of plain Montgomery.
+
+   This is word by word Montgomery, a digit of a at a time, with the sums
+   for each digit position left unnormalised in a 64-bit word, which is
+   how a vector multiply-add of 52-bit halves, as in AVX-512 IFMA, does it
+   in an 8 word register.  A position gets 4 products of 52 bits on each
+   step, hence d < 1024.  The carries are propagated once at the end.
+
+   rp must not overlap the other operands, it holds the sums meanwhile.
+   Digits are 52 bits of a limb, so this is only for 64-bit limbs.  */
+
+#define LANES  8
+#define DBITS  52
+#define DMASK  ((CNST_LIMB(1) << DBITS) - 1)
+
+/* The low and high 52 bits of the product of two 52-bit digits.  */
+#define MUL52(h, l, x, y)						\
+  do {									\
+    mp_limb_t __h, __l;							\
+    umul_ppmm (__h, __l, x, y);						\
+    (l) = __l & DMASK;							\
+    (h) = (__h << (GMP_LIMB_BITS - DBITS)) | (__l >> DBITS);		\
+  } while (0)
+
+void
+mpn_amm52_8 (mp_ptr rp, mp_srcptr ap, mp_srcptr bp, mp_srcptr mp,
+	     mp_srcptr kp, mp_size_t d)
+{
+#if GMP_NAIL_BITS == 0 && GMP_LIMB_BITS == 64
+  mp_limb_t a, q, t, ph, pl, qh, ql;
+  mp_size_t i, j;
+  int l;
+
+  ASSERT (d >= 2 && d < 1024);
+  ASSERT (! MPN_OVERLAP_P (rp, LANES * d, ap, LANES * d));
+  ASSERT (! MPN_OVERLAP_P (rp, LANES * d, bp, LANES * d));
+
+  MPN_ZERO (rp, LANES * d);
+
+  for (i = 0; i < d; i++)
+    for (l = 0; l < LANES; l++)
+      {
+	a = ap[LANES * i + l];
+
+	/* the low position, making it zero with q m */
+	MUL52 (ph, pl, a, bp[l]);
+	t = rp[l] + pl;
+	q = (t * kp[l]) & DMASK;
+	MUL52 (qh, ql, q, mp[l]);
+	t = ((t + ql) >> DBITS) + ph + qh;
+
+	/* the rest, moved down a position */
+	for (j = 1; j < d; j++)
+	  {
+	    MUL52 (ph, pl, a, bp[LANES * j + l]);
+	    MUL52 (qh, ql, q, mp[LANES * j + l]);
+	    rp[LANES * (j - 1) + l] = rp[LANES * j + l] + t + pl + ql;
+	    t = ph + qh;
+	  }
+	rp[LANES * (d - 1) + l] = t;
+      }
+
+  for (l = 0; l < LANES; l++)
+    {
+      t = 0;
+      for (j = 0; j < d; j++)
+	{
+	  t += rp[LANES * j + l];
+	  rp[LANES * j + l] = t & DMASK;
+	  t >>= DBITS;
+	}
+      ASSERT (t == 0);
+    }
+#else
+  ASSERT_ALWAYS (0);
+#endif
+}
@@ -0,0 +1,342 @@
+/* mpn_mod_2expc_init, mpn_mod_2expc -- reduction modulo 2^k - c or 2^k + c
+   for small c.
+
+   THE FUNCTIONS IN THIS FILE ARE INTERNAL WITH MUTABLE INTERFACES.  IT IS ONLY
+   SAFE TO REACH THEM THROUGH DOCUMENTED INTERFACES.  IN FACT, IT IS ALMOST
+   GUARANTEED THAT THEY WILL CHANGE OR DISAPPEAR IN A FUTURE GMP RELEASE.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "longlong.h"
+
+
+/* For m = 2^k - c, a number x = h 2^k + l is congruent to l + h c, and for
+   m = 2^k + c to l - h c.  Each such fold replaces the k bits of l and
+   above by the bits of h c, so when c is small compared to 2^k a couple of
+   folds bring a double length product below 2^k, for the cost of a
+   multiplication by c.  That's the pseudo-Mersenne moduli 2^255 - 19,
+   2^521 - 1 and the like, and the few Solinas primes whose c is small,
+   such as P-521.  For c of a limb or less the fold is an n by 1
+   multiplication, against n^2 for REDC.
+
+   A c of more than a quarter of k bits would need too many folds to be
+   worthwhile, and is left to REDC or division.  P-256 is like that, its c
+   is 224 bits.  */
+
+#define MAX_CBITS(k)  MAX (GMP_NUMB_BITS, (k) / 4)
+
+/* Decide whether {mp,n} is 2^k - c or 2^k + c with a small c, and if so
+   fill in *red, with c stored at cp, which needs room for n limbs.  Return
+   non-zero if so.  Only n >= 2 is considered.  */
+int
+mpn_mod_2expc_init (gmp_2expc_t *red, mp_ptr cp, mp_srcptr mp, mp_size_t n)
+{
+  mp_bitcnt_t mbits, cbits;
+  mp_size_t cn;
+  mp_limb_t bit;
+  int cnt;
+
+  ASSERT (n >= 1 && mp[n - 1] != 0);
+
+  if (n < 2)
+    return 0;
+
+  /* The c we accept never reaches limb n-2 when n >= 3, so that limb is
+     all zeros or all ones.  That rejects most moduli at once.  */
+  if (n >= 3 && mp[n - 2] != 0 && mp[n - 2] != GMP_NUMB_MAX)
+    return 0;
+
+  count_leading_zeros (cnt, mp[n - 1]);
+  cnt -= GMP_NAIL_BITS;
+  mbits = (mp_bitcnt_t) n * GMP_NUMB_BITS - cnt;
+
+  /* the bit below the leading 1 */
+  bit = mp[(mbits - 2) / GMP_NUMB_BITS] >> ((mbits - 2) % GMP_NUMB_BITS);
+
+  if ((bit & 1) != 0)
+    {
+      /* m = 2^k - c, with k the size of m, c = (~m mod 2^k) + 1 */
+      mpn_com (cp, mp, n);
+      if (cnt != 0)
+	cp[n - 1] &= GMP_NUMB_MASK >> cnt;
+      mpn_add_1 (cp, cp, n, CNST_LIMB (1));
+      red->k = mbits;
+      red->neg = 0;
+    }
+  else
+    {
+      /* m = 2^k + c, with k one less than the size of m */
+      MPN_COPY (cp, mp, n);
+      cp[n - 1] &= ~(GMP_NUMB_HIGHBIT >> cnt);
+      red->k = mbits - 1;
+      red->neg = 1;
+    }
+
+  cn = n;
+  MPN_NORMALIZE (cp, cn);
+  if (cn == 0)
+    return 0;				/* m = 2^k, not interesting */
+  MPN_SIZEINBASE_2EXP (cbits, cp, cn, 1);
+  if (cbits > MAX_CBITS (red->k))
+    return 0;
+
+  red->cp = cp;
+  red->cn = cn;
+  return 1;
+}
+
+/* The common case of a one limb c and a product to reduce, xn <= 2n, with
+   k in the top limb of m.  Then B^n = 2^s 2^k is congruent to +-cc, for
+   cc = 2^s c, and when that fits a limb the first fold works on whole
+   limbs, one addmul_1 or submul_1.  The fold at bit k is left to the end,
+   when it's only on the top limb.  */
+static void
+mod_2expc_1 (mp_ptr rp, mp_srcptr xp, mp_size_t xn,
+	     mp_srcptr mp, mp_size_t n, const gmp_2expc_t *red)
+{
+  mp_limb_t c, cc, cy, hi, lo, h;
+  mp_size_t hn;
+  unsigned kb;
+  int add;
+
+  c = red->cp[0];
+  kb = red->k % GMP_NUMB_BITS;
+  cc = kb == 0 ? c : c << (GMP_NUMB_BITS - kb);
+
+  if (xn <= n)
+    {
+      MPN_COPY (rp, xp, xn);
+      MPN_ZERO (rp + xn, n - xn);
+    }
+  else
+    {
+      hn = xn - n;
+      MPN_COPY (rp, xp, n);
+      if (red->neg == 0)
+	cy = mpn_addmul_1 (rp, xp + n, hn, cc);
+      else
+	cy = mpn_submul_1 (rp, xp + n, hn, cc);
+      if (hn < n)
+	{
+	  if (red->neg == 0)
+	    cy = mpn_add_1 (rp + hn, rp + hn, n - hn, cy);
+	  else
+	    cy = mpn_sub_1 (rp + hn, rp + hn, n - hn, cy);
+	}
+
+      /* A carry out is B^n, congruent to cc for 2^k - c, and a borrow is
+	 -B^n, congruent to cc for 2^k + c, where a carry out is -cc.  When
+	 subtracting that -cc borrows, the value is negative, but above -m,
+	 and adding m brings it back, with a carry out that's dropped.
+	 Carrying on with +cc instead could go round forever, from {rp,n} =
+	 B^n - cc for instance.  */
+      add = 1;
+      while (cy != 0)
+	{
+	  umul_ppmm (hi, lo, cy, cc);
+	  if (add)
+	    {
+	      cy = mpn_add_1 (rp, rp, n, lo);
+	      cy += mpn_add_1 (rp + 1, rp + 1, n - 1, hi);
+	    }
+	  else
+	    {
+	      cy = mpn_sub_1 (rp, rp, n, lo);
+	      cy += mpn_sub_1 (rp + 1, rp + 1, n - 1, hi);
+	      if (cy != 0)
+		{
+		  mpn_add_n (rp, rp, mp, n);
+		  break;
+		}
+	    }
+	  add ^= red->neg;
+	}
+    }
+
+  /* Now the fold at bit k, bringing {rp,n} below 2^k.  */
+  if (kb != 0)
+    {
+      if (red->neg == 0)
+	{
+	  while ((h = rp[n - 1] >> kb) != 0)
+	    {
+	      rp[n - 1] &= GMP_NUMB_MASK >> (GMP_NUMB_BITS - kb);
+	      mpn_add_1 (rp, rp, n, h * c);
+	    }
+	}
+      else
+	{
+	  h = rp[n - 1] >> kb;
+	  rp[n - 1] &= GMP_NUMB_MASK >> (GMP_NUMB_BITS - kb);
+	  if (mpn_sub_1 (rp, rp, n, h * c) != 0)
+	    mpn_add_n (rp, rp, mp, n);
+	}
+    }
+
+  if (red->neg == 0 && mpn_cmp (rp, mp, n) >= 0)
+    mpn_sub_n (rp, rp, mp, n);
+}
+
+/* Set {rp,n} to {xp,xn} mod {mp,n}, which is described by red.  Scratch
+   space at tp is mpn_mod_2expc_itch (xn, n) limbs.  */
+void
+mpn_mod_2expc (mp_ptr rp, mp_srcptr xp, mp_size_t xn,
+	       mp_srcptr mp, mp_size_t n, const gmp_2expc_t *red, mp_ptr tp)
+{
+  mp_srcptr cp, ap, hp;
+  mp_ptr sp, lp, p0, p1, pp;
+  mp_size_t cn, kl, kn, an, hn, pn, ln, size;
+  unsigned kb;
+  int negated;
+  mp_limb_t cy;
+
+  cp = red->cp;
+  cn = red->cn;
+  kl = red->k / GMP_NUMB_BITS;
+  kb = red->k % GMP_NUMB_BITS;
+  kn = kl + (kb != 0);
+
+  ASSERT (kn <= n);
+
+  /* A long x is reduced from the top, n limbs at a time, so that each step
+     folds at most 2n limbs, O(xn cn) in all.  Folding the whole of x would
+     shorten it by only about n - cn limbs a pass, quadratic in xn.  */
+  if (xn > 2 * n)
+    {
+      mp_ptr wp;
+      mp_size_t i, j;
+
+      wp = tp;
+      tp += 2 * n;
+      i = xn - 2 * n;
+      mpn_mod_2expc (rp, xp + i, 2 * n, mp, n, red, tp);
+      while (i > 0)
+	{
+	  j = MIN (i, n);
+	  i -= j;
+	  MPN_COPY (wp, xp + i, j);
+	  MPN_COPY (wp + j, rp, n);
+	  mpn_mod_2expc (rp, wp, j + n, mp, n, red, tp);
+	}
+      return;
+    }
+
+  if (MOD_2EXPC_1_P (red, n))
+    {
+      mod_2expc_1 (rp, xp, xn, mp, n, red);
+      return;
+    }
+
+  /* Big enough for h, and for h c plus l, in every fold.  */
+  size = MAX (xn, kn + 1) + cn + 2;
+  sp = tp;
+  lp = sp + size;
+  p0 = lp + kn;
+  p1 = p0 + size;
+
+  ap = xp;
+  an = xn;
+  MPN_NORMALIZE (ap, an);
+  negated = 0;
+
+  /* Fold while x >= 2^k.  */
+  while (an > kn || (an == kn && kb != 0 && (ap[kl] >> kb) != 0))
+    {
+      /* h = x >> k */
+      hn = an - kl;
+      if (kb != 0)
+	{
+	  mpn_rshift (sp, ap + kl, hn, kb);
+	  hn -= sp[hn - 1] == 0;
+	  hp = sp;
+	}
+      else
+	hp = ap + kl;
+
+      /* l = x mod 2^k */
+      MPN_COPY (lp, ap, kn);
+      if (kb != 0)
+	lp[kl] &= GMP_NUMB_MASK >> (GMP_NUMB_BITS - kb);
+      ln = kn;
+      MPN_NORMALIZE (lp, ln);
+
+      pp = ap == p0 ? p1 : p0;
+      if (hn >= cn)
+	mpn_mul (pp, hp, hn, cp, cn);
+      else
+	mpn_mul (pp, cp, cn, hp, hn);
+      pn = hn + cn;
+      pn -= pp[pn - 1] == 0;
+
+      if (red->neg == 0)
+	{
+	  /* l + h c */
+	  if (pn >= ln)
+	    {
+	      cy = mpn_add (pp, pp, pn, lp, ln);
+	      an = pn;
+	    }
+	  else
+	    {
+	      cy = mpn_add (pp, lp, ln, pp, pn);
+	      an = ln;
+	    }
+	  pp[an] = cy;
+	  an += cy != 0;
+	}
+      else
+	{
+	  /* l - h c, kept as its absolute value with the sign in negated */
+	  if (pn > ln || (pn == ln && mpn_cmp (pp, lp, pn) > 0))
+	    {
+	      mpn_sub (pp, pp, pn, lp, ln);
+	      an = pn;
+	      negated ^= 1;
+	    }
+	  else
+	    {
+	      mpn_sub (pp, lp, ln, pp, pn);
+	      an = ln;
+	    }
+	  MPN_NORMALIZE (pp, an);
+	}
+      ap = pp;
+    }
+
+  /* Now x < 2^k, which for 2^k - c is below 2m.  */
+  MPN_COPY (rp, ap, an);
+  MPN_ZERO (rp + an, n - an);
+  if (red->neg == 0 && an == n && mpn_cmp (rp, mp, n) >= 0)
+    mpn_sub_n (rp, rp, mp, n);
+
+  if (negated && ! mpn_zero_p (rp, n))
+    mpn_sub_n (rp, mp, rp, n);
+}
@@ -115,6 +115,55 @@ see https://www.gnu.org/licenses/.  */
 
 #define ITCH (16*vn + 100)
 
+/* Multiply very unbalanced operands by splitting up[] into un/vn pieces of
+   between vn and 2vn limbs, and doing the piece products with vp[] over the
+   threads.  The first product goes straight to prodp, the others to a
+   temporary area, from where they are added in, in order, once all are
+   done, the same way the serial loops below add their pieces.  */
+static void
+mpn_mul_par (mp_ptr prodp,
+	     mp_srcptr up, mp_size_t un,
+	     mp_srcptr vp, mp_size_t vn)
+{
+  struct toom_mul_item *it;
+  mp_size_t c, cl, rem, i, n, pos;
+  mp_ptr ws, wp;
+  mp_limb_t cy;
+  TMP_DECL;
+
+  c = un / vn;
+  cl = un / c;
+  rem = un % c;
+
+  TMP_MARK;
+  it = TMP_ALLOC_TYPE (c, struct toom_mul_item);
+  ws = TMP_ALLOC_LIMBS (un - cl + (c - 1) * vn);
+
+  n = cl + (rem > 0);
+  TOOM_MUL_ITEM (it[0], prodp, up, n, vp, vn);
+  for (i = 1, pos = n, wp = ws; i < c; i++)
+    {
+      n = cl + (i < rem);
+      TOOM_MUL_ITEM (it[i], wp, up + pos, n, vp, vn);
+      pos += n;
+      wp += n + vn;
+    }
+  ASSERT (pos == un);
+
+  mpn_toom_mul_par (it, (int) c);
+
+  for (i = 1; i < c; i++)
+    {
+      pos = it[i].a - up;
+      n = it[i].an;
+      wp = it[i].p;
+      cy = mpn_add_n (prodp + pos, prodp + pos, wp, vn);
+      MPN_COPY (prodp + pos + vn, wp + vn, n);
+      mpn_incr_u (prodp + pos + vn, cy);
+    }
+  TMP_FREE;
+}
+
 mp_limb_t
 mpn_mul (mp_ptr prodp,
 	 mp_srcptr up, mp_size_t un,
@@ -132,6 +181,9 @@ mpn_mul (mp_ptr prodp,
       else
 	mpn_mul_n (prodp, up, vp, un);
     }
+  else if (ABOVE_THRESHOLD (vn, PARALLEL_MUL_THRESHOLD) && un >= 2 * vn
+	   && __gmp_parallel_threads () > 1)
+    mpn_mul_par (prodp, up, un, vp, vn);
   else if (vn < MUL_TOOM22_THRESHOLD)
     { /* plain schoolbook multiplication */
 
@@ -433,8 +485,10 @@ mpn_mul (mp_ptr prodp,
 
 	  TMP_FREE;
 	}
-      else
+      else if (BELOW_THRESHOLD ((un + vn) >> 1, MUL_NTT_THRESHOLD))
 	mpn_fft_mul (prodp, up, un, vp, vn);
+      else
+	mpn_mul_ntt (prodp, up, un, vp, vn);
     }
 
   return prodp[un + vn - 1];	/* historic */
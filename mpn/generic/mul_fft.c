@@ -47,11 +47,26 @@ see https://www.gnu.org/licenses/.  */
    Tapes versus Pointers, a study in implementing fast algorithms, by Arnold
    Schoenhage, Bulletin of the EATCS, 30, p. 23-32, 1986.
 
+   The sqrt(2) trick, from the ISSAC'2007 paper by Gaudry, Kruppa and
+   Zimmermann below, lets N' be a multiple of K/2 rather than K, so that the
+   coefficient ring, and with it the cost, grows in finer steps.  With
+   N' = j*K/2 for odd j the 2K-th root of unity used for the weights is
+   sqrt(2)^j, and sqrt(2) = 2^(N'/4)*(2^(N'/2)-1) mod 2^N'+1.  Only weights
+   for odd i need it; the transforms themselves still use the K-th root
+   2^j.
+
+   A GMP-based implementation of Schonhage-Strassen's large integer
+   multiplication algorithm, by Pierrick Gaudry, Alexander Kruppa and Paul
+   Zimmermann, ISSAC 2007, p. 167-174.
+
    TODO:
 
-   Implement some of the tricks published at ISSAC'2007 by Gaudry, Kruppa, and
+   Implement the other tricks published at ISSAC'2007 by Gaudry, Kruppa, and
    Zimmermann.
 
+   Spread the decomposition and the final recomposition over threads too.
+   They're linear, but they're all that remains serial with many threads.
+
    It might be possible to avoid a small number of MPN_COPYs by using a
    rotating temporary or two.
 
@@ -76,7 +91,8 @@ see https://www.gnu.org/licenses/.  */
 
 static mp_limb_t mpn_mul_fft_internal (mp_ptr, mp_size_t, int, mp_ptr *,
 				       mp_ptr *, mp_ptr, mp_ptr, mp_size_t,
-				       mp_size_t, mp_size_t, int **, mp_ptr, int);
+				       mp_size_t, mp_size_t, int **, mp_ptr, int,
+				       int, int);
 static void mpn_mul_fft_decompose (mp_ptr, mp_ptr *, mp_size_t, mp_size_t, mp_srcptr,
 				   mp_size_t, mp_size_t, mp_size_t, mp_ptr);
 
@@ -196,6 +212,20 @@ mpn_fft_initl (int **l, int k)
     }
 }
 
+/* Allocate fft_l in the caller's TMP block and initialize it.  */
+#define FFT_ALLOC_L(fft_l, k)						\
+  do {									\
+    int __i, *__tmp;							\
+    (fft_l) = TMP_BALLOC_TYPE ((k) + 1, int *);				\
+    __tmp = TMP_BALLOC_TYPE ((size_t) 2 << (k), int);			\
+    for (__i = 0; __i <= (k); __i++)					\
+      {									\
+	(fft_l)[__i] = __tmp;						\
+	__tmp += (mp_size_t) 1 << __i;					\
+      }									\
+    mpn_fft_initl (fft_l, k);						\
+  } while (0)
+
 
 /* r <- a*2^d mod 2^(n*GMP_NUMB_BITS)+1 with a = {a, n+1}
    Assumes a is semi-normalized, i.e. a[n] <= 1.
@@ -352,6 +382,44 @@ mpn_fft_sub_modF (mp_ptr r, mp_srcptr a, mp_srcptr b, mp_size_t n)
 #endif
 }
 
+/* r <- a*sqrt(2)^d mod 2^(n*GMP_NUMB_BITS)+1, for 0 <= d < 4*n*GMP_NUMB_BITS.
+   Assumes a is semi-normalized.  r, a and tp must have n+1 limbs, and not
+   overlap; tp is only used for odd d.
+*/
+static void
+mpn_fft_mul_sqrt2exp_modF (mp_ptr r, mp_srcptr a, mp_bitcnt_t d, mp_size_t n,
+			   mp_ptr tp)
+{
+  mp_bitcnt_t N, e;
+
+  if (d % 2 == 0)
+    {
+      mpn_fft_mul_2exp_modF (r, a, d / 2, n);
+      return;
+    }
+
+  /* a*sqrt(2)^d = a*2^e*2^(3N/4) - a*2^e*2^(N/4), all exponents mod 2N */
+  N = (mp_bitcnt_t) n * GMP_NUMB_BITS;
+  e = d / 2;
+  mpn_fft_mul_2exp_modF (r, a, (e + 3 * N / 4) % (2 * N), n);
+  mpn_fft_mul_2exp_modF (tp, a, (e + N / 4) % (2 * N), n);
+  mpn_fft_sub_modF (r, r, tp, n);
+}
+
+/* With FFT_RADIX4, mpn_fft_fft and mpn_fft_fftinv do the two top layers of
+   butterflies of a transform (of K >= 8) in a single pass, on groups of
+   four coefficients.  A plain radix-2 pass reads and writes all K*(n+1)
+   limbs for each layer, so once that's more than the cache holds, this
+   halves the traffic to memory for the layers above the cache size; below
+   it, the recursion is depth first and stays in cache anyway.  Each
+   coefficient sees exactly the same operations either way.
+
+   tune/mul_fft_radix2.c compiles this file with FFT_RADIX4 set to 0, to
+   compare.  */
+#ifndef FFT_RADIX4
+#define FFT_RADIX4 1
+#endif
+
 /* input: A[0] ... A[inc*(K-1)] are residues mod 2^N+1 where
 	  N=n*GMP_NUMB_BITS, and 2^omega is a primitive root mod 2^N+1
    output: A[inc*l[k][i]] <- \sum (2^omega)^(ij) A[inc*j] mod 2^N+1 */
@@ -375,6 +443,37 @@ mpn_fft_fft (mp_ptr *Ap, mp_size_t K, int **ll,
       if (cy) /* Ap[inc][n] can be -1 or -2 */
 	Ap[inc][n] = mpn_add_1 (Ap[inc], Ap[inc], n, ~Ap[inc][n] + 1);
     }
+  else if (FFT_RADIX4 && K >= 8)
+    {
+      mp_size_t j, K4 = K >> 2;
+      int *lk = *ll, *lk1 = ll[-1];
+      mp_bitcnt_t d1;
+
+      mpn_fft_fft (Ap,           K4, ll-2, 4 * omega, n, inc * 4, tp);
+      mpn_fft_fft (Ap + 2 * inc, K4, ll-2, 4 * omega, n, inc * 4, tp);
+      mpn_fft_fft (Ap + inc,     K4, ll-2, 4 * omega, n, inc * 4, tp);
+      mpn_fft_fft (Ap + 3 * inc, K4, ll-2, 4 * omega, n, inc * 4, tp);
+      /* the layer for K/2 pairs A[4j*inc] with A[(4j+2)inc], and
+	 A[(4j+1)inc] with A[(4j+3)inc], then the layer for K pairs
+	 neighbours, as below */
+      for (j = 0; j < K4; j++, lk += 4, lk1 += 2, Ap += 4 * inc)
+	{
+	  d1 = lk1[0] * 2 * omega;
+	  mpn_fft_mul_2exp_modF (tp, Ap[2 * inc], d1, n);
+	  mpn_fft_sub_modF (Ap[2 * inc], Ap[0], tp, n);
+	  mpn_fft_add_modF (Ap[0],       Ap[0], tp, n);
+	  mpn_fft_mul_2exp_modF (tp, Ap[3 * inc], d1, n);
+	  mpn_fft_sub_modF (Ap[3 * inc], Ap[inc], tp, n);
+	  mpn_fft_add_modF (Ap[inc],     Ap[inc], tp, n);
+
+	  mpn_fft_mul_2exp_modF (tp, Ap[inc], lk[0] * omega, n);
+	  mpn_fft_sub_modF (Ap[inc],     Ap[0], tp, n);
+	  mpn_fft_add_modF (Ap[0],       Ap[0], tp, n);
+	  mpn_fft_mul_2exp_modF (tp, Ap[3 * inc], lk[2] * omega, n);
+	  mpn_fft_sub_modF (Ap[3 * inc], Ap[2 * inc], tp, n);
+	  mpn_fft_add_modF (Ap[2 * inc], Ap[2 * inc], tp, n);
+	}
+    }
   else
     {
       mp_size_t j, K2 = K >> 1;
@@ -402,6 +501,95 @@ mpn_fft_fft (mp_ptr *Ap, mp_size_t K, int **ll,
 */
 
 
+/* Multithreaded versions of mpn_fft_fft and mpn_fft_fftinv.  The two
+   half-size transforms are independent and are run as separate items of
+   __gmp_parallel_run, each recursively split further until "parts" is
+   used up.  The butterflies of the final layer are independent too, and
+   are split into "parts" ranges each with its own temporary.
+
+   Every coefficient sees the same operations as in the plain code, so the
+   results are identical whatever the number of threads.  */
+
+struct fft_par
+{
+  mp_ptr *Ap;
+  mp_size_t K;
+  int **ll;
+  mp_size_t omega;
+  mp_size_t n;
+  mp_size_t inc;
+  int parts;
+};
+
+static void mpn_fft_fft_par (mp_ptr *, mp_size_t, int **, mp_size_t,
+			     mp_size_t, mp_size_t, int);
+static void mpn_fft_fftinv_par (mp_ptr *, mp_size_t, mp_size_t,
+				mp_size_t, int);
+
+static void
+mpn_fft_fft_half (void *arg, mp_size_t r)
+{
+  struct fft_par *p = (struct fft_par *) arg;
+  mpn_fft_fft_par (p->Ap + r * p->inc, p->K >> 1, p->ll - 1, 2 * p->omega,
+		   p->n, p->inc * 2, (p->parts + 1) >> 1);
+}
+
+static void
+mpn_fft_fft_layer (void *arg, mp_size_t r)
+{
+  struct fft_par *p = (struct fft_par *) arg;
+  mp_size_t j, j1, K2 = p->K >> 1, inc = p->inc;
+  mp_ptr *Ap, tp;
+  int *lk;
+  TMP_DECL;
+
+  j = K2 * r / p->parts;
+  j1 = K2 * (r + 1) / p->parts;
+  Ap = p->Ap + 2 * j * inc;
+  lk = *p->ll + 2 * j;
+
+  TMP_MARK;
+  tp = TMP_ALLOC_LIMBS (p->n + 1);
+  for (; j < j1; j++, lk += 2, Ap += 2 * inc)
+    {
+      mpn_fft_mul_2exp_modF (tp, Ap[inc], lk[0] * p->omega, p->n);
+      mpn_fft_sub_modF (Ap[inc], Ap[0], tp, p->n);
+      mpn_fft_add_modF (Ap[0],   Ap[0], tp, p->n);
+    }
+  TMP_FREE;
+}
+
+static void
+mpn_fft_fft_par (mp_ptr *Ap, mp_size_t K, int **ll,
+		 mp_size_t omega, mp_size_t n, mp_size_t inc, int parts)
+{
+  struct fft_par p;
+
+  if (parts <= 1 || K == 2)
+    {
+      mp_ptr tp;
+      TMP_DECL;
+      TMP_MARK;
+      tp = TMP_ALLOC_LIMBS (n + 1);
+      mpn_fft_fft (Ap, K, ll, omega, n, inc, tp);
+      TMP_FREE;
+      return;
+    }
+
+  p.Ap = Ap;
+  p.K = K;
+  p.ll = ll;
+  p.omega = omega;
+  p.n = n;
+  p.inc = inc;
+  p.parts = MIN (parts, K >> 1);
+
+  __gmp_parallel_run (mpn_fft_fft_half, &p, 2);
+  __gmp_parallel_run (mpn_fft_fft_layer, &p, p.parts);
+}
+
+
+
 /* Given ap[0..n] with ap[n]<=1, reduce it modulo 2^(n*GMP_NUMB_BITS)+1,
    by subtracting that modulus if necessary.
 
@@ -439,15 +627,15 @@ mpn_fft_mul_modF_K (mp_ptr *ap, mp_ptr *bp, mp_size_t n, mp_size_t K)
 
   if (n >= (sqr ? SQR_FFT_MODF_THRESHOLD : MUL_FFT_MODF_THRESHOLD))
     {
-      mp_size_t K2, nprime2, Nprime2, M2, maxLK, l, Mp2;
+      mp_size_t K2, nprime2, Nprime2, M2, maxLK, l, omega2;
       int k;
-      int **fft_l, *tmp;
+      int **fft_l;
       mp_ptr *Ap, *Bp, A, B, T;
 
       k = mpn_fft_best_k (n, sqr);
       K2 = (mp_size_t) 1 << k;
       ASSERT_ALWAYS((n & (K2 - 1)) == 0);
-      maxLK = (K2 > GMP_NUMB_BITS) ? K2 : GMP_NUMB_BITS;
+      maxLK = (K2 / 2 > GMP_NUMB_BITS) ? K2 / 2 : GMP_NUMB_BITS;
       M2 = n * GMP_NUMB_BITS >> k;
       l = n >> k;
       Nprime2 = ((2 * M2 + k + 2 + maxLK) / maxLK) * maxLK;
@@ -470,22 +658,14 @@ mpn_fft_mul_modF_K (mp_ptr *ap, mp_ptr *bp, mp_size_t n, mp_size_t K)
 	}
       ASSERT_ALWAYS(nprime2 < n); /* otherwise we'll loop */
 
-      Mp2 = Nprime2 >> k;
+      omega2 = Nprime2 >> (k - 1);
 
       Ap = TMP_BALLOC_MP_PTRS (K2);
       Bp = TMP_BALLOC_MP_PTRS (K2);
       A = TMP_BALLOC_LIMBS (2 * (nprime2 + 1) << k);
       T = TMP_BALLOC_LIMBS (2 * (nprime2 + 1));
       B = A + ((nprime2 + 1) << k);
-      fft_l = TMP_BALLOC_TYPE (k + 1, int *);
-      tmp = TMP_BALLOC_TYPE ((size_t) 2 << k, int);
-      for (i = 0; i <= k; i++)
-	{
-	  fft_l[i] = tmp;
-	  tmp += (mp_size_t) 1 << i;
-	}
-
-      mpn_fft_initl (fft_l, k);
+      FFT_ALLOC_L (fft_l, k);
 
       TRACE (printf ("recurse: %ldx%ld limbs -> %ld times %ldx%ld (%1.2f)\n", n,
 		    n, K2, nprime2, nprime2, 2.0*(double)n/nprime2/K2));
@@ -496,12 +676,12 @@ mpn_fft_mul_modF_K (mp_ptr *ap, mp_ptr *bp, mp_size_t n, mp_size_t K)
 	  if (!sqr)
 	    mpn_fft_normalize (*bp, n);
 
-	  mpn_mul_fft_decompose (A, Ap, K2, nprime2, *ap, (l << k) + 1, l, Mp2, T);
+	  mpn_mul_fft_decompose (A, Ap, K2, nprime2, *ap, (l << k) + 1, l, omega2, T);
 	  if (!sqr)
-	    mpn_mul_fft_decompose (B, Bp, K2, nprime2, *bp, (l << k) + 1, l, Mp2, T);
+	    mpn_mul_fft_decompose (B, Bp, K2, nprime2, *bp, (l << k) + 1, l, omega2, T);
 
 	  cy = mpn_mul_fft_internal (*ap, n, k, Ap, Bp, A, B, nprime2,
-				     l, Mp2, fft_l, T, sqr);
+				     l, omega2, fft_l, T, sqr, 0, 1);
 	  (*ap)[n] = cy;
 	}
     }
@@ -540,6 +720,42 @@ mpn_fft_mul_modF_K (mp_ptr *ap, mp_ptr *bp, mp_size_t n, mp_size_t K)
 }
 
 
+struct fft_mul_modF_par
+{
+  mp_ptr *ap;
+  mp_ptr *bp;
+  mp_size_t n;
+  mp_size_t K;
+  int parts;
+};
+
+static void
+mpn_fft_mul_modF_K_part (void *arg, mp_size_t r)
+{
+  struct fft_mul_modF_par *p = (struct fft_mul_modF_par *) arg;
+  mp_size_t i0, i1;
+
+  i0 = p->K * r / p->parts;
+  i1 = p->K * (r + 1) / p->parts;
+  mpn_fft_mul_modF_K (p->ap + i0, p->bp + i0, p->n, i1 - i0);
+}
+
+/* mpn_fft_mul_modF_K with the K products split into "parts" ranges.  */
+static void
+mpn_fft_mul_modF_K_par (mp_ptr *ap, mp_ptr *bp, mp_size_t n, mp_size_t K,
+			int parts)
+{
+  struct fft_mul_modF_par p;
+
+  p.ap = ap;
+  p.bp = bp;
+  p.n = n;
+  p.K = K;
+  p.parts = MIN (parts, K);
+  __gmp_parallel_run (mpn_fft_mul_modF_K_part, &p, p.parts);
+}
+
+
 /* input: A^[l[k][0]] A^[l[k][1]] ... A^[l[k][K-1]]
    output: K*A[0] K*A[K-1] ... K*A[1].
    Assumes the Ap[] are pseudo-normalized, i.e. 0 <= Ap[][n] <= 1.
@@ -563,6 +779,34 @@ mpn_fft_fftinv (mp_ptr *Ap, mp_size_t K, mp_size_t omega, mp_size_t n, mp_ptr tp
       if (cy) /* Ap[1][n] can be -1 or -2 */
 	Ap[1][n] = mpn_add_1 (Ap[1], Ap[1], n, ~Ap[1][n] + 1);
     }
+  else if (FFT_RADIX4 && K >= 8)
+    {
+      mp_size_t j, K4 = K >> 2;
+
+      mpn_fft_fftinv (Ap,          K4, 4 * omega, n, tp);
+      mpn_fft_fftinv (Ap + K4,     K4, 4 * omega, n, tp);
+      mpn_fft_fftinv (Ap + 2 * K4, K4, 4 * omega, n, tp);
+      mpn_fft_fftinv (Ap + 3 * K4, K4, 4 * omega, n, tp);
+      /* the layer for K/2 pairs A[j] with A[j+K/4], and A[j+K/2] with
+	 A[j+3K/4], then the layer for K pairs A[j] and A[j+K/4] with the
+	 elements K/2 further on, as below */
+      for (j = 0; j < K4; j++, Ap++)
+	{
+	  mpn_fft_mul_2exp_modF (tp, Ap[K4], j * 2 * omega, n);
+	  mpn_fft_sub_modF (Ap[K4],     Ap[0], tp, n);
+	  mpn_fft_add_modF (Ap[0],      Ap[0], tp, n);
+	  mpn_fft_mul_2exp_modF (tp, Ap[3 * K4], j * 2 * omega, n);
+	  mpn_fft_sub_modF (Ap[3 * K4], Ap[2 * K4], tp, n);
+	  mpn_fft_add_modF (Ap[2 * K4], Ap[2 * K4], tp, n);
+
+	  mpn_fft_mul_2exp_modF (tp, Ap[2 * K4], j * omega, n);
+	  mpn_fft_sub_modF (Ap[2 * K4], Ap[0], tp, n);
+	  mpn_fft_add_modF (Ap[0],      Ap[0], tp, n);
+	  mpn_fft_mul_2exp_modF (tp, Ap[3 * K4], (j + K4) * omega, n);
+	  mpn_fft_sub_modF (Ap[3 * K4], Ap[K4], tp, n);
+	  mpn_fft_add_modF (Ap[K4],     Ap[K4], tp, n);
+	}
+    }
   else
     {
       mp_size_t j, K2 = K >> 1;
@@ -583,6 +827,66 @@ mpn_fft_fftinv (mp_ptr *Ap, mp_size_t K, mp_size_t omega, mp_size_t n, mp_ptr tp
 }
 
 
+static void
+mpn_fft_fftinv_half (void *arg, mp_size_t r)
+{
+  struct fft_par *p = (struct fft_par *) arg;
+  mp_size_t K2 = p->K >> 1;
+  mpn_fft_fftinv_par (p->Ap + r * K2, K2, 2 * p->omega, p->n,
+		      (p->parts + 1) >> 1);
+}
+
+static void
+mpn_fft_fftinv_layer (void *arg, mp_size_t r)
+{
+  struct fft_par *p = (struct fft_par *) arg;
+  mp_size_t j, j1, K2 = p->K >> 1;
+  mp_ptr *Ap, tp;
+  TMP_DECL;
+
+  j = K2 * r / p->parts;
+  j1 = K2 * (r + 1) / p->parts;
+  Ap = p->Ap + j;
+
+  TMP_MARK;
+  tp = TMP_ALLOC_LIMBS (p->n + 1);
+  for (; j < j1; j++, Ap++)
+    {
+      mpn_fft_mul_2exp_modF (tp, Ap[K2], j * p->omega, p->n);
+      mpn_fft_sub_modF (Ap[K2], Ap[0], tp, p->n);
+      mpn_fft_add_modF (Ap[0],  Ap[0], tp, p->n);
+    }
+  TMP_FREE;
+}
+
+static void
+mpn_fft_fftinv_par (mp_ptr *Ap, mp_size_t K, mp_size_t omega, mp_size_t n,
+		    int parts)
+{
+  struct fft_par p;
+
+  if (parts <= 1 || K == 2)
+    {
+      mp_ptr tp;
+      TMP_DECL;
+      TMP_MARK;
+      tp = TMP_ALLOC_LIMBS (n + 1);
+      mpn_fft_fftinv (Ap, K, omega, n, tp);
+      TMP_FREE;
+      return;
+    }
+
+  p.Ap = Ap;
+  p.K = K;
+  p.omega = omega;
+  p.n = n;
+  p.parts = MIN (parts, K >> 1);
+
+  __gmp_parallel_run (mpn_fft_fftinv_half, &p, 2);
+  __gmp_parallel_run (mpn_fft_fftinv_layer, &p, p.parts);
+}
+
+
 /* R <- A/2^k mod 2^(n*GMP_NUMB_BITS)+1 */
 static void
 mpn_fft_div_2exp_modF (mp_ptr r, mp_srcptr a, mp_bitcnt_t k, mp_size_t n)
@@ -635,13 +939,15 @@ mpn_fft_norm_modF (mp_ptr rp, mp_size_t n, mp_ptr ap, mp_size_t an)
 
 /* store in A[0..nprime] the first M bits from {n, nl},
    in A[nprime+1..] the following M bits, ...
+   each times its weight sqrt(2)^(i*omega), 2^omega being the K-th root of
+   unity.
    Assumes M is a multiple of GMP_NUMB_BITS (M = l * GMP_NUMB_BITS).
-   T must have space for at least (nprime + 1) limbs.
+   T must have space for at least 2 * (nprime + 1) limbs.
    We must have nl <= 2*K*l.
 */
 static void
 mpn_mul_fft_decompose (mp_ptr A, mp_ptr *Ap, mp_size_t K, mp_size_t nprime,
-		       mp_srcptr n, mp_size_t nl, mp_size_t l, mp_size_t Mp,
+		       mp_srcptr n, mp_size_t nl, mp_size_t l, mp_size_t omega,
 		       mp_ptr T)
 {
   mp_size_t i, j;
@@ -706,7 +1012,7 @@ mpn_mul_fft_decompose (mp_ptr A, mp_ptr *Ap, mp_size_t K, mp_size_t nprime,
 	  MPN_COPY (T, n, j);
 	  MPN_ZERO (T + j, nprime + 1 - j);
 	  n += l;
-	  mpn_fft_mul_2exp_modF (A, T, i * Mp, nprime);
+	  mpn_fft_mul_sqrt2exp_modF (A, T, i * omega, nprime, T + nprime + 1);
 	}
       else
 	MPN_ZERO (A, nprime + 1);
@@ -720,44 +1026,71 @@ mpn_mul_fft_decompose (mp_ptr A, mp_ptr *Ap, mp_size_t K, mp_size_t nprime,
    op is pl limbs, its high bit is returned.
    One must have pl = mpn_fft_next_size (pl, k).
    T must have space for 2 * (nprime + 1) limbs.
+   With parts > 1 the transforms and the pointwise products are split into
+   that many pieces for __gmp_parallel_run.
+   With btrans != 0 Bp already holds the forward transform of the second
+   operand, as left by mpn_mul_fft_precomp_init, and is only read; B must
+   then be a separate scratch area of l*(K-1)+nprime+1 limbs.
 */
 
 static mp_limb_t
 mpn_mul_fft_internal (mp_ptr op, mp_size_t pl, int k,
 		      mp_ptr *Ap, mp_ptr *Bp, mp_ptr A, mp_ptr B,
-		      mp_size_t nprime, mp_size_t l, mp_size_t Mp,
-		      int **fft_l, mp_ptr T, int sqr)
+		      mp_size_t nprime, mp_size_t l, mp_size_t omega,
+		      int **fft_l, mp_ptr T, int sqr, int btrans, int parts)
 {
   mp_size_t K, i, pla, lo, sh, j;
+  mp_bitcnt_t d;
   mp_ptr p;
   mp_limb_t cc;
 
   K = (mp_size_t) 1 << k;
 
-  /* direct fft's */
-  mpn_fft_fft (Ap, K, fft_l + k, 2 * Mp, nprime, 1, T);
-  if (!sqr)
-    mpn_fft_fft (Bp, K, fft_l + k, 2 * Mp, nprime, 1, T);
+  if (parts > 1)
+    {
+      mpn_fft_fft_par (Ap, K, fft_l + k, omega, nprime, 1, parts);
+      if (!sqr && !btrans)
+	mpn_fft_fft_par (Bp, K, fft_l + k, omega, nprime, 1, parts);
+      mpn_fft_mul_modF_K_par (Ap, sqr ? Ap : Bp, nprime, K, parts);
+      mpn_fft_fftinv_par (Ap, K, omega, nprime, parts);
+    }
+  else
+    {
+      /* direct fft's */
+      mpn_fft_fft (Ap, K, fft_l + k, omega, nprime, 1, T);
+      if (!sqr && !btrans)
+	mpn_fft_fft (Bp, K, fft_l + k, omega, nprime, 1, T);
 
-  /* term to term multiplications */
-  mpn_fft_mul_modF_K (Ap, sqr ? Ap : Bp, nprime, K);
+      /* term to term multiplications */
+      mpn_fft_mul_modF_K (Ap, sqr ? Ap : Bp, nprime, K);
 
-  /* inverse fft's */
-  mpn_fft_fftinv (Ap, K, 2 * Mp, nprime, T);
+      /* inverse fft's */
+      mpn_fft_fftinv (Ap, K, omega, nprime, T);
+    }
 
-  /* division of terms after inverse fft */
+  /* division of terms after inverse fft; the Bp array itself is free now,
+     though with btrans the coefficients it pointed to are not */
   Bp[0] = T + nprime + 1;
   mpn_fft_div_2exp_modF (Bp[0], Ap[0], k, nprime);
   for (i = 1; i < K; i++)
     {
       Bp[i] = Ap[i - 1];
-      mpn_fft_div_2exp_modF (Bp[i], Ap[i], k + (K - i) * Mp, nprime);
+      d = (K - i) * omega;
+      if (d % 2 == 0)
+	mpn_fft_div_2exp_modF (Bp[i], Ap[i], k + d / 2, nprime);
+      else
+	{
+	  /* 1/sqrt(2)^d = sqrt(2)/2^((d+1)/2); Ap[i] is free once read */
+	  mpn_fft_div_2exp_modF (T, Ap[i], k + (d + 1) / 2, nprime);
+	  mpn_fft_mul_sqrt2exp_modF (Bp[i], T, 1, nprime, Ap[i]);
+	  mpn_fft_normalize (Bp[i], nprime);
+	}
     }
 
   /* addition of terms in result p */
   MPN_ZERO (T, nprime + 1);
   pla = l * (K - 1) + nprime + 1; /* number of required limbs for p */
-  p = B; /* B has K*(n' + 1) limbs, which is >= pla, i.e. enough */
+  p = B; /* B has at least pla limbs */
   MPN_ZERO (p, pla);
   cc = 0; /* will accumulate the (signed) carry at p[pla] */
   for (i = K - 1, lo = l * i + nprime,sh = l * i; i >= 0; i--,lo -= l,sh -= l)
@@ -822,45 +1155,26 @@ mpn_mul_fft_lcm (mp_bitcnt_t a, int k)
 }
 
 
-mp_limb_t
-mpn_mul_fft (mp_ptr op, mp_size_t pl,
-	     mp_srcptr n, mp_size_t nl,
-	     mp_srcptr m, mp_size_t ml,
-	     int k)
+/* Return n' for a product mod 2^(pl*GMP_NUMB_BITS)+1 with fft of size 2^k,
+   and store in *omega the exponent of the K-th root of unity 2^(N'/K), in
+   units of sqrt(2), i.e. 2N'/K.  */
+static mp_size_t
+mpn_mul_fft_nprime (mp_size_t pl, int k, int sqr, mp_size_t *omega)
 {
-  int i;
   mp_size_t K, maxLK;
-  mp_size_t N, Nprime, nprime, M, Mp, l;
-  mp_ptr *Ap, *Bp, A, T, B;
-  int **fft_l, *tmp;
-  int sqr = (n == m && nl == ml);
-  mp_limb_t h;
-  TMP_DECL;
+  mp_size_t N, Nprime, nprime, M;
 
-  TRACE (printf ("\nmpn_mul_fft pl=%ld nl=%ld ml=%ld k=%d\n", pl, nl, ml, k));
-  ASSERT_ALWAYS (mpn_fft_next_size (pl, k) == pl);
-
-  TMP_MARK;
   N = pl * GMP_NUMB_BITS;
-  fft_l = TMP_BALLOC_TYPE (k + 1, int *);
-  tmp = TMP_BALLOC_TYPE ((size_t) 2 << k, int);
-  for (i = 0; i <= k; i++)
-    {
-      fft_l[i] = tmp;
-      tmp += (mp_size_t) 1 << i;
-    }
-
-  mpn_fft_initl (fft_l, k);
   K = (mp_size_t) 1 << k;
   M = N >> k;	/* N = 2^k M */
-  l = 1 + (M - 1) / GMP_NUMB_BITS;
-  maxLK = mpn_mul_fft_lcm (GMP_NUMB_BITS, k); /* lcm (GMP_NUMB_BITS, 2^k) */
+  /* lcm (GMP_NUMB_BITS, 2^(k-1)), N' need only be a multiple of K/2 */
+  maxLK = mpn_mul_fft_lcm (GMP_NUMB_BITS, k - 1);
 
   Nprime = (1 + (2 * M + k + 2) / maxLK) * maxLK;
   /* Nprime = ceil((2*M+k+3)/maxLK)*maxLK; */
   nprime = Nprime / GMP_NUMB_BITS;
-  TRACE (printf ("N=%ld K=%ld, M=%ld, l=%ld, maxLK=%ld, Np=%ld, np=%ld\n",
-		 N, K, M, l, maxLK, Nprime, nprime));
+  TRACE (printf ("N=%ld K=%ld, M=%ld, maxLK=%ld, Np=%ld, np=%ld\n",
+		 N, K, M, maxLK, Nprime, nprime));
   /* we should ensure that recursively, nprime is a multiple of the next K */
   if (nprime >= (sqr ? SQR_FFT_MODF_THRESHOLD : MUL_FFT_MODF_THRESHOLD))
     {
@@ -878,16 +1192,41 @@ mpn_mul_fft (mp_ptr op, mp_size_t pl,
     }
   ASSERT_ALWAYS (nprime < pl); /* otherwise we'll loop */
 
-  T = TMP_BALLOC_LIMBS (2 * (nprime + 1));
-  Mp = Nprime >> k;
-
   TRACE (printf ("%ldx%ld limbs -> %ld times %ldx%ld limbs (%1.2f)\n",
 		pl, pl, K, nprime, nprime, 2.0 * (double) N / Nprime / K);
 	 printf ("   temp space %ld\n", 2 * K * (nprime + 1)));
 
+  *omega = Nprime >> (k - 1);
+  return nprime;
+}
+
+mp_limb_t
+mpn_mul_fft (mp_ptr op, mp_size_t pl,
+	     mp_srcptr n, mp_size_t nl,
+	     mp_srcptr m, mp_size_t ml,
+	     int k)
+{
+  mp_size_t K, nprime, omega, l;
+  mp_ptr *Ap, *Bp, A, T, B;
+  int **fft_l;
+  int sqr = (n == m && nl == ml);
+  int parts;
+  mp_limb_t h;
+  TMP_DECL;
+
+  TRACE (printf ("\nmpn_mul_fft pl=%ld nl=%ld ml=%ld k=%d\n", pl, nl, ml, k));
+  ASSERT_ALWAYS (mpn_fft_next_size (pl, k) == pl);
+
+  TMP_MARK;
+  FFT_ALLOC_L (fft_l, k);
+  K = (mp_size_t) 1 << k;
+  l = pl >> k;
+  nprime = mpn_mul_fft_nprime (pl, k, sqr, &omega);
+
+  T = TMP_BALLOC_LIMBS (2 * (nprime + 1));
   A = TMP_BALLOC_LIMBS (K * (nprime + 1));
   Ap = TMP_BALLOC_MP_PTRS (K);
-  mpn_mul_fft_decompose (A, Ap, K, nprime, n, nl, l, Mp, T);
+  mpn_mul_fft_decompose (A, Ap, K, nprime, n, nl, l, omega, T);
   if (sqr)
     {
       mp_size_t pla;
@@ -899,14 +1238,109 @@ mpn_mul_fft (mp_ptr op, mp_size_t pl,
     {
       B = TMP_BALLOC_LIMBS (K * (nprime + 1));
       Bp = TMP_BALLOC_MP_PTRS (K);
-      mpn_mul_fft_decompose (B, Bp, K, nprime, m, ml, l, Mp, T);
+      mpn_mul_fft_decompose (B, Bp, K, nprime, m, ml, l, omega, T);
     }
-  h = mpn_mul_fft_internal (op, pl, k, Ap, Bp, A, B, nprime, l, Mp, fft_l, T, sqr);
+
+  parts = pl >= MUL_FFT_PARALLEL_THRESHOLD ? __gmp_parallel_threads () : 1;
+  h = mpn_mul_fft_internal (op, pl, k, Ap, Bp, A, B, nprime, l, omega, fft_l, T,
+			    sqr, 0, parts);
 
   TMP_FREE;
   return h;
 }
 
+/* Split and transform {bp,bn} once, so that mpn_mul_fft_precomp can then
+   multiply by it mod 2^(pl*GMP_NUMB_BITS)+1 with only two transforms
+   instead of three.  Like for mpn_mul_fft, pl = mpn_fft_next_size (pl, k).
+   The coefficients are left normalized, so that mpn_fft_mul_modF_K finds
+   nothing to change in them.  */
+void
+mpn_mul_fft_precomp_init (struct mul_fft_precomp *P, mp_size_t pl,
+			  mp_srcptr bp, mp_size_t bn, int k)
+{
+  mp_size_t K, nprime, omega, i;
+  mp_ptr T;
+  int **fft_l;
+  TMP_DECL;
+
+  ASSERT_ALWAYS (mpn_fft_next_size (pl, k) == pl);
+
+  TMP_MARK;
+  FFT_ALLOC_L (fft_l, k);
+  K = (mp_size_t) 1 << k;
+  nprime = mpn_mul_fft_nprime (pl, k, 0, &omega);
+
+  P->pl = pl;
+  P->k = k;
+  P->nprime = nprime;
+  P->omega = omega;
+  P->B = __GMP_ALLOCATE_FUNC_LIMBS (K * (nprime + 1));
+  P->Bp = __GMP_ALLOCATE_FUNC_TYPE (K, mp_ptr);
+
+  T = TMP_BALLOC_LIMBS (2 * (nprime + 1));
+  mpn_mul_fft_decompose (P->B, P->Bp, K, nprime, bp, bn, pl >> k, omega, T);
+  if (pl >= MUL_FFT_PARALLEL_THRESHOLD && __gmp_parallel_threads () > 1)
+    mpn_fft_fft_par (P->Bp, K, fft_l + k, omega, nprime, 1,
+		     __gmp_parallel_threads ());
+  else
+    mpn_fft_fft (P->Bp, K, fft_l + k, omega, nprime, 1, T);
+  for (i = 0; i < K; i++)
+    mpn_fft_normalize (P->Bp[i], nprime);
+
+  TMP_FREE;
+}
+
+/* {op,pl} <- {ap,an} * b mod 2^(pl*GMP_NUMB_BITS)+1, with b and pl as given
+   to mpn_mul_fft_precomp_init.  The high limb is returned, as for
+   mpn_mul_fft.  */
+mp_limb_t
+mpn_mul_fft_precomp (mp_ptr op, mp_srcptr ap, mp_size_t an,
+		     const struct mul_fft_precomp *P)
+{
+  mp_size_t K, pl, nprime, omega, l, i;
+  mp_ptr *Ap, *Bp, A, T, B;
+  int **fft_l;
+  int k, parts;
+  mp_limb_t h;
+  TMP_DECL;
+
+  pl = P->pl;
+  k = P->k;
+  nprime = P->nprime;
+  omega = P->omega;
+  K = (mp_size_t) 1 << k;
+  l = pl >> k;
+
+  TMP_MARK;
+  FFT_ALLOC_L (fft_l, k);
+  T = TMP_BALLOC_LIMBS (2 * (nprime + 1));
+  A = TMP_BALLOC_LIMBS (K * (nprime + 1));
+  Ap = TMP_BALLOC_MP_PTRS (K);
+  mpn_mul_fft_decompose (A, Ap, K, nprime, ap, an, l, omega, T);
+
+  /* mpn_mul_fft_internal reuses the pointer array for the recomposition */
+  Bp = TMP_BALLOC_MP_PTRS (K);
+  for (i = 0; i < K; i++)
+    Bp[i] = P->Bp[i];
+  B = TMP_BALLOC_LIMBS (l * (K - 1) + nprime + 1);
+
+  parts = pl >= MUL_FFT_PARALLEL_THRESHOLD ? __gmp_parallel_threads () : 1;
+  h = mpn_mul_fft_internal (op, pl, k, Ap, Bp, A, B, nprime, l, omega, fft_l, T,
+			    0, 1, parts);
+
+  TMP_FREE;
+  return h;
+}
+
+void
+mpn_mul_fft_precomp_clear (struct mul_fft_precomp *P)
+{
+  mp_size_t K = (mp_size_t) 1 << P->k;
+
+  __GMP_FREE_FUNC_LIMBS (P->B, K * (P->nprime + 1));
+  __GMP_FREE_FUNC_TYPE (P->Bp, K, mp_ptr);
+}
+
 #if WANT_OLD_FFT_FULL
 /* multiply {n, nl} by {m, ml}, and put the result in {op, nl+ml} */
 void
@@ -88,10 +88,14 @@ mpn_mul_n (mp_ptr p, mp_srcptr a, mp_srcptr b, mp_size_t n)
       mpn_toom8h_mul (p, a, n, b, n, ws);
       TMP_FREE;
     }
-  else
+  else if (BELOW_THRESHOLD (n, MUL_NTT_THRESHOLD))
     {
       /* The current FFT code allocates its own space.  That should probably
 	 change.  */
       mpn_fft_mul (p, a, n, b, n);
     }
+  else
+    {
+      mpn_mul_ntt (p, a, n, b, n);
+    }
 }
@@ -0,0 +1,420 @@
+/* mpn_mul_ntt -- multiply using number theoretic transforms modulo three
+   word-size primes.
+
+   Contributed to the GNU project by the GMP developers.
+
+   THE FUNCTIONS IN THIS FILE ARE INTERNAL WITH MUTABLE INTERFACES.  IT IS
+   ONLY SAFE TO REACH THEM THROUGH DOCUMENTED INTERFACES.  IN FACT, IT IS
+   ALMOST GUARANTEED THAT THEY WILL CHANGE OR DISAPPEAR IN A FUTURE GNU MP
+   RELEASE.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+
+/* Each limb of the inputs is taken as one coefficient of a polynomial, and
+   the polynomial product is formed modulo three primes p0 > p1 > p2, each a
+   little under 2^62 and with p-1 divisible by 2^42, so transforms of up to
+   2^42 points can be done (p0-1 has 2^46, but p1-1 and p2-1 only 2^42).  A
+   coefficient of the product is less than min(an,bn) * 2^128, which is
+   below p0*p1*p2 ~ 2^186 for any size we could ever be asked for, so it's
+   recovered exactly by Garner's CRT, and the coefficients are then added up
+   with carries.
+
+   Arithmetic mod p is Montgomery with R = 2^64.  Loading a limb x as
+   REDC(x) = x/R saves a conversion, the pointwise product then carries a
+   factor 1/R^3, and the inverse transform a factor N, all of which is
+   undone by one multiply by R^4/N on the way out.
+
+   The forward transform is decimation in frequency and leaves its output in
+   bit-reversed order, the inverse is decimation in time and takes its input
+   that way, so no reordering is ever needed.  Both recurse depth first
+   until the block fits in L1 and then run breadth first.  The roots for
+   each level are stored separately so they're read sequentially, and the
+   inverse uses w^-k = -w^(N/2-k) to share them.
+
+   The three primes are independent and are done as separate items through
+   __gmp_parallel_run, each with its own scratch.
+
+   This code is only for 64-bit limbs.  Elsewhere mpn_mul_ntt just passes
+   the operands to mpn_fft_mul, and gmp-impl.h keeps the NTT thresholds at
+   MP_SIZE_T_MAX so that's never reached.  */
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "longlong.h"
+
+#if GMP_NUMB_BITS == 64 && GMP_LIMB_BITS == 64
+
+/* Largest transform done breadth first, in limbs.  */
+#ifndef NTT_BLOCK
+#define NTT_BLOCK  1024
+#endif
+
+/* The largest k with 2^k dividing p-1 for all three primes.  */
+#define NTT_LOG2_MAX  42
+
+/* The primes, largest first, and a primitive root of each.  */
+static const mp_limb_t ntt_primes[3][2] = {
+  { CNST_LIMB(0x3fffc00000000001), 11 },
+  { CNST_LIMB(0x3fff840000000001), 19 },
+  { CNST_LIMB(0x3fff540000000001), 5 },
+};
+
+struct ntt_prime
+{
+  mp_limb_t p;
+  mp_limb_t pinv;		/* p^-1 mod 2^64 */
+  mp_limb_t one;		/* R mod p */
+  mp_limb_t r2;			/* R^2 mod p */
+};
+
+/* Return (hi*2^64+lo)/R mod p, requires hi < p.  */
+static inline mp_limb_t
+ntt_redc (mp_limb_t hi, mp_limb_t lo, const struct ntt_prime *P)
+{
+  mp_limb_t m, mh, ml;
+  m = lo * P->pinv;
+  umul_ppmm (mh, ml, m, P->p);
+  ASSERT (ml == lo);
+  return hi - mh + (hi < mh ? P->p : 0);
+}
+
+/* Return a*b/R mod p, requires a*b < p*2^64.  */
+static inline mp_limb_t
+ntt_mulredc (mp_limb_t a, mp_limb_t b, const struct ntt_prime *P)
+{
+  mp_limb_t hi, lo;
+  umul_ppmm (hi, lo, a, b);
+  return ntt_redc (hi, lo, P);
+}
+
+/* Return b^e*R mod p, for b given as b*R mod p.  */
+static mp_limb_t
+ntt_powm (mp_limb_t b, mp_limb_t e, const struct ntt_prime *P)
+{
+  mp_limb_t r = P->one;
+  for (; e != 0; e >>= 1)
+    {
+      if (e & 1)
+	r = ntt_mulredc (r, b, P);
+      b = ntt_mulredc (b, b, P);
+    }
+  return r;
+}
+
+static void
+ntt_prime_init (struct ntt_prime *P, mp_limb_t p)
+{
+  mp_limb_t x;
+  int i;
+
+  P->p = p;
+  binvert_limb (P->pinv, p);
+
+  /* 2^64 and 2^128 mod p, by doubling, p < 2^63 so there's no overflow */
+  x = 1;
+  for (i = 0; i < 64; i++)
+    {
+      x <<= 1;
+      x -= (x >= p ? p : 0);
+    }
+  P->one = x;
+  for (i = 0; i < 64; i++)
+    {
+      x <<= 1;
+      x -= (x >= p ? p : 0);
+    }
+  P->r2 = x;
+}
+
+/* Transform {a,m} in place.  w[h+j] is w^j for w a primitive 2h-th root of
+   unity, for each power of 2 h < m.  */
+static void
+ntt_fwd (mp_ptr a, mp_size_t m, mp_srcptr w, const struct ntt_prime *P)
+{
+  mp_limb_t p = P->p;
+  mp_limb_t u, v, s;
+  mp_size_t h, j, k;
+
+  if (m > NTT_BLOCK)
+    {
+      h = m >> 1;
+      for (j = 0; j < h; j++)
+	{
+	  u = a[j];
+	  v = a[j + h];
+	  s = u + v;
+	  a[j] = s - (s >= p ? p : 0);
+	  a[j + h] = ntt_mulredc (u - v + (u < v ? p : 0), w[h + j], P);
+	}
+      ntt_fwd (a, h, w, P);
+      ntt_fwd (a + h, h, w, P);
+      return;
+    }
+
+  for (h = m >> 1; h >= 1; h >>= 1)
+    for (k = 0; k < m; k += 2 * h)
+      {
+	u = a[k];
+	v = a[k + h];
+	s = u + v;
+	a[k] = s - (s >= p ? p : 0);
+	a[k + h] = u - v + (u < v ? p : 0);
+	for (j = 1; j < h; j++)
+	  {
+	    u = a[k + j];
+	    v = a[k + j + h];
+	    s = u + v;
+	    a[k + j] = s - (s >= p ? p : 0);
+	    a[k + j + h] = ntt_mulredc (u - v + (u < v ? p : 0), w[h + j], P);
+	  }
+      }
+}
+
+/* The inverse of ntt_fwd, without the division by m.  The root w^-j for a
+   block of 2h is got as -w^(h-j), which is w[2h-j].  */
+static void
+ntt_inv (mp_ptr a, mp_size_t m, mp_srcptr w, const struct ntt_prime *P)
+{
+  mp_limb_t p = P->p;
+  mp_limb_t u, t, s;
+  mp_size_t h, j, k;
+
+  if (m > NTT_BLOCK)
+    {
+      h = m >> 1;
+      ntt_inv (a, h, w, P);
+      ntt_inv (a + h, h, w, P);
+    }
+  else
+    h = 1;
+
+  for (; h < m; h <<= 1)
+    for (k = 0; k < m; k += 2 * h)
+      {
+	u = a[k];
+	t = a[k + h];
+	s = u + t;
+	a[k] = s - (s >= p ? p : 0);
+	a[k + h] = u - t + (u < t ? p : 0);
+	for (j = 1; j < h; j++)
+	  {
+	    u = a[k + j];
+	    t = ntt_mulredc (a[k + j + h], w[2 * h - j], P);
+	    /* a[k+j] = u + v*w^-j = u - t, a[k+j+h] = u + t */
+	    s = u + t;
+	    a[k + j] = u - t + (u < t ? p : 0);
+	    a[k + j + h] = s - (s >= p ? p : 0);
+	  }
+      }
+}
+
+/* Load {xp,xn} into {a,n}, each limb reduced to x/R mod p, zero padded.  */
+static void
+ntt_load (mp_ptr a, mp_size_t n, mp_srcptr xp, mp_size_t xn,
+	  const struct ntt_prime *P)
+{
+  mp_size_t i;
+  for (i = 0; i < xn; i++)
+    a[i] = ntt_redc (CNST_LIMB(0), xp[i], P);
+  for (; i < n; i++)
+    a[i] = 0;
+}
+
+struct ntt_mul_par
+{
+  mp_srcptr ap, bp;
+  mp_size_t an, bn;
+  int logn;
+  mp_ptr res[3];		/* the product mod each prime, times N/R^3 */
+};
+
+/* Form the product modulo prime number i.  */
+static void
+ntt_mul_prime (void *arg, mp_size_t i)
+{
+  struct ntt_mul_par *par = (struct ntt_mul_par *) arg;
+  struct ntt_prime P;
+  mp_size_t n, h, j;
+  mp_ptr a, b, w;
+  TMP_DECL;
+
+  ntt_prime_init (&P, ntt_primes[i][0]);
+  n = (mp_size_t) 1 << par->logn;
+  a = par->res[i];
+
+  TMP_MARK;
+  w = TMP_BALLOC_LIMBS (n);
+
+  /* roots of unity for each level, in Montgomery form, see ntt_fwd */
+  h = n >> 1;
+  w[h] = P.one;
+  if (h > 1)
+    {
+      w[h + 1] = ntt_powm (ntt_mulredc (ntt_primes[i][1], P.r2, &P),
+			   (P.p - 1) >> par->logn, &P);
+      for (j = 2; j < h; j++)
+	w[h + j] = ntt_mulredc (w[h + j - 1], w[h + 1], &P);
+    }
+  for (h >>= 1; h >= 1; h >>= 1)
+    for (j = 0; j < h; j++)
+      w[h + j] = w[2 * h + 2 * j];
+
+  ntt_load (a, n, par->ap, par->an, &P);
+  ntt_fwd (a, n, w, &P);
+  if (par->bp == NULL)
+    {
+      for (j = 0; j < n; j++)
+	a[j] = ntt_mulredc (a[j], a[j], &P);
+    }
+  else
+    {
+      b = TMP_BALLOC_LIMBS (n);
+      ntt_load (b, n, par->bp, par->bn, &P);
+      ntt_fwd (b, n, w, &P);
+      for (j = 0; j < n; j++)
+	a[j] = ntt_mulredc (a[j], b[j], &P);
+    }
+  ntt_inv (a, n, w, &P);
+
+  TMP_FREE;
+}
+
+/* Multiply {ap,an} by {bp,bn}, and put the result in {rp,an+bn}.  */
+void
+mpn_mul_ntt (mp_ptr rp,
+	     mp_srcptr ap, mp_size_t an,
+	     mp_srcptr bp, mp_size_t bn)
+{
+  struct ntt_mul_par par;
+  struct ntt_prime P0, P1, P2;
+  mp_limb_t p0, p1, p2, s0, s1, s2, c1, c2, p0m2, q0, q1;
+  mp_limb_t r0, r1, r2, d, t, x1, x2, y0, y1, z0, z1, z2, h, cy0, cy1;
+  mp_size_t n, i, rn;
+  int logn;
+  TMP_DECL;
+
+  ASSERT (an >= bn);
+  ASSERT (bn > 0);
+
+  rn = an + bn;
+  for (logn = 1; ((mp_size_t) 1 << logn) < rn - 1; logn++)
+    ;
+  ASSERT_ALWAYS (logn <= NTT_LOG2_MAX);
+  n = (mp_size_t) 1 << logn;
+
+  TMP_MARK;
+  par.ap = ap;
+  par.an = an;
+  par.bp = (ap == bp && an == bn) ? NULL : bp;
+  par.bn = bn;
+  par.logn = logn;
+  par.res[0] = TMP_BALLOC_LIMBS (3 * n);
+  par.res[1] = par.res[0] + n;
+  par.res[2] = par.res[1] + n;
+  __gmp_parallel_run (ntt_mul_prime, &par, 3);
+
+  p0 = ntt_primes[0][0];
+  p1 = ntt_primes[1][0];
+  p2 = ntt_primes[2][0];
+  ntt_prime_init (&P0, p0);
+  ntt_prime_init (&P1, p1);
+  ntt_prime_init (&P2, p2);
+
+  /* s = R^4/n, so REDC(x*s) = x*R^3/n; 1/n = -(p-1)/n mod p */
+  s0 = p0 - ((p0 - 1) >> logn);
+  s1 = p1 - ((p1 - 1) >> logn);
+  s2 = p2 - ((p2 - 1) >> logn);
+  for (i = 0; i < 4; i++)
+    {
+      s0 = ntt_mulredc (s0, P0.r2, &P0);
+      s1 = ntt_mulredc (s1, P1.r2, &P1);
+      s2 = ntt_mulredc (s2, P2.r2, &P2);
+    }
+
+  /* c1 = R/p0 mod p1, c2 = R/(p0*p1) mod p2, p0m2 = p0*R mod p2, all
+     ready for REDC; p0 < 2*p1 and p0 < 2*p2 */
+  c1 = ntt_powm (ntt_mulredc (p0 - p1, P1.r2, &P1), p1 - 2, &P1);
+  p0m2 = ntt_mulredc (p0 - p2, P2.r2, &P2);
+  c2 = ntt_mulredc (p0m2, ntt_mulredc (p1 - p2, P2.r2, &P2), &P2);
+  c2 = ntt_powm (c2, p2 - 2, &P2);
+  umul_ppmm (q1, q0, p0, p1);
+
+  cy0 = cy1 = 0;
+  for (i = 0; i < rn - 1; i++)
+    {
+      r0 = ntt_mulredc (par.res[0][i], s0, &P0);
+      r1 = ntt_mulredc (par.res[1][i], s1, &P1);
+      r2 = ntt_mulredc (par.res[2][i], s2, &P2);
+
+      /* x1 = (r1 - r0)/p0 mod p1, y = r0 + x1*p0 */
+      t = r0 - (r0 >= p1 ? p1 : 0);
+      d = r1 - t + (r1 < t ? p1 : 0);
+      x1 = ntt_mulredc (d, c1, &P1);
+      umul_ppmm (y1, y0, x1, p0);
+      add_ssaaaa (y1, y0, y1, y0, CNST_LIMB(0), r0);
+
+      /* x2 = (r2 - y)/(p0*p1) mod p2 */
+      t = r0 - (r0 >= p2 ? p2 : 0);
+      t += ntt_mulredc (x1, p0m2, &P2);
+      t -= (t >= p2 ? p2 : 0);
+      d = r2 - t + (r2 < t ? p2 : 0);
+      x2 = ntt_mulredc (d, c2, &P2);
+
+      /* z = y + x2*p0*p1, the coefficient, plus the carry in */
+      umul_ppmm (h, z0, x2, q0);
+      umul_ppmm (z2, z1, x2, q1);
+      add_ssaaaa (z2, z1, z2, z1, CNST_LIMB(0), h);
+      /* y < 2^124 and the carry < 2^123, so y1+c and cy1+c can't wrap */
+      z0 += y0;
+      add_ssaaaa (z2, z1, z2, z1, CNST_LIMB(0), y1 + (z0 < y0));
+      z0 += cy0;
+      add_ssaaaa (z2, z1, z2, z1, CNST_LIMB(0), cy1 + (z0 < cy0));
+
+      rp[i] = z0;
+      cy0 = z1;
+      cy1 = z2;
+    }
+  rp[rn - 1] = cy0;
+  ASSERT (cy1 == 0);
+
+  TMP_FREE;
+}
+
+#else /* GMP_NUMB_BITS != 64 */
+
+void
+mpn_mul_ntt (mp_ptr rp,
+	     mp_srcptr ap, mp_size_t an,
+	     mp_srcptr bp, mp_size_t bn)
+{
+  mpn_fft_mul (rp, ap, an, bp, bn);
+}
+
+#endif
@@ -81,6 +81,25 @@ mpn_bc_mulmod_bnp1 (mp_ptr rp, mp_srcptr ap, mp_srcptr bp, mp_size_t rn,
 }
 
 
+/* The k for the mod B^n+1 product at a level of mpn_mulmod_bnm1 with
+   rn = 2n, or 0 if that product doesn't use mpn_mul_fft.  */
+static int
+mpn_mulmod_bnp1_fft_k (mp_size_t n)
+{
+  int k, mask;
+
+  if (BELOW_THRESHOLD (n, MUL_FFT_MODF_THRESHOLD))
+    return 0;
+  k = mpn_fft_best_k (n, 0);
+  mask = (1<<k) - 1;
+  while (n & mask) {k--; mask >>=1;};
+  return k >= FFT_FIRST_K ? k : 0;
+}
+
+static void
+mpn_mulmod_bnm1_pre (mp_ptr, mp_size_t, mp_srcptr, mp_size_t, mp_srcptr,
+		     mp_size_t, mp_ptr, const struct mul_fft_precomp *, int);
+
 /* Computes {rp,MIN(rn,an+bn)} <- {ap,an}*{bp,bn} Mod(B^rn-1)
  *
  * The result is expected to be ZERO if and only if one of the operand
@@ -99,6 +118,18 @@ mpn_bc_mulmod_bnp1 (mp_ptr rp, mp_srcptr ap, mp_srcptr bp, mp_size_t rn,
  */
 void
 mpn_mulmod_bnm1 (mp_ptr rp, mp_size_t rn, mp_srcptr ap, mp_size_t an, mp_srcptr bp, mp_size_t bn, mp_ptr tp)
+{
+  mpn_mulmod_bnm1_pre (rp, rn, ap, an, bp, bn, tp, NULL, 0);
+}
+
+/* Likewise, with pre from mpn_mulmod_bnm1_precomp_init, for rn and one
+   of the operands: the a one if prea, the b one otherwise.  pre has an
+   entry for each level of the recursion that uses mpn_mul_fft, or is NULL
+   if there are none left.  */
+static void
+mpn_mulmod_bnm1_pre (mp_ptr rp, mp_size_t rn, mp_srcptr ap, mp_size_t an,
+		     mp_srcptr bp, mp_size_t bn, mp_ptr tp,
+		     const struct mul_fft_precomp *pre, int prea)
 {
   ASSERT (0 < bn);
   ASSERT (bn <= an);
@@ -187,7 +218,9 @@ mpn_mulmod_bnm1 (mp_ptr rp, mp_size_t rn, mp_srcptr ap, mp_size_t an, mp_srcptr
 	    anm = an;
 	  }
 
-	mpn_mulmod_bnm1 (rp, n, am1, anm, bm1, bnm, so);
+	mpn_mulmod_bnm1_pre (rp, n, am1, anm, bm1, bnm, so,
+			     pre == NULL || pre[1].pl == 0 ? NULL : pre + 1,
+			     prea);
       }
 
       {
@@ -215,16 +248,16 @@ mpn_mulmod_bnm1 (mp_ptr rp, mp_size_t rn, mp_srcptr ap, mp_size_t an, mp_srcptr
 	  anp = an;
 	}
 
-	if (BELOW_THRESHOLD (n, MUL_FFT_MODF_THRESHOLD))
-	  k=0;
-	else
+	k = mpn_mulmod_bnp1_fft_k (n);
+	if (pre != NULL)
 	  {
-	    int mask;
-	    k = mpn_fft_best_k (n, 0);
-	    mask = (1<<k) - 1;
-	    while (n & mask) {k--; mask >>=1;};
+	    ASSERT (pre->pl == n && pre->k == k);
+	    if (prea)
+	      xp[n] = mpn_mul_fft_precomp (xp, bp1, bnp, pre);
+	    else
+	      xp[n] = mpn_mul_fft_precomp (xp, ap1, anp, pre);
 	  }
-	if (k >= FFT_FIRST_K)
+	else if (k != 0)
 	  xp[n] = mpn_mul_fft (xp, n, ap1, anp, bp1, bnp, k);
 	else if (UNLIKELY (bp1 == b0))
 	  {
@@ -334,6 +367,60 @@ mpn_mulmod_bnm1 (mp_ptr rp, mp_size_t rn, mp_srcptr ap, mp_size_t an, mp_srcptr
     }
 }
 
+/* Prepare {bp,bn} for repeated mpn_mulmod_bnm1_precomp mod B^rn-1, by
+   transforming it for each mpn_mul_fft in the recursion.  The result is
+   NULL if there are none, otherwise an array with an entry per level,
+   ended by one with pl == 0.  */
+struct mul_fft_precomp *
+mpn_mulmod_bnm1_precomp_init (mp_size_t rn, mp_srcptr bp, mp_size_t bn)
+{
+  struct mul_fft_precomp *pre;
+  mp_size_t n;
+  int i, levels;
+
+  for (levels = 0, n = rn;
+       (n & 1) == 0 && !BELOW_THRESHOLD (n, MULMOD_BNM1_THRESHOLD)
+	 && mpn_mulmod_bnp1_fft_k (n >> 1) != 0;
+       n >>= 1)
+    levels++;
+
+  if (levels == 0)
+    return NULL;
+
+  pre = __GMP_ALLOCATE_FUNC_TYPE (levels + 1, struct mul_fft_precomp);
+  for (i = 0, n = rn >> 1; i < levels; i++, n >>= 1)
+    mpn_mul_fft_precomp_init (pre + i, n, bp, bn, mpn_mulmod_bnp1_fft_k (n));
+  pre[levels].pl = 0;
+  return pre;
+}
+
+/* {rp,MIN(rn,an+bn)} <- {ap,an}*{bp,bn} Mod(B^rn-1), as for
+   mpn_mulmod_bnm1 but with pre = mpn_mulmod_bnm1_precomp_init (rn, bp, bn),
+   and only the sizes of the two operands limited, by an,bn <= rn and
+   an + bn > rn/2.  */
+void
+mpn_mulmod_bnm1_precomp (mp_ptr rp, mp_size_t rn, mp_srcptr ap, mp_size_t an,
+			 mp_srcptr bp, mp_size_t bn,
+			 const struct mul_fft_precomp *pre, mp_ptr tp)
+{
+  if (an >= bn)
+    mpn_mulmod_bnm1_pre (rp, rn, ap, an, bp, bn, tp, pre, 0);
+  else
+    mpn_mulmod_bnm1_pre (rp, rn, bp, bn, ap, an, tp, pre, 1);
+}
+
+void
+mpn_mulmod_bnm1_precomp_clear (struct mul_fft_precomp *pre)
+{
+  int i;
+
+  if (pre == NULL)
+    return;
+  for (i = 0; pre[i].pl != 0; i++)
+    mpn_mul_fft_precomp_clear (pre + i);
+  __GMP_FREE_FUNC_TYPE (pre, i + 1, struct mul_fft_precomp);
+}
+
 mp_size_t
 mpn_mulmod_bnm1_next_size (mp_size_t n)
 {
@@ -107,43 +107,6 @@ see https://www.gnu.org/licenses/.  */
 #define WANT_REDC_2 1
 #endif
 
-#define getbit(p,bi) \
-  ((p[(bi - 1) / GMP_LIMB_BITS] >> (bi - 1) % GMP_LIMB_BITS) & 1)
-
-static inline mp_limb_t
-getbits (const mp_limb_t *p, mp_bitcnt_t bi, int nbits)
-{
-  int nbits_in_r;
-  mp_limb_t r;
-  mp_size_t i;
-
-  if (bi < nbits)
-    {
-      return p[0] & (((mp_limb_t) 1 << bi) - 1);
-    }
-  else
-    {
-      bi -= nbits;			/* bit index of low bit to extract */
-      i = bi / GMP_NUMB_BITS;		/* word index of low bit to extract */
-      bi %= GMP_NUMB_BITS;		/* bit index in low word */
-      r = p[i] >> bi;			/* extract (low) bits */
-      nbits_in_r = GMP_NUMB_BITS - bi;	/* number of bits now in r */
-      if (nbits_in_r < nbits)		/* did we get enough bits? */
-	r += p[i + 1] << nbits_in_r;	/* prepend bits from higher word */
-      return r & (((mp_limb_t ) 1 << nbits) - 1);
-    }
-}
-
-static inline int
-win_size (mp_bitcnt_t eb)
-{
-  int k;
-  static mp_bitcnt_t x[] = {0,7,25,81,241,673,1793,4609,11521,28161,~(mp_bitcnt_t)0};
-  for (k = 1; eb > x[k]; k++)
-    ;
-  return k;
-}
-
 /* Convert U to REDC form, U_r = B^n * U mod M */
 static void
 redcify (mp_ptr rp, mp_srcptr up, mp_size_t un, mp_srcptr mp, mp_size_t n)
@@ -194,14 +157,14 @@ mpn_powm (mp_ptr rp, mp_srcptr bp, mp_size_t bn,
 	{
 	  mpn_sqr (tp, this_pp, tn);
 	  tn = tn * 2 - 1,  tn += tp[tn] != 0;
-	  if (getbit (ep, ebi) != 0)
+	  if (mpn_powm_getbit (ep, ebi) != 0)
 	    mpn_mul (..., tp, tn, bp, bn);
 	  ebi--;
 	}
     }
 #endif
 
-  windowsize = win_size (ebi);
+  windowsize = mpn_powm_win_size (ebi);
 
 #if WANT_REDC_2
   if (BELOW_THRESHOLD (n, REDC_1_TO_REDC_2_THRESHOLD))
@@ -267,7 +230,7 @@ mpn_powm (mp_ptr rp, mp_srcptr bp, mp_size_t bn,
 	mpn_redc_n (this_pp, tp, mp, n, mip);
     }
 
-  expbits = getbits (ep, ebi, windowsize);
+  expbits = mpn_powm_getbits (ep, ebi, windowsize);
   if (ebi < windowsize)
     ebi = 0;
   else
@@ -282,7 +245,7 @@ mpn_powm (mp_ptr rp, mp_srcptr bp, mp_size_t bn,
 #define INNERLOOP							\
   while (ebi != 0)							\
     {									\
-      while (getbit (ep, ebi) == 0)					\
+      while (mpn_powm_getbit (ep, ebi) == 0)					\
 	{								\
 	  MPN_SQR (tp, rp, n);						\
 	  MPN_REDUCE (rp, tp, mp, n, mip);				\
@@ -295,7 +258,7 @@ mpn_powm (mp_ptr rp, mp_srcptr bp, mp_size_t bn,
 	 block of bits <= windowsize, and such that the least		\
 	 significant bit is 1.  */					\
 									\
-      expbits = getbits (ep, ebi, windowsize);				\
+      expbits = mpn_powm_getbits (ep, ebi, windowsize);				\
       this_windowsize = windowsize;					\
       if (ebi < windowsize)						\
 	{								\
@@ -350,7 +313,10 @@ mpn_powm (mp_ptr rp, mp_srcptr bp, mp_size_t bn,
 	      INNERLOOP;
 	    }
 	}
-      else if (BELOW_THRESHOLD (n, MUL_TOOM22_THRESHOLD))
+      /* mip is only the 2-limb inverse below REDC_2_TO_REDC_N_THRESHOLD,
+	 which with a fast mul_basecase can be under MUL_TOOM22_THRESHOLD.  */
+      else if (BELOW_THRESHOLD (n, MUL_TOOM22_THRESHOLD)
+	       && BELOW_THRESHOLD (n, REDC_2_TO_REDC_N_THRESHOLD))
 	{
 	  if (MUL_TOOM22_THRESHOLD < SQR_BASECASE_THRESHOLD
 	      || BELOW_THRESHOLD (n, SQR_BASECASE_THRESHOLD))
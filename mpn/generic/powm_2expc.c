@@ -0,0 +1,146 @@
+/* mpn_powm_2expc -- exponentiation modulo 2^k - c or 2^k + c for small c.
+
+   THE FUNCTION IN THIS FILE IS INTERNAL WITH A MUTABLE INTERFACE.  IT IS ONLY
+   SAFE TO REACH IT THROUGH DOCUMENTED INTERFACES.  IN FACT, IT IS ALMOST
+   GUARANTEED THAT IT WILL CHANGE OR DISAPPEAR IN A FUTURE GMP RELEASE.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "longlong.h"
+
+
+/* The same sliding window left-to-right method as mpn_powm, but in plain
+   form, with each product reduced by mpn_mod_2expc.  There's no REDC
+   inverse or conversion, and nothing requires an odd modulus.  */
+
+/* rp[n-1..0] = bp[bn-1..0] ^ ep[en-1..0] mod mp[n-1..0], where red is
+   from mpn_mod_2expc_init for mp.
+   Requires that ep[en-1..0] is > 1.  */
+void
+mpn_powm_2expc (mp_ptr rp, mp_srcptr bp, mp_size_t bn,
+		mp_srcptr ep, mp_size_t en,
+		mp_srcptr mp, mp_size_t n, const gmp_2expc_t *red)
+{
+  int cnt;
+  mp_bitcnt_t ebi;
+  int windowsize, this_windowsize;
+  mp_limb_t expbits;
+  mp_ptr pp, this_pp, tp, sp;
+  long i;
+  TMP_DECL;
+
+  ASSERT (en > 1 || (en == 1 && ep[0] > 1));
+  ASSERT (n >= 1);
+
+  TMP_MARK;
+
+  MPN_SIZEINBASE_2EXP(ebi, ep, en, 1);
+
+  windowsize = mpn_powm_win_size (ebi);
+
+  pp = TMP_ALLOC_LIMBS (n << (windowsize - 1));
+  TMP_ALLOC_LIMBS_2 (tp, 2 * n,
+		     sp, mpn_mod_2expc_itch (MAX (bn, 2 * n), n));
+
+#define MPN_REDUCE(rp, tp)  mpn_mod_2expc (rp, tp, 2 * n, mp, n, red, sp)
+
+  this_pp = pp;
+  mpn_mod_2expc (this_pp, bp, bn, mp, n, red, sp);
+
+  /* Store b^2 at rp.  */
+  mpn_sqr (tp, this_pp, n);
+  MPN_REDUCE (rp, tp);
+
+  /* Precompute odd powers of b and put them in the temporary area at pp.  */
+  for (i = (1 << (windowsize - 1)) - 1; i > 0; i--)
+    {
+      mpn_mul_n (tp, this_pp, rp, n);
+      this_pp += n;
+      MPN_REDUCE (this_pp, tp);
+    }
+
+  expbits = mpn_powm_getbits (ep, ebi, windowsize);
+  if (ebi < windowsize)
+    ebi = 0;
+  else
+    ebi -= windowsize;
+
+  count_trailing_zeros (cnt, expbits);
+  ebi += cnt;
+  expbits >>= cnt;
+
+  MPN_COPY (rp, pp + n * (expbits >> 1), n);
+
+  while (ebi != 0)
+    {
+      while (mpn_powm_getbit (ep, ebi) == 0)
+	{
+	  mpn_sqr (tp, rp, n);
+	  MPN_REDUCE (rp, tp);
+	  ebi--;
+	  if (ebi == 0)
+	    goto done;
+	}
+
+      /* The next bit of the exponent is 1.  Now extract the largest
+	 block of bits <= windowsize, and such that the least
+	 significant bit is 1.  */
+
+      expbits = mpn_powm_getbits (ep, ebi, windowsize);
+      this_windowsize = windowsize;
+      if (ebi < windowsize)
+	{
+	  this_windowsize -= windowsize - ebi;
+	  ebi = 0;
+	}
+      else
+	ebi -= windowsize;
+
+      count_trailing_zeros (cnt, expbits);
+      this_windowsize -= cnt;
+      ebi += cnt;
+      expbits >>= cnt;
+
+      do
+	{
+	  mpn_sqr (tp, rp, n);
+	  MPN_REDUCE (rp, tp);
+	  this_windowsize--;
+	}
+      while (this_windowsize != 0);
+
+      mpn_mul_n (tp, rp, pp + n * (expbits >> 1), n);
+      MPN_REDUCE (rp, tp);
+    }
+
+ done:
+  TMP_FREE;
+}
@@ -0,0 +1,411 @@
+/* mpn_powm_batch -- many independent same-size modular exponentiations.
+
+   THE FUNCTION IN THIS FILE IS INTERNAL WITH A MUTABLE INTERFACE.  IT IS ONLY
+   SAFE TO REACH IT THROUGH DOCUMENTED INTERFACES.  IN FACT, IT IS ALMOST
+   GUARANTEED THAT IT WILL CHANGE OR DISAPPEAR IN A FUTURE GNU MP RELEASE.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "longlong.h"
+
+/* With 64-bit limbs, 8 exponentiations go side by side in the lanes of
+   mpn_amm52_8, each lane with its own base, exponent and modulus.  The
+   residues are in Montgomery form for R = 2^(52d), and are only kept below
+   2m, never fully reduced until the end.  The exponents are taken in fixed
+   windows from the top of the largest, so that all lanes do the same
+   squarings and multiplications, each lane multiplying by the table entry
+   for its own window bits.  That's a few more multiplications than the
+   sliding windows of mpn_powm, but no lane ever waits for another.
+
+   mpn_powm_batch uses this when there's a native mpn_amm52_8, which will be
+   a vector one doing the 8 lanes at once.  The C mpn_amm52_8 does them one
+   after the other, slower than mpn_powm, and is there for testing.  A group
+   costs about 2 mpn_powm, so the items left over, below 8, are padded with
+   copies of the first of the group if there are at least
+   POWM_52X8_MIN_ITEMS of them, otherwise done by mpn_powm.  */
+
+#define LANES  8
+#define DBITS  52
+#define DMASK  ((CNST_LIMB(1) << DBITS) - 1)
+
+#if GMP_NAIL_BITS == 0 && GMP_LIMB_BITS == 64
+
+/* On an Emerald Rapids Xeon, a group of 8 takes about a quarter of the time
+   of 8 mpn_powm from 256 to 6144 bits, and the table for the fixed windows
+   falls out of L2 past 12000 bits or so, where mpn_powm is also into
+   toom22.  */
+#ifndef POWM_52X8_MAX_N
+#define POWM_52X8_MAX_N  192
+#endif
+#ifndef POWM_52X8_MIN_ITEMS
+#define POWM_52X8_MIN_ITEMS  3
+#endif
+
+#if HAVE_NATIVE_mpn_amm52_8
+#define POWM_52X8_P(n)  ((n) <= POWM_52X8_MAX_N)
+#else
+#define POWM_52X8_P(n)  0
+#endif
+
+/* Lane l of the d digit xp from {up,un}.  */
+static void
+to_digits (mp_ptr xp, int l, mp_srcptr up, mp_size_t un, mp_size_t d)
+{
+  mp_limb_t acc, limb;
+  mp_size_t i, j;
+  int bits;
+
+  acc = 0;
+  bits = 0;
+  for (i = j = 0; j < d; j++)
+    {
+      if (bits >= DBITS)
+	{
+	  xp[LANES * j + l] = acc & DMASK;
+	  acc >>= DBITS;
+	  bits -= DBITS;
+	}
+      else
+	{
+	  limb = i < un ? up[i++] : 0;
+	  xp[LANES * j + l] = (acc | (limb << bits)) & DMASK;
+	  acc = limb >> (DBITS - bits);
+	  bits += GMP_LIMB_BITS - DBITS;
+	}
+    }
+}
+
+/* {rp,n} from lane l of the d digit xp, whose value must fit.  */
+static void
+from_digits (mp_ptr rp, mp_size_t n, mp_srcptr xp, int l, mp_size_t d)
+{
+  mp_limb_t acc, x;
+  mp_size_t i, j;
+  int bits;
+
+  acc = 0;
+  bits = 0;
+  for (i = j = 0; j < d && i < n; j++)
+    {
+      x = xp[LANES * j + l];
+      acc |= x << bits;
+      if (bits + DBITS >= GMP_LIMB_BITS)
+	{
+	  rp[i++] = acc;
+	  acc = x >> (GMP_LIMB_BITS - bits);
+	  bits -= GMP_LIMB_BITS - DBITS;
+	}
+      else
+	bits += DBITS;
+    }
+  if (i < n)
+    {
+      rp[i++] = acc;
+      MPN_ZERO (rp + i, n - i);
+    }
+}
+
+/* Lane l of gp from the table entries picked by the w bits of each ep[l]
+   at bit pos.  Bits past en limbs are zeros.  */
+static void
+tab_gather (mp_ptr gp, mp_srcptr tab, mp_srcptr *ep, mp_size_t en,
+	    mp_bitcnt_t pos, int w, mp_size_t d)
+{
+  mp_srcptr xp;
+  mp_limb_t e;
+  mp_size_t i, j;
+  unsigned s;
+  int l;
+
+  i = pos / GMP_NUMB_BITS;
+  s = pos % GMP_NUMB_BITS;
+  for (l = 0; l < LANES; l++)
+    {
+      e = 0;
+      if (i < en)
+	{
+	  e = ep[l][i] >> s;
+	  if (s + w > GMP_NUMB_BITS && i + 1 < en)
+	    e |= ep[l][i + 1] << (GMP_NUMB_BITS - s);
+	  e &= (CNST_LIMB(1) << w) - 1;
+	}
+      xp = tab + e * (LANES * d);
+      for (j = 0; j < d; j++)
+	gp[LANES * j + l] = xp[LANES * j + l];
+    }
+}
+
+/* rp[l][n-1..0] = bp[l][n-1..0] ^ ep[l][en-1..0] mod mp[l][n-1..0], for
+   the 8 lanes 0 <= l < 8, each mp[l] odd with mp[l][n-1] non-zero.  High
+   zero limbs in ep[l] are allowed, and so is a zero exponent.  The rp[l]
+   must not overlap the inputs.  */
+void
+mpn_powm_52x8 (mp_ptr *rp, mp_srcptr *bp, mp_srcptr *ep, mp_size_t en,
+	       mp_srcptr *mp, mp_size_t n)
+{
+  mp_ptr kp, md, tab, xp, yp, gp, np, qp, r2p;
+  mp_size_t d, dl, nn, i;
+  mp_bitcnt_t ebits, bits, pos;
+  mp_limb_t inv;
+  int l, w, k;
+  TMP_DECL;
+
+  /* d digits with 4m < 2^(52d) */
+  d = (GMP_NUMB_BITS * n + 2 + DBITS - 1) / DBITS;
+  dl = LANES * d;
+  ASSERT (d < 1024);
+
+  ebits = 0;
+  for (l = 0; l < LANES; l++)
+    {
+      i = en;
+      MPN_NORMALIZE (ep[l], i);
+      if (i != 0)
+	{
+	  MPN_SIZEINBASE_2EXP (bits, ep[l], i, 1);
+	  ebits = MAX (ebits, bits);
+	}
+    }
+
+  /* Window size, balancing ebits/w multiplications against 2^w for the
+     table.  */
+  for (w = 1; w < 8 && ebits / w + (1 << w) > ebits / (w + 1) + (2 << w); w++)
+    ;
+
+  TMP_MARK;
+  kp = TMP_ALLOC_LIMBS (LANES);
+  tab = TMP_ALLOC_LIMBS (dl << w);
+  TMP_ALLOC_LIMBS_2 (md, dl, xp, dl);
+  TMP_ALLOC_LIMBS_2 (yp, dl, gp, dl);
+  nn = 2 * DBITS * d / GMP_NUMB_BITS + 1;
+  TMP_ALLOC_LIMBS_3 (np, nn, qp, nn - n + 1, r2p, n);
+
+  /* In each lane, md = m, kp = -1/m mod 2^52, xp = b and gp = 2^(104d) mod
+     m.  */
+  for (l = 0; l < LANES; l++)
+    {
+      binvert_limb (inv, mp[l][0]);
+      kp[l] = -inv & DMASK;
+      to_digits (md, l, mp[l], n, d);
+      to_digits (xp, l, bp[l], n, d);
+
+      MPN_ZERO (np, nn);
+      np[nn - 1] = CNST_LIMB(1) << (2 * DBITS * d % GMP_NUMB_BITS);
+      mpn_tdiv_qr (qp, r2p, 0L, np, nn, mp[l], n);
+      to_digits (gp, l, r2p, n, d);
+    }
+
+  /* tab[k] = b^k 2^(52d) mod m, below 2m.  Since b < 2^(64n) <= 2^(52d)/4
+     and 2^(104d) mod m is below m, the first product is below 2m too.  */
+  mpn_amm52_8 (tab + dl, xp, gp, md, kp, d);
+  MPN_ZERO (yp, dl);
+  for (l = 0; l < LANES; l++)
+    yp[l] = 1;
+  mpn_amm52_8 (tab, gp, yp, md, kp, d);
+  for (k = 2; k < 1 << w; k++)
+    mpn_amm52_8 (tab + k * dl, tab + (k - 1) * dl, tab + dl, md, kp, d);
+
+  pos = (ebits + w - 1) / w * w;
+  if (pos == 0)
+    MPN_COPY (xp, tab, dl);
+  else
+    {
+      pos -= w;
+      tab_gather (xp, tab, ep, en, pos, w, d);
+    }
+
+  while (pos != 0)
+    {
+      pos -= w;
+      for (k = 0; k < w; k++)
+	{
+	  mpn_amm52_8 (yp, xp, xp, md, kp, d);
+	  MP_PTR_SWAP (xp, yp);
+	}
+      tab_gather (gp, tab, ep, en, pos, w, d);
+      mpn_amm52_8 (yp, xp, gp, md, kp, d);
+      MP_PTR_SWAP (xp, yp);
+    }
+
+  /* Out of Montgomery form.  The product by 1 is at most m, and only m
+     itself when the residue is 0.  */
+  MPN_ZERO (gp, dl);
+  for (l = 0; l < LANES; l++)
+    gp[l] = 1;
+  mpn_amm52_8 (yp, xp, gp, md, kp, d);
+  for (l = 0; l < LANES; l++)
+    {
+      from_digits (rp[l], n, yp, l, d);
+      if (mpn_cmp (rp[l], mp[l], n) >= 0)
+	mpn_sub_n (rp[l], rp[l], mp[l], n);
+    }
+
+  TMP_FREE;
+}
+
+#else
+#define POWM_52X8_P(n)  0
+#endif
+
+struct powm_batch
+{
+  mp_ptr *rp;
+  mp_srcptr *bp;
+  mp_srcptr *ep;
+  mp_size_t en;
+  mp_srcptr *mp;
+  mp_size_t n;
+  mp_size_t count;
+};
+
+static void
+powm_batch_one (struct powm_batch *b, mp_size_t i, mp_ptr tp)
+{
+  mp_size_t en;
+
+  en = b->en;
+  MPN_NORMALIZE (b->ep[i], en);
+  mpn_powm (b->rp[i], b->bp[i], b->n, b->ep[i], en, b->mp[i], b->n, tp);
+}
+
+static void
+powm_batch_item (void *arg, mp_size_t i)
+{
+  struct powm_batch *b = (struct powm_batch *) arg;
+  mp_ptr tp;
+  TMP_DECL;
+
+  TMP_MARK;
+  tp = TMP_ALLOC_LIMBS (MAX (mpn_binvert_itch (b->n), 2 * b->n));
+  powm_batch_one (b, i, tp);
+  TMP_FREE;
+}
+
+#if GMP_NAIL_BITS == 0 && GMP_LIMB_BITS == 64
+/* Items 8g and up, padded to 8 with copies of item 8g.  */
+static void
+powm_batch_group (void *arg, mp_size_t g)
+{
+  struct powm_batch *b = (struct powm_batch *) arg;
+  mp_ptr rp[LANES];
+  mp_srcptr bp[LANES], ep[LANES], mp[LANES];
+  mp_ptr tp;
+  mp_size_t i, k;
+  int l;
+  TMP_DECL;
+
+  TMP_MARK;
+  i = g * LANES;
+  k = MIN (LANES, b->count - i);
+  tp = k < LANES ? TMP_ALLOC_LIMBS (b->n) : NULL;
+  for (l = 0; l < LANES; l++)
+    {
+      bp[l] = b->bp[i + (l < k ? l : 0)];
+      ep[l] = b->ep[i + (l < k ? l : 0)];
+      mp[l] = b->mp[i + (l < k ? l : 0)];
+      rp[l] = l < k ? b->rp[i + l] : tp;
+    }
+  mpn_powm_52x8 (rp, bp, ep, b->en, mp, b->n);
+  TMP_FREE;
+}
+#endif
+
+/* rp[i][n-1..0] = bp[i][n-1..0] ^ ep[i][en-1..0] mod mp[i][n-1..0], for
+   0 <= i < count.
+
+   Each mp[i] must be odd with mp[i][n-1] non-zero, and each ep[i] > 1,
+   though high zero limbs in ep[i] are allowed, so exponents of a common
+   bit size but varying limb count can share one en.  The rp[i] must not
+   overlap each other or any of the inputs.
+
+   The exponentiations are independent and of the same size.  Groups of 8
+   go through mpn_powm_52x8 where that's faster, the rest through
+   mpn_powm, and either way they're spread over the threads.  */
+void
+mpn_powm_batch (mp_ptr *rp, mp_srcptr *bp, mp_srcptr *ep, mp_size_t en,
+		mp_srcptr *mp, mp_size_t n, mp_size_t count)
+{
+  struct powm_batch b;
+  mp_ptr tp;
+  mp_size_t i, groups;
+  TMP_DECL;
+
+  ASSERT (n >= 1);
+  ASSERT (en >= 1);
+
+  b.rp = rp;
+  b.bp = bp;
+  b.ep = ep;
+  b.en = en;
+  b.mp = mp;
+  b.n = n;
+  b.count = count;
+
+  groups = 0;
+  if (POWM_52X8_P (n))
+    {
+      groups = count / LANES;
+      if (count % LANES >= POWM_52X8_MIN_ITEMS)
+	groups++;
+    }
+
+#if GMP_NAIL_BITS == 0 && GMP_LIMB_BITS == 64
+  if (groups != 0)
+    {
+      if (groups > 1 && __gmp_parallel_threads () > 1)
+	__gmp_parallel_run (powm_batch_group, &b, groups);
+      else
+	for (i = 0; i < groups; i++)
+	  powm_batch_group (&b, i);
+    }
+#endif
+
+  i = MIN (count, groups * LANES);
+  if (i == count)
+    return;
+  b.rp += i;
+  b.bp += i;
+  b.ep += i;
+  b.mp += i;
+  count -= i;
+
+  if (count > 1 && __gmp_parallel_threads () > 1)
+    {
+      __gmp_parallel_run (powm_batch_item, &b, count);
+      return;
+    }
+
+  TMP_MARK;
+  tp = TMP_ALLOC_LIMBS (MAX (mpn_binvert_itch (n), 2 * n));
+  for (i = 0; i < count; i++)
+    powm_batch_one (&b, i, tp);
+  TMP_FREE;
+}
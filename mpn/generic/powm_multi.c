@@ -0,0 +1,364 @@
+/* mpn_powm_multi -- product of several powers modulo an odd number.
+
+   THE FUNCTION IN THIS FILE IS INTERNAL WITH A MUTABLE INTERFACE.  IT IS ONLY
+   SAFE TO REACH IT THROUGH DOCUMENTED INTERFACES.  IN FACT, IT IS ALMOST
+   GUARANTEED THAT IT WILL CHANGE OR DISAPPEAR IN A FUTURE GNU MP RELEASE.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include <string.h> /* for memset */
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "longlong.h"
+
+
+/* Two methods, both sharing one chain of squarings among all the bases,
+   so that k exponentiations of ebits bits cost ebits squarings instead of
+   k ebits.
+
+   Straus, with interleaved sliding windows.  Each base gets its own table
+   of odd powers and its own window size, as in mpn_powm, and a window
+   multiplies into the common result at the bit where it ends.  That's
+   about 2^(w-1) + ebits/(w+1) multiplications per base.
+
+   Pippenger, with buckets.  The exponents are cut into columns of c bits.
+   For each column, each base is multiplied into the bucket of its digit,
+   and then prod v^bucket[v] is formed with two running products over the
+   2^c buckets.  That's ebits/c multiplications per base plus 2^(c+1)
+   for every column, shared by all bases, so it wins once there are many
+   more than 2^c bases.
+
+   The cheaper of the two by multiplication count is used.  */
+
+/* Largest Pippenger column.  The buckets take 2^c n limbs.  */
+#define POWM_MULTI_MAX_BUCKET_BITS 12
+
+/* Bits lo to lo+nbits-1 of {ep,en}, zero beyond en, for nbits less than
+   GMP_NUMB_BITS.  */
+static mp_limb_t
+getbits_at (mp_srcptr ep, mp_size_t en, mp_bitcnt_t lo, int nbits)
+{
+  mp_size_t i;
+  int sh;
+  mp_limb_t r;
+
+  i = lo / GMP_NUMB_BITS;
+  sh = lo % GMP_NUMB_BITS;
+  if (i >= en)
+    return 0;
+  r = ep[i] >> sh;
+  if (sh + nbits > GMP_NUMB_BITS && i + 1 < en)
+    r |= ep[i + 1] << (GMP_NUMB_BITS - sh);
+  return r & ((CNST_LIMB(1) << nbits) - 1);
+}
+
+static inline int
+win_size (mp_bitcnt_t eb)
+{
+  int k;
+  static mp_bitcnt_t x[] = {0,7,25,81,241,673,1793,4609,11521,28161,~(mp_bitcnt_t)0};
+  for (k = 1; eb > x[k]; k++)
+    ;
+  return k;
+}
+
+/* {rp,n} = {ap,n} {bp,n} / B^n mod m, with 2n limbs of scratch at tp.  */
+static void
+mulredc (mp_ptr rp, mp_srcptr ap, mp_srcptr bp, mp_size_t n,
+	 mp_srcptr mp, mp_srcptr ip, mp_ptr tp)
+{
+  if (ap == bp)
+    mpn_sqr (tp, ap, n);
+  else
+    mpn_mul_n (tp, ap, bp, n);
+  mpn_redc (rp, tp, mp, n, ip);
+}
+
+/* One base in the Straus method.  Bits below scan of the exponent are yet
+   to be looked at.  The next window ends at bit end-1, or end is 0 when
+   there are no more, and multiplies by tab[idx] = b^(2idx+1).  */
+struct powm_multi_straus
+{
+  mp_srcptr ep;
+  mp_size_t en;
+  mp_ptr tab;
+  int w;
+  mp_bitcnt_t scan;
+  mp_bitcnt_t end;
+  mp_size_t idx;
+};
+
+static void
+straus_next (struct powm_multi_straus *s)
+{
+  mp_bitcnt_t lo, top;
+  mp_limb_t v;
+  int cnt;
+
+  top = s->scan;
+  while (top > 0 && getbits_at (s->ep, s->en, top - 1, 1) == 0)
+    top--;
+  if (top == 0)
+    {
+      s->end = 0;
+      return;
+    }
+  lo = top > s->w ? top - s->w : 0;
+  v = getbits_at (s->ep, s->en, lo, top - lo);
+  count_trailing_zeros (cnt, v);
+  s->end = lo + cnt + 1;
+  s->idx = v >> (cnt + 1);
+  s->scan = lo;
+}
+
+/* The same as mpn_powm_multi below, but with the bases and the result in
+   REDC form, and the inverse ip from mpn_redc_inverse given.  The bases
+   must be less than B^n, and the result is less than B^n but not
+   necessarily less than m.  At least one exponent must be non-zero.  */
+void
+mpn_powm_multi_redc (mp_ptr rp, mp_srcptr *bp, mp_srcptr *ep,
+		     const mp_size_t *en, mp_size_t k,
+		     mp_srcptr mp, mp_size_t n, mp_srcptr ip)
+{
+  struct powm_multi_straus *s;
+  mp_ptr tp, p;
+  mp_bitcnt_t bits, maxbits, j, col, cols;
+  mp_size_t i, v, cost_s, cost_p, best_p, entries;
+  int c, best_c, have;
+  TMP_DECL;
+
+  ASSERT (n >= 1);
+  ASSERT ((mp[0] & 1) != 0);
+  ASSERT (mp[n - 1] != 0);
+  ASSERT (n > 1 || mp[0] > 1);
+
+  TMP_MARK;
+  s = TMP_ALLOC_TYPE (k, struct powm_multi_straus);
+  tp = TMP_ALLOC_LIMBS (2 * n);
+
+  maxbits = 0;
+  cost_s = 0;
+  for (i = 0; i < k; i++)
+    {
+      bits = 0;
+      if (en[i] != 0)
+	MPN_SIZEINBASE_2EXP (bits, ep[i], en[i], 1);
+      maxbits = MAX (maxbits, bits);
+      s[i].w = win_size (bits);
+      cost_s += ((mp_size_t) 1 << (s[i].w - 1)) + bits / (s[i].w + 1);
+    }
+
+  ASSERT (maxbits != 0);
+
+  best_c = 0;
+  best_p = cost_s;
+  for (c = 1; c <= POWM_MULTI_MAX_BUCKET_BITS; c++)
+    {
+      cost_p = (mp_size_t) ((maxbits + c - 1) / c)
+	* (k + ((mp_size_t) 2 << c));
+      if (cost_p < best_p)
+	{
+	  best_p = cost_p;
+	  best_c = c;
+	}
+    }
+
+  have = 0;
+  if (best_c == 0)
+    {
+      /* Straus */
+      entries = 0;
+      for (i = 0; i < k; i++)
+	entries += (mp_size_t) 1 << (s[i].w - 1);
+      p = TMP_ALLOC_LIMBS (entries * n);
+
+      for (i = 0; i < k; i++)
+	{
+	  s[i].ep = ep[i];
+	  s[i].en = en[i];
+	  s[i].tab = p;
+	  s[i].scan = 0;
+	  if (en[i] != 0)
+	    MPN_SIZEINBASE_2EXP (s[i].scan, ep[i], en[i], 1);
+	  MPN_COPY (p, bp[i], n);
+	  if (s[i].w > 1)
+	    {
+	      /* b^2 at rp, then the odd powers */
+	      mulredc (rp, p, p, n, mp, ip, tp);
+	      for (v = 1; v < ((mp_size_t) 1 << (s[i].w - 1)); v++)
+		mulredc (p + v * n, p + (v - 1) * n, rp, n, mp, ip, tp);
+	    }
+	  p += n << (s[i].w - 1);
+	  straus_next (&s[i]);
+	}
+
+      for (j = maxbits; j > 0; j--)
+	{
+	  if (have)
+	    mulredc (rp, rp, rp, n, mp, ip, tp);
+	  for (i = 0; i < k; i++)
+	    if (s[i].end == j)
+	      {
+		if (have)
+		  mulredc (rp, rp, s[i].tab + s[i].idx * n, n, mp, ip, tp);
+		else
+		  MPN_COPY (rp, s[i].tab + s[i].idx * n, n);
+		have = 1;
+		straus_next (&s[i]);
+	      }
+	}
+    }
+  else
+    {
+      /* Pippenger */
+      mp_ptr bucket, acc, sum;
+      char *full;
+      int have_acc, have_sum;
+      mp_limb_t d;
+
+      c = best_c;
+      bucket = TMP_ALLOC_LIMBS (n << c);
+      TMP_ALLOC_LIMBS_2 (acc, n, sum, n);
+      full = TMP_ALLOC_TYPE ((size_t) 1 << c, char);
+      cols = (maxbits + c - 1) / c;
+
+      for (col = cols; col-- > 0; )
+	{
+	  if (have)
+	    for (v = 0; v < c; v++)
+	      mulredc (rp, rp, rp, n, mp, ip, tp);
+
+	  memset (full, 0, (size_t) 1 << c);
+	  for (i = 0; i < k; i++)
+	    {
+	      d = getbits_at (ep[i], en[i], col * c, c);
+	      if (d == 0)
+		continue;
+	      if (full[d])
+		mulredc (bucket + d * n, bucket + d * n, bp[i],
+			 n, mp, ip, tp);
+	      else
+		MPN_COPY (bucket + d * n, bp[i], n);
+	      full[d] = 1;
+	    }
+
+	  /* sum = prod v^bucket[v], as prod over v of the running product
+	     of the buckets from the top down to v */
+	  have_acc = have_sum = 0;
+	  for (v = ((mp_size_t) 1 << c) - 1; v > 0; v--)
+	    {
+	      if (full[v])
+		{
+		  if (have_acc)
+		    mulredc (acc, acc, bucket + v * n, n, mp, ip, tp);
+		  else
+		    MPN_COPY (acc, bucket + v * n, n);
+		  have_acc = 1;
+		}
+	      if (have_acc)
+		{
+		  if (have_sum)
+		    mulredc (sum, sum, acc, n, mp, ip, tp);
+		  else
+		    MPN_COPY (sum, acc, n);
+		  have_sum = 1;
+		}
+	    }
+
+	  if (have_sum)
+	    {
+	      if (have)
+		mulredc (rp, rp, sum, n, mp, ip, tp);
+	      else
+		MPN_COPY (rp, sum, n);
+	      have = 1;
+	    }
+	}
+    }
+  ASSERT (have);
+  TMP_FREE;
+}
+
+/* {rp,n} = prod bp[i]^ep[i] mod {mp,n}, for 0 <= i < k.
+
+   Each bp[i] is n limbs, and needn't be reduced mod m.  Each ep[i] is
+   en[i] limbs, normalized, and en[i] = 0 for a zero exponent is allowed.
+   mp must be odd and greater than 1, with mp[n-1] non-zero.  {rp,n} must
+   not overlap any of the inputs.  */
+void
+mpn_powm_multi (mp_ptr rp, mp_srcptr *bp, mp_srcptr *ep, const mp_size_t *en,
+		mp_size_t k, mp_srcptr mp, mp_size_t n)
+{
+  mp_ptr ip, tp, qp, bb;
+  mp_srcptr *bbp;
+  mp_size_t i;
+  TMP_DECL;
+
+  ASSERT (n >= 1);
+  ASSERT ((mp[0] & 1) != 0);
+  ASSERT (mp[n - 1] != 0);
+  ASSERT (n > 1 || mp[0] > 1);
+
+  for (i = 0; i < k; i++)
+    if (en[i] != 0)
+      break;
+  if (i == k)
+    {
+      MPN_ZERO (rp, n);
+      rp[0] = 1;
+      return;
+    }
+
+  TMP_MARK;
+  ip = TMP_ALLOC_LIMBS (n);
+  TMP_ALLOC_LIMBS_2 (tp, MAX (mpn_binvert_itch (n), 2 * n), qp, n + 1);
+  mpn_redc_inverse (ip, mp, n, tp);
+
+  /* The bases in REDC form, b B^n mod m.  */
+  bb = TMP_ALLOC_LIMBS (k * n);
+  bbp = TMP_ALLOC_TYPE (k, mp_srcptr);
+  for (i = 0; i < k; i++)
+    {
+      MPN_ZERO (tp, n);
+      MPN_COPY (tp + n, bp[i], n);
+      mpn_tdiv_qr (qp, bb + i * n, 0L, tp, 2 * n, mp, n);
+      bbp[i] = bb + i * n;
+    }
+
+  mpn_powm_multi_redc (rp, bbp, ep, en, k, mp, n, ip);
+
+  /* Convert out of REDC form */
+  MPN_COPY (tp, rp, n);
+  MPN_ZERO (tp + n, n);
+  mpn_redc (rp, tp, mp, n, ip);
+  if (mpn_cmp (rp, mp, n) >= 0)
+    mpn_sub_n (rp, rp, mp, n);
+
+  TMP_FREE;
+}
@@ -0,0 +1,101 @@
+/* mpn_redc_inverse, mpn_redc -- REDC of any size, picking redc_1, redc_2
+   or redc_n the same way as mpn_powm.
+
+   THE FUNCTIONS IN THIS FILE ARE INTERNAL WITH MUTABLE INTERFACES.  IT IS
+   ONLY SAFE TO REACH THEM THROUGH DOCUMENTED INTERFACES.  IN FACT, IT IS
+   ALMOST GUARANTEED THAT THEY WILL CHANGE OR DISAPPEAR IN A FUTURE GNU MP
+   RELEASE.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "gmp.h"
+#include "gmp-impl.h"
+
+
+#if HAVE_NATIVE_mpn_addmul_2 || HAVE_NATIVE_mpn_redc_2
+#define WANT_REDC_2 1
+#endif
+
+/* Set {ip,n} to the inverse of the odd {mp,n} in the form mpn_redc wants.
+   Only the low 1 or 2 limbs are used below REDC_2_TO_REDC_N_THRESHOLD (or
+   REDC_1_TO_REDC_N_THRESHOLD), but ip must have space for n.  Uses
+   mpn_binvert_itch(n) limbs of scratch at tp.  */
+void
+mpn_redc_inverse (mp_ptr ip, mp_srcptr mp, mp_size_t n, mp_ptr tp)
+{
+  ASSERT (n >= 1);
+  ASSERT ((mp[0] & 1) != 0);
+
+#if WANT_REDC_2
+  if (BELOW_THRESHOLD (n, REDC_1_TO_REDC_2_THRESHOLD))
+    {
+      binvert_limb (ip[0], mp[0]);
+      ip[0] = -ip[0];
+    }
+  else if (BELOW_THRESHOLD (n, REDC_2_TO_REDC_N_THRESHOLD))
+    {
+      mpn_binvert (ip, mp, 2, tp);
+      ip[0] = -ip[0]; ip[1] = ~ip[1];
+    }
+#else
+  if (BELOW_THRESHOLD (n, REDC_1_TO_REDC_N_THRESHOLD))
+    {
+      binvert_limb (ip[0], mp[0]);
+      ip[0] = -ip[0];
+    }
+#endif
+  else
+    mpn_binvert (ip, mp, n, tp);
+}
+
+/* Set {rp,n} to {up,2n} / B^n mod {mp,n}, clobbering up.  The result is
+   less than B^n but not necessarily less than mp, so it can go straight
+   back in as a factor of another product.  */
+void
+mpn_redc (mp_ptr rp, mp_ptr up, mp_srcptr mp, mp_size_t n, mp_srcptr ip)
+{
+  mp_limb_t cy;
+
+#if WANT_REDC_2
+  if (BELOW_THRESHOLD (n, REDC_1_TO_REDC_2_THRESHOLD))
+    cy = mpn_redc_1 (rp, up, mp, n, ip[0]);
+  else if (BELOW_THRESHOLD (n, REDC_2_TO_REDC_N_THRESHOLD))
+    cy = mpn_redc_2 (rp, up, mp, n, ip);
+#else
+  if (BELOW_THRESHOLD (n, REDC_1_TO_REDC_N_THRESHOLD))
+    cy = mpn_redc_1 (rp, up, mp, n, ip[0]);
+#endif
+  else
+    {
+      mpn_redc_n (rp, up, mp, n, ip);
+      return;
+    }
+  if (cy != 0)
+    mpn_sub_n (rp, rp, mp, n);
+}
@@ -32,6 +32,7 @@ see https://www.gnu.org/licenses/.  */
 
 #include "gmp.h"
 #include "gmp-impl.h"
+#include "longlong.h"
 
 #if 0
 /* Currently unused. Should be resurrected once mpn_cnd_neg is
@@ -43,6 +44,7 @@ mpn_cnd_neg_itch (mp_size_t n)
 }
 #endif
 
+#if GMP_NAIL_BITS != 0
 /* FIXME: Ought to return carry */
 static void
 mpn_cnd_neg (int cnd, mp_limb_t *rp, const mp_limb_t *ap, mp_size_t n,
@@ -51,6 +53,7 @@ mpn_cnd_neg (int cnd, mp_limb_t *rp, const mp_limb_t *ap, mp_size_t n,
   mpn_lshift (scratch, ap, n, 1);
   mpn_cnd_sub_n (cnd, rp, ap, scratch, n);
 }
+#endif
 
 static int
 mpn_sec_eq_ui (mp_srcptr ap, mp_size_t n, mp_limb_t b)
@@ -69,7 +72,165 @@ mpn_sec_eq_ui (mp_srcptr ap, mp_size_t n, mp_limb_t b)
 mp_size_t
 mpn_sec_invert_itch (mp_size_t n)
 {
+#if GMP_NAIL_BITS == 0
+  return 6*n + 8;
+#else
   return 4*n;
+#endif
+}
+
+#if GMP_NAIL_BITS == 0
+
+/* Bernstein and Yang's safegcd, "Fast constant-time gcd computation and
+   modular inversion", 2019.  With f odd and delta = 1 initially, a divstep
+   is
+
+     if (delta > 0 and g odd)
+       (delta, f, g) = (1 - delta, g, (g - f)/2)
+     else
+       (delta, f, g) = (1 + delta, f, (g + (g mod 2) f)/2)
+
+   and starting from f = m, g = a, after enough steps g = 0 and f is
+   +/-gcd(a,m).  How many steps are enough depends only on the sizes.
+
+   The steps are done DIVSTEPS at a time on single limbs, since the low
+   bits of f and g determine the next that many steps.  That gives a
+   matrix T with T (f, g) = 2^DIVSTEPS (f', g'), which is then applied to
+   the full f and g, as two's complement numbers of n+1 limbs, with
+   mpn_mul_1.
+
+   For the inverse, d and e are kept in [0,m) with f = d a and g = e a mod
+   m, so d = 0 and e = 1 to start.  T applies to them the same way, with a
+   multiple of m added to make the division by 2^DIVSTEPS exact.  At the
+   end f = +/-1 if a is invertible, and the inverse is +/-d.
+
+   Compared to the bit at a time binary algorithm below, that's about 1.4
+   times as many steps, but each is a few instructions on single limbs,
+   with only a handful of passes over n limbs for every DIVSTEPS steps.
+   There are no branches or memory accesses depending on the data.  */
+
+#define DIVSTEPS  (GMP_NUMB_BITS - 2)
+
+/* A bound on the divsteps needed with f and g below 2^d, from theorem
+   11.2 in the paper.  */
+#define SEC_DIVSTEPS_COUNT(d)						\
+  ((d) < 46 ? (49 * (d) + 80 + 16) / 17 : (49 * (d) + 57 + 16) / 17)
+
+/* DIVSTEPS divsteps on the low limbs of f and g, giving the transition
+   matrix in t[0..3] as two's complement limbs, and returning the new
+   delta.  */
+static mp_limb_t
+sec_divsteps (mp_limb_t delta, mp_limb_t f, mp_limb_t g, mp_limb_t t[4])
+{
+  mp_limb_t u, v, q, r, c1, c2, x, y, z;
+  int i;
+
+  u = 1; v = 0;
+  q = 0; r = 1;
+  for (i = 0; i < DIVSTEPS; i++)
+    {
+      ASSERT (f & 1);
+      /* c1 is delta > 0, c2 is g odd */
+      c1 = LIMB_HIGHBIT_TO_MASK (-delta);
+      c2 = -(g & 1);
+
+      /* add f, negated if delta > 0, to g if g is odd */
+      x = (f ^ c1) - c1;
+      y = (u ^ c1) - c1;
+      z = (v ^ c1) - c1;
+      g += x & c2;
+      q += y & c2;
+      r += z & c2;
+
+      /* and when both, f becomes the old g */
+      c1 &= c2;
+      delta = (delta ^ c1) - c1 + 1;
+      f += g & c1;
+      u += q & c1;
+      v += r & c1;
+
+      g >>= 1;
+      u <<= 1;
+      v <<= 1;
+    }
+  t[0] = u; t[1] = v;
+  t[2] = q; t[3] = r;
+  return delta;
+}
+
+/* {rp,n+1} = {xp,n} s mod B^(n+1), with x and s two's complement.  */
+static void
+sec_mul_s (mp_ptr rp, mp_srcptr xp, mp_size_t n, mp_limb_t s)
+{
+  rp[n] = mpn_mul_1 (rp, xp, n, s);
+  mpn_cnd_sub_n (s >> (GMP_LIMB_BITS - 1), rp + 1, rp + 1, xp, n);
+  rp[n] -= s & LIMB_HIGHBIT_TO_MASK (xp[n - 1]);
+}
+
+/* (f, g) = T (f, g) / 2^DIVSTEPS, for f and g of n limbs.  Uses 2n+2
+   limbs at tp.  */
+static void
+sec_matrix_fg (mp_ptr fp, mp_ptr gp, mp_size_t n, const mp_limb_t t[4],
+	       mp_ptr tp)
+{
+  mp_ptr t1 = tp;
+  mp_ptr t2 = tp + n + 1;
+
+  sec_mul_s (t1, fp, n, t[0]);
+  sec_mul_s (t2, gp, n, t[1]);
+  mpn_add_n (t1, t1, t2, n + 1);
+  sec_mul_s (t2, fp, n, t[2]);
+  mpn_rshift (t1, t1, n + 1, DIVSTEPS);
+  MPN_COPY (fp, t1, n);
+
+  sec_mul_s (t1, gp, n, t[3]);
+  mpn_add_n (t2, t2, t1, n + 1);
+  mpn_rshift (t2, t2, n + 1, DIVSTEPS);
+  MPN_COPY (gp, t2, n);
+}
+
+/* Set {xp,n+1} to {tp,n+2} / 2^DIVSTEPS mod m, in [0,m), adding a multiple
+   of m to make the division exact.  The quotient must be in (-m,2m).
+   Uses n limbs at sp.  */
+static void
+sec_reduce_de (mp_ptr xp, mp_ptr tp, mp_srcptr mp, mp_size_t n,
+	       mp_limb_t minv, mp_ptr sp)
+{
+  mp_limb_t md, cy, hi;
+
+  md = (-(tp[0] * minv)) & ((CNST_LIMB (1) << DIVSTEPS) - 1);
+  cy = mpn_addmul_1 (tp, mp, n, md);
+  add_ssaaaa (tp[n + 1], tp[n], tp[n + 1], tp[n], CNST_LIMB (0), cy);
+  mpn_rshift (tp, tp, n + 2, DIVSTEPS);
+  MPN_COPY (xp, tp, n + 1);
+
+  /* add m if negative, then subtract it if that's too much */
+  cy = mpn_cnd_add_n (xp[n] >> (GMP_LIMB_BITS - 1), xp, xp, mp, n);
+  xp[n] += cy;
+  cy = mpn_sub_n (sp, xp, mp, n);
+  hi = xp[n] - cy;
+  mpn_cnd_sub_n (1 ^ (hi >> (GMP_LIMB_BITS - 1)), xp, xp, mp, n);
+  xp[n] = 0;
+}
+
+/* (d, e) = T (d, e) / 2^DIVSTEPS mod m, for d and e in [0,m] as n+1 limbs.
+   Uses 2n+4 limbs at tp and n at sp.  */
+static void
+sec_matrix_de (mp_ptr dp, mp_ptr ep, mp_srcptr mp, mp_size_t n,
+	       mp_limb_t minv, const mp_limb_t t[4], mp_ptr tp, mp_ptr sp)
+{
+  mp_ptr t1 = tp;
+  mp_ptr t2 = tp + n + 2;
+
+  sec_mul_s (t1, dp, n + 1, t[0]);
+  sec_mul_s (t2, ep, n + 1, t[1]);
+  mpn_add_n (t1, t1, t2, n + 2);
+  sec_mul_s (t2, dp, n + 1, t[2]);
+  sec_reduce_de (dp, t1, mp, n, minv, sp);
+
+  sec_mul_s (t1, ep, n + 1, t[3]);
+  mpn_add_n (t2, t2, t1, n + 2);
+  sec_reduce_de (ep, t2, mp, n, minv, sp);
 }
 
 /* Compute V <-- A^{-1} (mod M), in data-independent time. M must be
@@ -79,6 +240,73 @@ mpn_sec_invert_itch (mp_size_t n)
    2*n*GMP_NUMB_BITS, but if A or M are known to be smaller, e.g., if
    M = 2^521 - 1 and A < M, bit_size can be any bound on the sum of
    the bit sizes of A and M. */
+int
+mpn_sec_invert (mp_ptr vp, mp_ptr ap, mp_srcptr mp,
+		mp_size_t n, mp_bitcnt_t bit_size,
+		mp_ptr scratch)
+{
+  mp_limb_t t[4];
+  mp_limb_t delta, minv, cy, m1;
+  mp_bitcnt_t steps;
+  mp_size_t i;
+  int one, neg;
+
+  ASSERT (n > 0);
+  ASSERT (bit_size > 0);
+  ASSERT (mp[0] & 1);
+  ASSERT (! MPN_OVERLAP_P (ap, n, vp, n));
+#define fp (scratch)
+#define gp (scratch + (n+1))
+#define dp (scratch + 2*(n+1))
+#define ep (scratch + 3*(n+1))
+#define tp (scratch + 4*(n+1))
+
+  MPN_COPY (fp, mp, n);
+  fp[n] = 0;
+  MPN_COPY (gp, ap, n);
+  gp[n] = 0;
+  MPN_ZERO (dp, n + 1);
+  ep[0] = 1;
+  MPN_ZERO (ep + 1, n);
+  binvert_limb (minv, mp[0]);
+
+  /* a and m are both below 2^bit_size, and below B^n.  */
+  steps = SEC_DIVSTEPS_COUNT (MIN (bit_size, n * GMP_NUMB_BITS));
+
+  delta = 1;
+  for (; steps > 0; steps -= MIN (steps, DIVSTEPS))
+    {
+      delta = sec_divsteps (delta, fp[0], gp[0], t);
+      sec_matrix_fg (fp, gp, n + 1, t, tp);
+      sec_matrix_de (dp, ep, mp, n, minv, t, tp, vp);
+    }
+  /* Should be all zeros, but check only extreme limbs */
+  ASSERT ((gp[0] | gp[n]) == 0);
+
+  /* Invertible if f = 1 or f = -1, and the inverse is then d or m - d,
+     the latter reduced again in case m = 1.  */
+  one = mpn_sec_eq_ui (fp, n + 1, 1);
+  m1 = 0;
+  for (i = 0; i <= n; i++)
+    m1 |= ~fp[i];
+  neg = m1 == 0;
+
+  MPN_COPY (vp, dp, n);
+  mpn_sub_n (tp, mp, dp, n);
+  mpn_cnd_swap (neg, vp, tp, n);
+  cy = mpn_sub_n (tp, vp, mp, n);
+  mpn_cnd_sub_n (cy ^ 1, vp, vp, mp, n);
+
+  return one | neg;
+#undef fp
+#undef gp
+#undef dp
+#undef ep
+#undef tp
+}
+
+#else /* GMP_NAIL_BITS != 0 */
+
 int
 mpn_sec_invert (mp_ptr vp, mp_ptr ap, mp_srcptr mp,
 		mp_size_t n, mp_bitcnt_t bit_size,
@@ -176,3 +404,5 @@ mpn_sec_invert (mp_ptr vp, mp_ptr ap, mp_srcptr mp,
 #undef up
 #undef m1hp
 }
+
+#endif /* GMP_NAIL_BITS != 0 */
@@ -90,10 +90,14 @@ mpn_sqr (mp_ptr p, mp_srcptr a, mp_size_t n)
       mpn_toom8_sqr (p, a, n, ws);
       TMP_FREE;
     }
-  else
+  else if (BELOW_THRESHOLD (n, SQR_NTT_THRESHOLD))
     {
       /* The current FFT code allocates its own space.  That should probably
 	 change.  */
       mpn_fft_mul (p, a, n, a, n);
     }
+  else
+    {
+      mpn_mul_ntt (p, a, n, a, n);
+    }
 }
@@ -84,6 +84,15 @@ see https://www.gnu.org/licenses/.  */
       mpn_toom44_mul (p, a, n, b, n, ws);				\
   } while (0)
 
+/* The same, or with par, queue it for mpn_toom_mul_par.  */
+#define TOOM44_MUL_N_PAR(i, p, a, b, n, ws)				\
+  do {									\
+    if (par)								\
+      TOOM_MUL_ITEM (it[i], p, a, n, b, n);				\
+    else								\
+      TOOM44_MUL_N_REC (p, a, b, n, ws);				\
+  } while (0)
+
 /* Use of scratch space. In the product area, we store
 
       ___________________
@@ -105,6 +114,13 @@ see https://www.gnu.org/licenses/.  */
      S(an) <= 4 (2*ceil(an/4) + 1) + 1 + S(ceil(an/4) + 1)
 
    which should give S(n) = 8 n/3 + c log(n) for some constant c.
+
+   Above MUL_TOOM_PARALLEL_THRESHOLD, with threads, the seven products are
+   done at once by mpn_toom_mul_par.  Each evaluation point then gets its
+   own space for its factors, and vm2, vm1, v2 and vh their own space of
+   2n+2 limbs, so that nothing depends on the order the products finish
+   in.  The scratch area is then only used by the evaluations and the
+   interpolation.
 */
 
 void
@@ -116,6 +132,11 @@ mpn_toom44_mul (mp_ptr pp,
   mp_size_t n, s, t;
   mp_limb_t cy;
   enum toom7_flags flags;
+  mp_ptr v2, vm2, vh, vm1;
+  mp_ptr apx, amx, bmx, bpx;
+  struct toom_mul_item it[7];
+  int par;
+  TMP_DECL;
 
 #define a0  ap
 #define a1  (ap + n)
@@ -137,35 +158,58 @@ mpn_toom44_mul (mp_ptr pp,
   ASSERT (0 < t && t <= n);
   ASSERT (s >= t);
 
-  /* NOTE: The multiplications to v2, vm2, vh and vm1 overwrites the
-   * following limb, so these must be computed in order, and we need a
-   * one limb gap to tp. */
 #define v0    pp				/* 2n */
 #define v1    (pp + 2 * n)			/* 2n+1 */
 #define vinf  (pp + 6 * n)			/* s+t */
-#define v2    scratch				/* 2n+1 */
-#define vm2   (scratch + 2 * n + 1)		/* 2n+1 */
-#define vh    (scratch + 4 * n + 2)		/* 2n+1 */
-#define vm1   (scratch + 6 * n + 3)		/* 2n+1 */
 #define tp (scratch + 8*n + 5)
 
-  /* apx and bpx must not overlap with v1 */
-#define apx   pp				/* n+1 */
-#define amx   (pp + n + 1)			/* n+1 */
-#define bmx   (pp + 2*n + 2)			/* n+1 */
-#define bpx   (pp + 4*n + 2)			/* n+1 */
-
   /* Total scratch need: 8*n + 5 + scratch for recursive calls. This
      gives roughly 32 n/3 + log term. */
 
+  par = an >= MUL_TOOM_PARALLEL_THRESHOLD && __gmp_parallel_threads () > 1;
+  TMP_MARK;
+  if (par)
+    {
+      v2 = TMP_ALLOC_LIMBS (18 * n + 18);
+      vm2 = v2 + 2 * n + 2;
+      vh = vm2 + 2 * n + 2;
+      vm1 = vh + 2 * n + 2;
+      apx = vm1 + 2 * n + 2;
+      amx = apx + n + 1;
+      bmx = amx + n + 1;
+      bpx = bmx + n + 1;
+    }
+  else
+    {
+      /* NOTE: The multiplications to v2, vm2, vh and vm1 overwrites the
+       * following limb, so these must be computed in order, and we need a
+       * one limb gap to tp. */
+      v2 = scratch;				/* 2n+1 */
+      vm2 = scratch + 2 * n + 1;		/* 2n+1 */
+      vh = scratch + 4 * n + 2;			/* 2n+1 */
+      vm1 = scratch + 6 * n + 3;		/* 2n+1 */
+
+      /* apx and bpx must not overlap with v1 */
+      apx = pp;					/* n+1 */
+      amx = pp + n + 1;				/* n+1 */
+      bmx = pp + 2*n + 2;			/* n+1 */
+      bpx = pp + 4*n + 2;			/* n+1 */
+    }
+
   /* Compute apx = a0 + 2 a1 + 4 a2 + 8 a3 and amx = a0 - 2 a1 + 4 a2 - 8 a3.  */
   flags = (enum toom7_flags) (toom7_w1_neg & mpn_toom_eval_dgr3_pm2 (apx, amx, ap, n, s, tp));
 
   /* Compute bpx = b0 + 2 b1 + 4 b2 + 8 b3 and bmx = b0 - 2 b1 + 4 b2 - 8 b3.  */
   flags = (enum toom7_flags) (flags ^ (toom7_w1_neg & mpn_toom_eval_dgr3_pm2 (bpx, bmx, bp, n, t, tp)));
 
-  TOOM44_MUL_N_REC (v2, apx, bpx, n + 1, tp);	/* v2,  2n+1 limbs */
-  TOOM44_MUL_N_REC (vm2, amx, bmx, n + 1, tp);	/* vm2,  2n+1 limbs */
+  TOOM44_MUL_N_PAR (0, v2, apx, bpx, n + 1, tp);	/* v2,  2n+1 limbs */
+  TOOM44_MUL_N_PAR (1, vm2, amx, bmx, n + 1, tp);	/* vm2,  2n+1 limbs */
+
+  if (par)
+    {
+      apx = bpx + n + 1;
+      bpx = apx + n + 1;
+    }
 
   /* Compute apx = 8 a0 + 4 a1 + 2 a2 + a3 = (((2*a0 + a1) * 2 + a2) * 2 + a3 */
 #if HAVE_NATIVE_mpn_addlsh1_n
@@ -214,7 +258,15 @@ mpn_toom44_mul (mp_ptr pp,
   ASSERT (apx[n] < 15);
   ASSERT (bpx[n] < 15);
 
-  TOOM44_MUL_N_REC (vh, apx, bpx, n + 1, tp);	/* vh,  2n+1 limbs */
+  TOOM44_MUL_N_PAR (2, vh, apx, bpx, n + 1, tp);	/* vh,  2n+1 limbs */
+
+  if (par)
+    {
+      amx = bpx + n + 1;
+      bmx = amx + n + 1;
+      apx = bmx + n + 1;
+      bpx = apx + n + 1;
+    }
 
   /* Compute apx = a0 + a1 + a2 + a3 and amx = a0 - a1 + a2 - a3.  */
   flags = (enum toom7_flags) (flags | (toom7_w3_neg & mpn_toom_eval_dgr3_pm1 (apx, amx, ap, n, s, tp)));
@@ -222,15 +274,21 @@ mpn_toom44_mul (mp_ptr pp,
   /* Compute bpx = b0 + b1 + b2 + b3 and bmx = b0 - b1 + b2 - b3.  */
   flags = (enum toom7_flags) (flags ^ (toom7_w3_neg & mpn_toom_eval_dgr3_pm1 (bpx, bmx, bp, n, t, tp)));
 
-  TOOM44_MUL_N_REC (vm1, amx, bmx, n + 1, tp);	/* vm1,  2n+1 limbs */
+  TOOM44_MUL_N_PAR (3, vm1, amx, bmx, n + 1, tp);	/* vm1,  2n+1 limbs */
   /* Clobbers amx, bmx. */
-  TOOM44_MUL_N_REC (v1, apx, bpx, n + 1, tp);	/* v1,  2n+1 limbs */
+  TOOM44_MUL_N_PAR (4, v1, apx, bpx, n + 1, tp);	/* v1,  2n+1 limbs */
 
-  TOOM44_MUL_N_REC (v0, a0, b0, n, tp);
-  if (s > t)
+  TOOM44_MUL_N_PAR (5, v0, a0, b0, n, tp);
+  if (par)
+    {
+      TOOM_MUL_ITEM (it[6], vinf, a3, s, b3, t);
+      mpn_toom_mul_par (it, 7);
+    }
+  else if (s > t)
     mpn_mul (vinf, a3, s, b3, t);
   else
     TOOM44_MUL_N_REC (vinf, a3, b3, s, tp);	/* vinf, s+t limbs */
 
   mpn_toom_interpolate_7pts (pp, n, flags, vm2, vm1, v2, vh, s + t, tp);
+  TMP_FREE;
 }
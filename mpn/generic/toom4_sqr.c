@@ -81,6 +81,20 @@ see https://www.gnu.org/licenses/.  */
       mpn_toom4_sqr (p, a, n, ws);					\
   } while (0)
 
+/* The same, or with par, queue it for mpn_toom_mul_par.  */
+#define TOOM4_SQR_PAR(i, p, a, n, ws)					\
+  do {									\
+    if (par)								\
+      TOOM_MUL_ITEM (it[i], p, a, n, a, n);				\
+    else								\
+      TOOM4_SQR_REC (p, a, n, ws);					\
+  } while (0)
+
+/* Above SQR_TOOM_PARALLEL_THRESHOLD, with threads, the seven squares are
+   done at once by mpn_toom_mul_par, as in toom44_mul.c.  Each evaluation
+   then gets its own space, and vm2, vm1, v2 and vh their own space of 2n+2
+   limbs.  mpn_mul sees the equal operands and squares.  */
+
 void
 mpn_toom4_sqr (mp_ptr pp,
 	       mp_srcptr ap, mp_size_t an,
@@ -88,6 +102,11 @@ mpn_toom4_sqr (mp_ptr pp,
 {
   mp_size_t n, s;
   mp_limb_t cy;
+  mp_ptr v2, vm2, vh, vm1;
+  mp_ptr apx, amx;
+  struct toom_mul_item it[7];
+  int par;
+  TMP_DECL;
 
 #define a0  ap
 #define a1  (ap + n)
@@ -100,30 +119,48 @@ mpn_toom4_sqr (mp_ptr pp,
 
   ASSERT (0 < s && s <= n);
 
-  /* NOTE: The multiplications to v2, vm2, vh and vm1 overwrites the
-   * following limb, so these must be computed in order, and we need a
-   * one limb gap to tp. */
 #define v0    pp				/* 2n */
 #define v1    (pp + 2 * n)			/* 2n+1 */
 #define vinf  (pp + 6 * n)			/* s+t */
-#define v2    scratch				/* 2n+1 */
-#define vm2   (scratch + 2 * n + 1)		/* 2n+1 */
-#define vh    (scratch + 4 * n + 2)		/* 2n+1 */
-#define vm1   (scratch + 6 * n + 3)		/* 2n+1 */
 #define tp (scratch + 8*n + 5)
 
-  /* No overlap with v1 */
-#define apx   pp				/* n+1 */
-#define amx   (pp + 4*n + 2)			/* n+1 */
-
   /* Total scratch need: 8*n + 5 + scratch for recursive calls. This
      gives roughly 32 n/3 + log term. */
 
+  par = an >= SQR_TOOM_PARALLEL_THRESHOLD && __gmp_parallel_threads () > 1;
+  TMP_MARK;
+  if (par)
+    {
+      v2 = TMP_ALLOC_LIMBS (13 * n + 13);
+      vm2 = v2 + 2 * n + 2;
+      vh = vm2 + 2 * n + 2;
+      vm1 = vh + 2 * n + 2;
+      apx = vm1 + 2 * n + 2;
+      amx = apx + n + 1;
+    }
+  else
+    {
+      /* NOTE: The multiplications to v2, vm2, vh and vm1 overwrites the
+       * following limb, so these must be computed in order, and we need a
+       * one limb gap to tp. */
+      v2 = scratch;				/* 2n+1 */
+      vm2 = scratch + 2 * n + 1;		/* 2n+1 */
+      vh = scratch + 4 * n + 2;			/* 2n+1 */
+      vm1 = scratch + 6 * n + 3;		/* 2n+1 */
+
+      /* No overlap with v1 */
+      apx = pp;					/* n+1 */
+      amx = pp + 4*n + 2;			/* n+1 */
+    }
+
   /* Compute apx = a0 + 2 a1 + 4 a2 + 8 a3 and amx = a0 - 2 a1 + 4 a2 - 8 a3.  */
   mpn_toom_eval_dgr3_pm2 (apx, amx, ap, n, s, tp);
 
-  TOOM4_SQR_REC (v2, apx, n + 1, tp);	/* v2,  2n+1 limbs */
-  TOOM4_SQR_REC (vm2, amx, n + 1, tp);	/* vm2,  2n+1 limbs */
+  TOOM4_SQR_PAR (0, v2, apx, n + 1, tp);	/* v2,  2n+1 limbs */
+  TOOM4_SQR_PAR (1, vm2, amx, n + 1, tp);	/* vm2,  2n+1 limbs */
+
+  if (par)
+    apx = amx + n + 1;
 
   /* Compute apx = 8 a0 + 4 a1 + 2 a2 + a3 = (((2*a0 + a1) * 2 + a2) * 2 + a3 */
 #if HAVE_NATIVE_mpn_addlsh1_n
@@ -149,16 +186,25 @@ mpn_toom4_sqr (mp_ptr pp,
 
   ASSERT (apx[n] < 15);
 
-  TOOM4_SQR_REC (vh, apx, n + 1, tp);	/* vh,  2n+1 limbs */
+  TOOM4_SQR_PAR (2, vh, apx, n + 1, tp);	/* vh,  2n+1 limbs */
+
+  if (par)
+    {
+      amx = apx + n + 1;
+      apx = amx + n + 1;
+    }
 
   /* Compute apx = a0 + a1 + a2 + a3 and amx = a0 - a1 + a2 - a3.  */
   mpn_toom_eval_dgr3_pm1 (apx, amx, ap, n, s, tp);
 
-  TOOM4_SQR_REC (v1, apx, n + 1, tp);	/* v1,  2n+1 limbs */
-  TOOM4_SQR_REC (vm1, amx, n + 1, tp);	/* vm1,  2n+1 limbs */
+  TOOM4_SQR_PAR (3, v1, apx, n + 1, tp);	/* v1,  2n+1 limbs */
+  TOOM4_SQR_PAR (4, vm1, amx, n + 1, tp);	/* vm1,  2n+1 limbs */
 
-  TOOM4_SQR_REC (v0, a0, n, tp);
-  TOOM4_SQR_REC (vinf, a3, s, tp);	/* vinf, 2s limbs */
+  TOOM4_SQR_PAR (5, v0, a0, n, tp);
+  TOOM4_SQR_PAR (6, vinf, a3, s, tp);	/* vinf, 2s limbs */
+  if (par)
+    mpn_toom_mul_par (it, 7);
 
   mpn_toom_interpolate_7pts (pp, n, (enum toom7_flags) 0, vm2, vm1, v2, vh, 2*s, tp);
+  TMP_FREE;
 }
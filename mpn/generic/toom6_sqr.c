@@ -99,6 +99,7 @@ void
 mpn_toom6_sqr  (mp_ptr pp, mp_srcptr ap, mp_size_t an, mp_ptr scratch)
 {
   mp_size_t n, s;
+  TMP_DECL;
 
   /***************************** decomposition *******************************/
 
@@ -125,6 +126,49 @@ mpn_toom6_sqr  (mp_ptr pp, mp_srcptr ap, mp_size_t an, mp_ptr scratch)
 /*   if (scratch== NULL) */
 /*     scratch = TMP_SALLOC_LIMBS (12 * n + 6); */
 
+  if (an >= SQR_TOOM_PARALLEL_THRESHOLD && __gmp_parallel_threads () > 1)
+    {
+      /* The same evaluations, but each into space of its own, and the
+	 squares of A(-x) too, so that all eleven squares can be done at
+	 once, as in toom6h_mul.c.  The rest is as below.  */
+      struct toom_mul_item it[11];
+      mp_ptr evs, pms, rp[5];
+      int i;
+
+      TMP_MARK;
+      evs = TMP_ALLOC_LIMBS (20 * n + 20);
+      pms = evs + 10 * n + 10;
+#define ev(i, j)  (evs + (2 * (i) + (j)) * (n + 1))	/* n+1 */
+#define pm(i)     (pms + (i) * (2 * n + 2))		/* 2n+2 */
+
+      mpn_toom_eval_pm2rexp (ev(0,1), ev(0,0), 5, ap, n, s, 1, pp);
+      mpn_toom_eval_pm1 (ev(1,1), ev(1,0), 5, ap, n, s,    pp);
+      mpn_toom_eval_pm2exp (ev(2,1), ev(2,0), 5, ap, n, s, 2, pp);
+      mpn_toom_eval_pm2rexp (ev(3,1), ev(3,0), 5, ap, n, s, 2, pp);
+      mpn_toom_eval_pm2 (ev(4,1), ev(4,0), 5, ap, n, s, pp);
+
+      rp[0] = r5; rp[1] = r3; rp[2] = r1; rp[3] = r4; rp[4] = r2;
+      for (i = 0; i < 5; i++)
+	{
+	  TOOM_MUL_ITEM (it[2 * i], pm(i), ev(i,0), n + 1, ev(i,0), n + 1);
+	  TOOM_MUL_ITEM (it[2 * i + 1], rp[i], ev(i,1), n + 1, ev(i,1), n + 1);
+	}
+      TOOM_MUL_ITEM (it[10], pp, ap, n, ap, n);
+      mpn_toom_mul_par (it, 11);
+
+      mpn_toom_couple_handling (r5, 2 * n + 1, pm(0), 0, n, 1, 0);
+      mpn_toom_couple_handling (r3, 2 * n + 1, pm(1), 0, n, 0, 0);
+      mpn_toom_couple_handling (r1, 2 * n + 1, pm(2), 0, n, 2, 4);
+      mpn_toom_couple_handling (r4, 2 * n + 1, pm(3), 0, n, 2, 0);
+      mpn_toom_couple_handling (r2, 2 * n + 1, pm(4), 0, n, 1, 2);
+#undef ev
+#undef pm
+
+      mpn_toom_interpolate_12pts (pp, r1, r3, r5, n, 2 * s, 0, wse);
+      TMP_FREE;
+      return;
+    }
+
   /********************** evaluation and recursive calls *********************/
   /* $\pm1/2$ */
   mpn_toom_eval_pm2rexp (v2, v0, 5, ap, n, s, 1, pp);
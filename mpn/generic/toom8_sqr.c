@@ -125,6 +125,7 @@ void
 mpn_toom8_sqr  (mp_ptr pp, mp_srcptr ap, mp_size_t an, mp_ptr scratch)
 {
   mp_size_t n, s;
+  TMP_DECL;
 
   /***************************** decomposition *******************************/
 
@@ -154,6 +155,54 @@ mpn_toom8_sqr  (mp_ptr pp, mp_srcptr ap, mp_size_t an, mp_ptr scratch)
 /*   if (scratch == NULL) */
 /*     scratch = TMP_SALLOC_LIMBS (30 * n + 6); */
 
+  if (an >= SQR_TOOM_PARALLEL_THRESHOLD && __gmp_parallel_threads () > 1)
+    {
+      /* The same evaluations, but each into space of its own, and the
+	 squares of A(-x) too, so that all fifteen squares can be done at
+	 once, as in toom8h_mul.c.  The rest is as below.  */
+      struct toom_mul_item it[15];
+      mp_ptr evs, pms, rp[7];
+      int i;
+
+      TMP_MARK;
+      evs = TMP_ALLOC_LIMBS (28 * n + 28);
+      pms = evs + 14 * n + 14;
+#define ev(i, j)  (evs + (2 * (i) + (j)) * (n + 1))	/* n+1 */
+#define pm(i)     (pms + (i) * (2 * n + 2))		/* 2n+2 */
+
+      mpn_toom_eval_pm2rexp (ev(0,1), ev(0,0), 7, ap, n, s, 3, pp);
+      mpn_toom_eval_pm2rexp (ev(1,1), ev(1,0), 7, ap, n, s, 2, pp);
+      mpn_toom_eval_pm2 (ev(2,1), ev(2,0), 7, ap, n, s, pp);
+      mpn_toom_eval_pm2exp (ev(3,1), ev(3,0), 7, ap, n, s, 3, pp);
+      mpn_toom_eval_pm2rexp (ev(4,1), ev(4,0), 7, ap, n, s, 1, pp);
+      mpn_toom_eval_pm1 (ev(5,1), ev(5,0), 7, ap, n, s,    pp);
+      mpn_toom_eval_pm2exp (ev(6,1), ev(6,0), 7, ap, n, s, 2, pp);
+
+      rp[0] = r7; rp[1] = r5; rp[2] = r3; rp[3] = r1;
+      rp[4] = r6; rp[5] = r4; rp[6] = r2;
+      for (i = 0; i < 7; i++)
+	{
+	  TOOM_MUL_ITEM (it[2 * i], pm(i), ev(i,0), n + 1, ev(i,0), n + 1);
+	  TOOM_MUL_ITEM (it[2 * i + 1], rp[i], ev(i,1), n + 1, ev(i,1), n + 1);
+	}
+      TOOM_MUL_ITEM (it[14], pp, ap, n, ap, n);
+      mpn_toom_mul_par (it, 15);
+
+      mpn_toom_couple_handling (r7, 2 * n + 1 + BIT_CORRECTION, pm(0), 0, n, 3, 0);
+      mpn_toom_couple_handling (r5, 2 * n + 1, pm(1), 0, n, 2, 0);
+      mpn_toom_couple_handling (r3, 2 * n + 1, pm(2), 0, n, 1, 2);
+      mpn_toom_couple_handling (r1, 2 * n + 1 + BIT_CORRECTION, pm(3), 0, n, 3, 6);
+      mpn_toom_couple_handling (r6, 2 * n + 1, pm(4), 0, n, 1, 0);
+      mpn_toom_couple_handling (r4, 2 * n + 1, pm(5), 0, n, 0, 0);
+      mpn_toom_couple_handling (r2, 2 * n + 1, pm(6), 0, n, 2, 4);
+#undef ev
+#undef pm
+
+      mpn_toom_interpolate_16pts (pp, r1, r3, r5, r7, n, 2 * s, 0, wse);
+      TMP_FREE;
+      return;
+    }
+
   /********************** evaluation and recursive calls *********************/
   /* $\pm1/8$ */
   mpn_toom_eval_pm2rexp (v2, v0, 7, ap, n, s, 3, pp);
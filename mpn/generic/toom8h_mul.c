@@ -121,6 +121,7 @@ mpn_toom8h_mul   (mp_ptr pp,
   mp_size_t n, s, t;
   int p, q, half;
   int sign;
+  TMP_DECL;
 
   /***************************** decomposition *******************************/
 
@@ -213,6 +214,66 @@ mpn_toom8h_mul   (mp_ptr pp,
   ASSERT (15 * n + 6 <= mpn_toom8h_mul_itch (an, bn));
   ASSERT (15 * n + 6 <= mpn_toom8_sqr_itch (n * 8));
 
+  if (an >= MUL_TOOM_PARALLEL_THRESHOLD && __gmp_parallel_threads () > 1)
+    {
+      /* The same evaluations, but each into space of its own, and the
+	 products for A(-x)*B(-x) too, so that all fifteen or sixteen
+	 products can be done at once.  The rest is as below.  */
+      struct toom_mul_item it[16];
+      mp_ptr evs, pms, rp[7];
+      int sg[7], i;
+
+      TMP_MARK;
+      evs = TMP_ALLOC_LIMBS (42 * n + 42);
+      pms = evs + 28 * n + 28;
+#define ev(i, j)  (evs + (4 * (i) + (j)) * (n + 1))	/* n+1 */
+#define pm(i)     (pms + (i) * (2 * n + 2))		/* 2n+2 */
+
+      sg[0] = mpn_toom_eval_pm2rexp (ev(0,2), ev(0,0), p, ap, n, s, 3, pp) ^
+	      mpn_toom_eval_pm2rexp (ev(0,3), ev(0,1), q, bp, n, t, 3, pp);
+      sg[1] = mpn_toom_eval_pm2rexp (ev(1,2), ev(1,0), p, ap, n, s, 2, pp) ^
+	      mpn_toom_eval_pm2rexp (ev(1,3), ev(1,1), q, bp, n, t, 2, pp);
+      sg[2] = mpn_toom_eval_pm2 (ev(2,2), ev(2,0), p, ap, n, s, pp) ^
+	      mpn_toom_eval_pm2 (ev(2,3), ev(2,1), q, bp, n, t, pp);
+      sg[3] = mpn_toom_eval_pm2exp (ev(3,2), ev(3,0), p, ap, n, s, 3, pp) ^
+	      mpn_toom_eval_pm2exp (ev(3,3), ev(3,1), q, bp, n, t, 3, pp);
+      sg[4] = mpn_toom_eval_pm2rexp (ev(4,2), ev(4,0), p, ap, n, s, 1, pp) ^
+	      mpn_toom_eval_pm2rexp (ev(4,3), ev(4,1), q, bp, n, t, 1, pp);
+      sg[5] = mpn_toom_eval_pm1 (ev(5,2), ev(5,0), p, ap, n, s,    pp);
+      if (GMP_NUMB_BITS > 12*3 && UNLIKELY (q == 3))
+	sg[5] ^= mpn_toom_eval_dgr3_pm1 (ev(5,3), ev(5,1), bp, n, t,    pp);
+      else
+	sg[5] ^= mpn_toom_eval_pm1 (ev(5,3), ev(5,1), q, bp, n, t,    pp);
+      sg[6] = mpn_toom_eval_pm2exp (ev(6,2), ev(6,0), p, ap, n, s, 2, pp) ^
+	      mpn_toom_eval_pm2exp (ev(6,3), ev(6,1), q, bp, n, t, 2, pp);
+
+      rp[0] = r7; rp[1] = r5; rp[2] = r3; rp[3] = r1;
+      rp[4] = r6; rp[5] = r4; rp[6] = r2;
+      for (i = 0; i < 7; i++)
+	{
+	  TOOM_MUL_ITEM (it[2 * i], pm(i), ev(i,0), n + 1, ev(i,1), n + 1);
+	  TOOM_MUL_ITEM (it[2 * i + 1], rp[i], ev(i,2), n + 1, ev(i,3), n + 1);
+	}
+      TOOM_MUL_ITEM (it[14], pp, ap, n, bp, n);
+      if (half)
+	TOOM_MUL_ITEM (it[15], r0, ap + p * n, s, bp + q * n, t);
+      mpn_toom_mul_par (it, 15 + (half != 0));
+
+      mpn_toom_couple_handling (r7, 2 * n + 1 + BIT_CORRECTION, pm(0), sg[0], n, 3*(1+half), 3*(half));
+      mpn_toom_couple_handling (r5, 2 * n + 1, pm(1), sg[1], n, 2*(1+half), 2*(half));
+      mpn_toom_couple_handling (r3, 2 * n + 1, pm(2), sg[2], n, 1, 2);
+      mpn_toom_couple_handling (r1, 2 * n + 1 + BIT_CORRECTION, pm(3), sg[3], n, 3, 6);
+      mpn_toom_couple_handling (r6, 2 * n + 1, pm(4), sg[4], n, 1+half, half);
+      mpn_toom_couple_handling (r4, 2 * n + 1, pm(5), sg[5], n, 0, 0);
+      mpn_toom_couple_handling (r2, 2 * n + 1, pm(6), sg[6], n, 2, 4);
+#undef ev
+#undef pm
+
+      mpn_toom_interpolate_16pts (pp, r1, r3, r5, r7, n, s+t, half, wsi);
+      TMP_FREE;
+      return;
+    }
+
   /********************** evaluation and recursive calls *********************/
 
   /* $\pm1/8$ */
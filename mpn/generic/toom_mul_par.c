@@ -0,0 +1,61 @@
+/* mpn_toom_mul_par -- the pointwise products of a Toom multiplication, over
+   threads.
+
+   THE FUNCTION IN THIS FILE IS INTERNAL WITH A MUTABLE INTERFACE.  IT IS ONLY
+   SAFE TO REACH IT THROUGH DOCUMENTED INTERFACES.  IN FACT, IT IS ALMOST
+   GUARANTEED THAT IT WILL CHANGE OR DISAPPEAR IN A FUTURE GNU MP RELEASE.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "gmp.h"
+#include "gmp-impl.h"
+
+
+static void
+mpn_toom_mul_item (void *arg, mp_size_t i)
+{
+  struct toom_mul_item *it = (struct toom_mul_item *) arg + i;
+
+  if (it->an >= it->bn)
+    mpn_mul (it->p, it->a, it->an, it->b, it->bn);
+  else
+    mpn_mul (it->p, it->b, it->bn, it->a, it->an);
+}
+
+/* Do the products {it[i].p, an+bn} <- {it[i].a, an} * {it[i].b, bn} for
+   0 <= i < n, each through mpn_mul with its own scratch, spread over the
+   threads.  The products must not overlap each other or any of the
+   inputs; the Toom callers keep their usual product layout only where
+   that's already so, and otherwise put evaluations and products in
+   separate space for this.  */
+void
+mpn_toom_mul_par (struct toom_mul_item *it, int n)
+{
+  __gmp_parallel_run (mpn_toom_mul_item, it, n);
+}
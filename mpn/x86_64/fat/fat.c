@@ -48,6 +48,7 @@ see https://www.gnu.org/licenses/.  */
 
 /* fat_entry.asm */
 long __gmpn_cpuid (char [12], int);
+long __gmpn_xgetbv (int);
 
 
 #if WANT_FAKE_CPUID
@@ -56,6 +57,7 @@ long __gmpn_cpuid (char [12], int);
    as per config.guess/config.sub.  */
 
 #define __gmpn_cpuid            fake_cpuid
+#define __gmpn_xgetbv           fake_xgetbv
 
 #define MAKE_FMS(family, model)						\
   ((((family) & 0xf) << 8) + (((family) & 0xff0) << 20)			\
@@ -82,6 +84,8 @@ static struct {
   { "bwl",        "GenuineIntel", MAKE_FMS (6, 0x3d) },
   { "skylake",    "GenuineIntel", MAKE_FMS (6, 0x5e) },
   { "sky",        "GenuineIntel", MAKE_FMS (6, 0x5e) },
+  { "icelake",    "GenuineIntel", MAKE_FMS (6, 0x6a) },
+  { "ice",        "GenuineIntel", MAKE_FMS (6, 0x6a) },
   { "pentium4",   "GenuineIntel", MAKE_FMS (15, 3) },
 
   { "k8",         "AuthenticAMD", MAKE_FMS (15, 0) },
@@ -127,10 +131,12 @@ fake_cpuid (char dst[12], unsigned int id)
     memcpy (dst, fake_cpuid_table[i].vendor, 12);
     return 0;
   case 1:
+    dst[8 + 27 / 8] = (1 << (27 % 8));		/* OSXSAVE */
     return fake_cpuid_table[i].fms;
   case 7:
     dst[0] = 0xff;				/* BMI1, AVX2, etc */
     dst[1] = 0xff;				/* BMI2, etc */
+    dst[2] = 0xff;				/* AVX512F, AVX512IFMA, etc */
     return 0;
   case 0x80000001:
     dst[4 + 29 / 8] = (1 << (29 % 8));		/* "long" mode */
@@ -140,6 +146,12 @@ fake_cpuid (char dst[12], unsigned int id)
     abort ();
   }
 }
+
+static long
+fake_xgetbv (int xcr)
+{
+  return 0xe7;					/* x87, SSE, AVX, AVX-512 */
+}
 #endif
 
 
@@ -247,7 +259,26 @@ gmp_workaround_skylake_cpuid_bug ()
   return 0;
 }
 
-enum {BMI2_BIT = 8};
+enum {BMI2_BIT = 8, AVX512F_BIT = 16, AVX512IFMA_BIT = 21};
+
+/* Whether we can use AVX-512 IFMA.  Besides the cpuid bits, the OS must
+   have enabled the opmask and zmm state, as seen through xgetbv.  */
+static int
+gmp_avx512ifma_p (void)
+{
+  char features[12];
+
+  __gmpn_cpuid (features, 1);
+  if ((features[8 + 27 / 8] & (1 << (27 % 8))) == 0)	/* OSXSAVE */
+    return 0;
+  if ((__gmpn_xgetbv (0) & 0xe6) != 0xe6)
+    return 0;
+
+  __gmpn_cpuid (features, 7);
+  return ((features[0 + AVX512F_BIT / 8] & (1 << (AVX512F_BIT % 8))) != 0
+	  && (features[0 + AVX512IFMA_BIT / 8]
+	      & (1 << (AVX512IFMA_BIT % 8))) != 0);
+}
 
 void
 __gmpn_cpuvec_init (void)
@@ -386,6 +417,31 @@ __gmpn_cpuvec_init (void)
 	      CPUVEC_SETUP_coreibwl;
 	      CPUVEC_SETUP_skylake;
 	      break;
+	    case 0x66:		/* Cannonlake */
+	    case 0x6a:		/* Icelake server */
+	    case 0x6c:		/* Icelake server */
+	    case 0x7d:		/* Icelake client */
+	    case 0x7e:		/* Icelake client */
+	    case 0x8c:		/* Tigerlake */
+	    case 0x8d:		/* Tigerlake */
+	    case 0x8f:		/* Sapphire Rapids */
+	    case 0xa7:		/* Rocketlake */
+	    case 0xad:		/* Granite Rapids */
+	    case 0xae:		/* Granite Rapids */
+	    case 0xcf:		/* Emerald Rapids */
+	      CPUVEC_SETUP_core2;
+	      CPUVEC_SETUP_coreinhm;
+	      CPUVEC_SETUP_coreisbr;
+	      __gmpn_cpuid (dummy_string, 7);
+	      if ((dummy_string[0 + BMI2_BIT / 8] & (1 << (BMI2_BIT % 8))) == 0)
+		break;
+	      CPUVEC_SETUP_coreihwl;
+	      CPUVEC_SETUP_coreibwl;
+	      CPUVEC_SETUP_skylake;
+	      if (! gmp_avx512ifma_p ())
+		break;
+	      CPUVEC_SETUP_icelake;
+	      break;
 	    }
 	  break;
 
@@ -205,3 +205,19 @@ PROLOGUE(__gmpn_cpuid)
 	FUNC_EXIT()
 	ret
 EPILOGUE()
+
+
+C long __gmpn_xgetbv (int xcr);
+C
+C Only to be called when cpuid has said the OS enabled it (OSXSAVE).  The
+C instruction is given as bytes since not all assemblers know xgetbv.
+
+PROLOGUE(__gmpn_xgetbv)
+	FUNC_ENTRY(1)
+	mov	R32(%rdi), %ecx
+	.byte	0x0f, 0x01, 0xd0	C xgetbv
+	shl	$32, %rdx
+	or	%rdx, %rax
+	FUNC_EXIT()
+	ret
+EPILOGUE()
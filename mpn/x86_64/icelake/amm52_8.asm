@@ -0,0 +1,156 @@
+dnl  AMD64 mpn_amm52_8 for Intel processors with AVX-512 IFMA.
+
+dnl  Copyright 2026 Free Software Foundation, Inc.
+
+dnl  This file is part of the GNU MP Library.
+dnl
+dnl  The GNU MP Library is free software; you can redistribute it and/or modify
+dnl  it under the terms of either:
+dnl
+dnl    * the GNU Lesser General Public License as published by the Free
+dnl      Software Foundation; either version 3 of the License, or (at your
+dnl      option) any later version.
+dnl
+dnl  or
+dnl
+dnl    * the GNU General Public License as published by the Free Software
+dnl      Foundation; either version 2 of the License, or (at your option) any
+dnl      later version.
+dnl
+dnl  or both in parallel, as here.
+dnl
+dnl  The GNU MP Library is distributed in the hope that it will be useful, but
+dnl  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+dnl  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+dnl  for more details.
+dnl
+dnl  You should have received copies of the GNU General Public License and the
+dnl  GNU Lesser General Public License along with the GNU MP Library.  If not,
+dnl  see https://www.gnu.org/licenses/.
+
+include(`../config.m4')
+
+C The 8 lanes of mpn/generic/amm52_8.c are the 8 quadwords of a zmm
+C register, so each digit position is one vpmadd52luq and one vpmadd52huq
+C for a b, and the same for q m, on all lanes at once.  The running sums
+C are kept in rp, one zmm per position.  For each digit of a, the low
+C position gives q, and then each position j is summed and stored at j-1,
+C with the high halves going into the sum for j+1 as it's loaded.
+C
+C Only zmm16 and up are used, so there's no vzeroupper, and no xmm
+C registers to save for DOS64.
+
+C TODO
+C  * Skip half the products when a = b, as in sqr_basecase.
+C  * Keep a few positions in registers across digits of a.
+
+define(`rp',      `%rdi')
+define(`ap',      `%rsi')
+define(`bp',      `%rdx')
+define(`mp',      `%rcx')
+define(`kp',      `%r8')
+define(`d',       `%r9')
+
+define(`i',       `%r10')
+define(`j',       `%rax')
+define(`dlast',   `%r11')
+
+define(`MASK',    `%zmm16')
+define(`K',       `%zmm17')
+define(`A',       `%zmm18')
+define(`Q',       `%zmm19')
+define(`X',       `%zmm20')
+define(`B',       `%zmm21')
+define(`M',       `%zmm22')
+define(`Y',       `%zmm23')
+
+ABI_SUPPORT(DOS64)
+ABI_SUPPORT(STD64)
+
+ASM_START()
+	TEXT
+	ALIGN(16)
+PROLOGUE(mpn_amm52_8)
+	FUNC_ENTRY(4)
+IFDOS(`	mov	56(%rsp), %r8	')
+IFDOS(`	mov	64(%rsp), %r9	')
+	vmovdqu64 (kp), K
+	mov	$0xfffffffffffff, %r10
+	vpbroadcastq %r10, MASK
+
+	shl	$6, d			C bytes per operand
+	lea	-64(d), dlast		C offset of the last position
+
+	vpxorq	X, X, X
+	xor	R32(j), R32(j)
+L(zero):
+	vmovdqu64 X, (rp,j)
+	add	$64, j
+	cmp	d, j
+	jb	L(zero)
+
+	mov	d, i
+	ALIGN(16)
+L(outer):
+	vmovdqu64 (ap), A
+	vmovdqu64 (bp), B
+	vmovdqu64 (mp), M
+	vmovdqu64 (rp), X
+	vpmadd52luq B, A, X		C low position
+	vpxorq	Q, Q, Q
+	vpmadd52luq K, X, Q		C q = x k mod 2^52
+	vpmadd52luq M, Q, X		C now zero mod 2^52
+	vpsrlq	$52, X, X
+	vpaddq	64(rp), X, X
+	vpmadd52huq B, A, X
+	vpmadd52huq M, Q, X
+	mov	$64, R32(j)
+	cmp	dlast, j
+	jae	L(last)
+
+	ALIGN(16)
+L(inner):
+	vmovdqu64 (bp,j), B
+	vmovdqu64 (mp,j), M
+	vmovdqu64 64(rp,j), Y
+	vpmadd52luq B, A, X
+	vpmadd52luq M, Q, X
+	vpmadd52huq B, A, Y
+	vpmadd52huq M, Q, Y
+	vmovdqu64 X, -64(rp,j)
+	vmovdqa64 Y, X
+	add	$64, j
+	cmp	dlast, j
+	jb	L(inner)
+
+L(last):
+	vmovdqu64 (bp,j), B
+	vmovdqu64 (mp,j), M
+	vpxorq	Y, Y, Y
+	vpmadd52luq B, A, X
+	vpmadd52luq M, Q, X
+	vpmadd52huq B, A, Y
+	vpmadd52huq M, Q, Y
+	vmovdqu64 X, -64(rp,j)
+	vmovdqu64 Y, (rp,j)
+
+	add	$64, ap
+	sub	$64, i
+	jnz	L(outer)
+
+C Propagate the carries, 52 bits per position.
+	vpxorq	Y, Y, Y
+	xor	R32(j), R32(j)
+	ALIGN(16)
+L(norm):
+	vpaddq	(rp,j), Y, X
+	vpsrlq	$52, X, Y
+	vpandq	MASK, X, X
+	vmovdqu64 X, (rp,j)
+	add	$64, j
+	cmp	d, j
+	jb	L(norm)
+
+	FUNC_EXIT()
+	ret
+EPILOGUE()
@@ -0,0 +1,166 @@
+/* Icelake gmp-mparam.h -- Compiler/machine parameter header file.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#define GMP_LIMB_BITS 64
+#define GMP_LIMB_BYTES 8
+
+/* Disable use of slow functions.  FIXME: We should disable lib inclusion.  */
+#undef HAVE_NATIVE_mpn_mul_2
+#undef HAVE_NATIVE_mpn_addmul_2
+
+/* 2100 MHz Xeon (Emerald Rapids), AVX-512 IFMA */
+/* FFT tuning limit = 0.05 M */
+/* Generated by tuneup.c, 2026-10-17, gcc 12.2 */
+
+#define MOD_1_NORM_THRESHOLD               101
+#define MOD_1_UNNORM_THRESHOLD             102
+#define MOD_1N_TO_MOD_1_1_THRESHOLD          9
+#define MOD_1U_TO_MOD_1_1_THRESHOLD          8
+#define MOD_1_1_TO_MOD_1_2_THRESHOLD        14
+#define MOD_1_2_TO_MOD_1_4_THRESHOLD        54
+#define PREINV_MOD_1_TO_MOD_1_THRESHOLD     10
+#define USE_PREINV_DIVREM_1                  1  /* native */
+#define DIV_QR_1_NORM_THRESHOLD             39
+#define DIV_QR_1_UNNORM_THRESHOLD        MP_SIZE_T_MAX  /* never */
+#define DIV_QR_2_PI2_THRESHOLD           MP_SIZE_T_MAX  /* never */
+#define DIVEXACT_1_THRESHOLD                 0  /* always (native) */
+#define BMOD_1_TO_MOD_1_THRESHOLD           26
+
+#define MUL_TOOM22_THRESHOLD               206
+#define MUL_TOOM33_THRESHOLD               244
+#define MUL_TOOM44_THRESHOLD               410
+#define MUL_TOOM6H_THRESHOLD               969
+#define MUL_TOOM8H_THRESHOLD              1171
+
+#define MUL_TOOM32_TO_TOOM43_THRESHOLD     117
+#define MUL_TOOM32_TO_TOOM53_THRESHOLD     226
+#define MUL_TOOM42_TO_TOOM53_THRESHOLD      23
+#define MUL_TOOM42_TO_TOOM63_THRESHOLD      87
+#define MUL_TOOM43_TO_TOOM54_THRESHOLD      41
+
+#define SQR_BASECASE_THRESHOLD               0  /* always (native) */
+#define SQR_TOOM2_THRESHOLD                 42
+#define SQR_TOOM3_THRESHOLD                 50
+#define SQR_TOOM4_THRESHOLD                121
+#define SQR_TOOM6_THRESHOLD                131
+#define SQR_TOOM8_THRESHOLD                154
+
+#define MULMID_TOOM42_THRESHOLD             16
+
+#define MULMOD_BNM1_THRESHOLD               14
+#define SQRMOD_BNM1_THRESHOLD               16
+
+#define MUL_FFT_MODF_THRESHOLD             716  /* k = 6 */
+#define MUL_FFT_TABLE3                                      \
+  { {    716, 6}, {     12, 4}, {     49, 5}, {     25, 4}, \
+    {     51, 5}, {     26, 4}, {     53, 5}, {     46, 6}, \
+    {     25, 5}, {     52, 6}, {     51, 7}, {     26, 6}, \
+    {     63, 7}, {     33, 6}, {     68, 7}, {     35, 8}, \
+    {     18, 6}, {     73, 7}, {     37, 8}, {     19, 7}, \
+    {     39, 6}, {     79, 7}, {     41, 8}, {     21, 7}, \
+    {     45, 8}, {     23, 7}, {     47, 8}, {     25, 7}, \
+    {     52, 8}, {     29, 9}, {     15, 8}, {     33, 9}, \
+    {     17, 8}, {     37, 9}, {     19, 8}, {     43, 9}, \
+    {     23, 8}, {     49, 7}, {     99, 8}, {     50, 9}, \
+    {     27, 8}, {     56, 9}, {     29,10}, {     15, 9}, \
+    {     37,10}, {     19, 8}, {     78, 9}, {     47, 8}, \
+    {     96, 9}, {     49,10}, {     27, 9}, {     55,10}, \
+    {     31, 9}, {     67,10}, {     35, 9}, {     73,10}, \
+    {     39, 9}, {     81,10}, {     43, 9}, {     89,10}, \
+    {   1024,11}, {   2048,12}, {   4096,13}, {   8192,14}, \
+    {  16384,15}, {  32768,16}, {  65536,17}, { 131072,18}, \
+    { 262144,19}, { 524288,20}, {1048576,21}, {2097152,22}, \
+    {4194304,23}, {8388608,24} }
+#define MUL_FFT_TABLE3_SIZE 74
+#define MUL_FFT_THRESHOLD                 8832
+#define MUL_NTT_THRESHOLD                MP_SIZE_T_MAX  /* never */
+
+#define SQR_FFT_MODF_THRESHOLD             380  /* k = 5 */
+#define SQR_FFT_TABLE3                                      \
+  { {    380, 5}, {     21, 6}, {     11, 5}, {     23, 6}, \
+    {     25, 7}, {     15, 6}, {     31, 7}, {     21, 8}, \
+    {     11, 7}, {     24, 8}, {     21, 9}, {     11, 8}, \
+    {     25, 9}, {     13, 8}, {     27, 9}, {     15, 8}, \
+    {     31, 9}, {     17, 8}, {     35, 9}, {     19, 8}, \
+    {     39, 9}, {     23, 8}, {     47, 9}, {     27,10}, \
+    {     15, 9}, {     35,10}, {     19, 9}, {     41,10}, \
+    {     23, 9}, {     49,11}, {     15,10}, {     39,11}, \
+    {     23,10}, {   1024,11}, {   2048,12}, {   4096,13}, \
+    {   8192,14}, {  16384,15}, {  32768,16}, {  65536,17}, \
+    { 131072,18}, { 262144,19}, { 524288,20}, {1048576,21}, \
+    {2097152,22}, {4194304,23}, {8388608,24} }
+#define SQR_FFT_TABLE3_SIZE 47
+#define SQR_FFT_THRESHOLD                  764
+#define SQR_NTT_THRESHOLD                MP_SIZE_T_MAX  /* never */
+
+#define MULLO_BASECASE_THRESHOLD             0  /* always */
+#define MULLO_DC_THRESHOLD                  19
+#define MULLO_MUL_N_THRESHOLD               32
+#define SQRLO_BASECASE_THRESHOLD             8
+#define SQRLO_DC_THRESHOLD                 218
+#define SQRLO_SQR_THRESHOLD                601
+
+#define DC_DIV_QR_THRESHOLD                 20
+#define DC_DIVAPPR_Q_THRESHOLD              53
+#define DC_BDIV_QR_THRESHOLD                19
+#define DC_BDIV_Q_THRESHOLD                 26
+
+#define INV_MULMOD_BNM1_THRESHOLD          180
+#define INV_NEWTON_THRESHOLD                27
+#define INV_APPR_THRESHOLD                  39
+
+#define BINV_NEWTON_THRESHOLD               64
+#define REDC_1_TO_REDC_2_THRESHOLD          20
+#define REDC_2_TO_REDC_N_THRESHOLD          45
+
+#define MU_DIV_QR_THRESHOLD                411
+#define MU_DIVAPPR_Q_THRESHOLD             206
+#define MUPI_DIV_QR_THRESHOLD               18
+#define MU_BDIV_QR_THRESHOLD                80
+#define MU_BDIV_Q_THRESHOLD                 29
+
+#define POWM_SEC_TABLE  1,16,102,218,1067,1628,2315
+
+#define GET_STR_DC_THRESHOLD                16
+#define GET_STR_PRECOMPUTE_THRESHOLD        26
+#define SET_STR_DC_THRESHOLD               190
+#define SET_STR_PRECOMPUTE_THRESHOLD      1127
+
+#define FAC_DSC_THRESHOLD                 1065
+#define FAC_ODD_THRESHOLD                    0  /* always */
+
+#define MATRIX22_STRASSEN_THRESHOLD         14
+#define HGCD2_DIV1_METHOD                    1
+#define HGCD_THRESHOLD                      43
+#define HGCD_APPR_THRESHOLD                 50
+#define HGCD_REDUCE_THRESHOLD              229
+#define GCD_DC_THRESHOLD                    94
+#define GCDEXT_DC_THRESHOLD                102
+#define JACOBI_BASE_METHOD                   1
@@ -0,0 +1,506 @@
+dnl  AMD64 mpn_mul_basecase for Intel processors with AVX-512 IFMA.
+
+dnl  Copyright 2026 Free Software Foundation, Inc.
+
+dnl  This file is part of the GNU MP Library.
+dnl
+dnl  The GNU MP Library is free software; you can redistribute it and/or modify
+dnl  it under the terms of either:
+dnl
+dnl    * the GNU Lesser General Public License as published by the Free
+dnl      Software Foundation; either version 3 of the License, or (at your
+dnl      option) any later version.
+dnl
+dnl  or
+dnl
+dnl    * the GNU General Public License as published by the Free Software
+dnl      Foundation; either version 2 of the License, or (at your option) any
+dnl      later version.
+dnl
+dnl  or both in parallel, as here.
+dnl
+dnl  The GNU MP Library is distributed in the hope that it will be useful, but
+dnl  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+dnl  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+dnl  for more details.
+dnl
+dnl  You should have received copies of the GNU General Public License and the
+dnl  GNU Lesser General Public License along with the GNU MP Library.  If not,
+dnl  see https://www.gnu.org/licenses/.
+
+include(`../config.m4')
+
+C The operands are split into 52-bit digits, and the digit products are
+C accumulated by vpmadd52luq and vpmadd52huq, 8 columns per zmm register and
+C 32 columns per pass over v.  The low halves of the digit products go to a
+C column array L, the high halves to H, where H[c] belongs to column c+1.  A
+C scalar pass then adds L, H and carries, and packs the 52-bit digits back
+C into limbs.
+C
+C Each column gets at most vn lo and vn hi contributions, each below 2^52, so
+C with un limited to UN_MAX nothing overflows 64 bits in the vector part.  For
+C larger un, and for small products where conversion and packing cost more
+C than they gain, we do plain mpn_mul_1 and mpn_addmul_1 rows.  The cutoff is
+C a matter of un*vn, except that for vn below VN_MIN the rows are near peak
+C speed anyway.
+C
+C Everything is kept on the stack, about 16(un+vn)/13 digits for each of L, H
+C and the converted operands, i.e. about 15 KiB at un = vn = UN_MAX.
+
+C TODO
+C  * Use this also for sqr_basecase, with the symmetric products doubled.
+C  * Do the conversion of v and of u in one pass, and overlap the packing
+C    with the last block.
+
+define(`VN_MIN',    6)
+define(`UNVN_MIN', 192)
+define(`UN_MAX',   512)
+
+define(`rp',      `%rdi')
+define(`up',      `%rsi')
+define(`un_param',`%rdx')
+define(`vp_param',`%rcx')
+define(`vn_param',`%r8')
+
+define(`Lp',      `%r10')
+define(`Hp',      `%r11')
+define(`Ud',      `%r9')
+define(`Vd',      `%r14')
+
+C Set k1 to select the first min(max(n,0),8) quadwords of a group, n being
+C the number of limbs left from the start of the group.
+define(`GROUP_MASK',`
+	mov	$1, %r8
+	mov	$`'8, %eax
+	cmp	%rax, %r8
+	cmovg	%rax, %r8
+	xor	%eax, %eax
+	test	%r8, %r8
+	cmovs	%rax, %r8
+	mov	$`'0xff, %eax
+	bzhi	%r8, %rax, %rax
+	kmovw	%eax, %k1')
+
+C Digits from the 8 limbs in zmm0, with the index and shift vectors in the
+C registers given, to zmm1.
+define(`CVT_GROUP',`
+	vpermq	%zmm0, %zmm$1, %zmm1
+	vpermq	%zmm0, %zmm$2, %zmm2
+	vpsrlvq	%zmm$3, %zmm1, %zmm1
+	vpsllvq	%zmm$4, %zmm2, %zmm2
+	vpternlogq $`'0xa8, %zmm24, %zmm2, %zmm1')
+
+ABI_SUPPORT(STD64)
+
+ASM_START()
+	TEXT
+	ALIGN(16)
+PROLOGUE(mpn_mul_basecase)
+	FUNC_ENTRY(4)
+	cmp	$VN_MIN, vn_param
+	jb	L(rows)
+	cmp	$UN_MAX, un_param
+	ja	L(rows)
+	mov	un_param, %rax
+	imul	vn_param, %rax
+	cmp	$UNVN_MIN, %rax
+	jb	L(rows)
+
+	push	%rbp
+	mov	%rsp, %rbp
+	push	%rbx
+	push	%r12
+	push	%r13
+	push	%r14
+	push	%r15
+	lea	-72(%rbp), %rsp
+	mov	up, -48(%rbp)
+	mov	vp_param, -56(%rbp)
+	mov	un_param, -64(%rbp)
+	mov	vn_param, -72(%rbp)
+	mov	rp, %r12
+	lea	(un_param,vn_param), %r13	C rn
+
+C nu = ceil(64un/52), nv likewise
+	shl	$4, un_param
+	add	$12, un_param
+	imul	$1321528399, un_param, %r15
+	shr	$34, %r15
+	shl	$4, vn_param
+	add	$12, vn_param
+	imul	$1321528399, vn_param, %rbx
+	shr	$34, %rbx
+	lea	(%r15,%rbx), %r8		C nc, number of columns
+
+C Stack areas, in 64-byte aligned quadwords: L, H with 8 leading zeros, Ud
+C with 32 leading and at least 48 trailing zero digits, and Vd.
+	lea	47(%r8), %rax
+	and	$-8, %rax
+	lea	55(%r8), %rcx
+	and	$-8, %rcx
+	lea	103(%r15), %rdx
+	and	$-8, %rdx
+	lea	23(%rbx), %rsi
+	and	$-8, %rsi
+	lea	(%rax,%rcx), %rdi
+	add	%rdx, %rdi
+	add	%rsi, %rdi
+	shl	$3, %rdi
+	sub	%rdi, %rsp
+	and	$-64, %rsp
+	mov	%rsp, Lp
+	lea	(Lp,%rax,8), Hp
+	lea	(Hp,%rcx,8), Ud
+	lea	(Ud,%rdx,8), Vd
+
+	vpxorq	%zmm25, %zmm25, %zmm25
+	vmovdqa64 %zmm25, (Hp)
+	add	$64, Hp
+	vmovdqa64 %zmm25, (Ud)
+	vmovdqa64 %zmm25, 64(Ud)
+	vmovdqa64 %zmm25, 128(Ud)
+	vmovdqa64 %zmm25, 192(Ud)
+	add	$256, Ud
+
+	lea	L(cvtab)(%rip), %rax
+	vmovdqa64 (%rax), %zmm16
+	vmovdqa64 64(%rax), %zmm17
+	vmovdqa64 128(%rax), %zmm18
+	vmovdqa64 192(%rax), %zmm19
+	vmovdqa64 256(%rax), %zmm20
+	vmovdqa64 320(%rax), %zmm21
+	vmovdqa64 384(%rax), %zmm22
+	vmovdqa64 448(%rax), %zmm23
+	vpternlogq $0xff, %zmm24, %zmm24, %zmm24
+	vpsrlq	$12, %zmm24, %zmm24		C 52-bit mask
+
+	mov	-56(%rbp), %rsi
+	mov	-72(%rbp), %rdx
+	mov	Vd, %rdi
+	lea	15(%rbx), %rcx
+	shr	$4, %rcx
+	call	L(cvt)
+	mov	-48(%rbp), %rsi
+	mov	-64(%rbp), %rdx
+	mov	Ud, %rdi
+	lea	15(%r15), %rcx
+	shr	$4, %rcx
+	call	L(cvt)
+	lea	(Ud,%r15,8), %rax
+	vmovdqu64 %zmm25, (%rax)
+	vmovdqu64 %zmm25, 64(%rax)
+	vmovdqu64 %zmm25, 128(%rax)
+	vmovdqu64 %zmm25, 192(%rax)
+	vmovdqu64 %zmm25, 256(%rax)
+	vmovdqu64 %zmm25, 320(%rax)
+
+	lea	(%r15,%rbx), %r8		C nc
+	add	$6, %r15
+
+C Columns k..k+31 in zmm0-zmm7, summing over j0 <= j < jend.
+	xor	%esi, %esi
+	ALIGN(16)
+L(blk):	mov	%rsi, %rax
+	xor	%ecx, %ecx
+	sub	%r15, %rax
+	cmovs	%rcx, %rax			C j0 = max(k-nu-6, 0)
+	lea	32(%rsi), %rcx
+	cmp	%rbx, %rcx
+	cmova	%rbx, %rcx			C jend = min(k+32, nv)
+	sub	%rax, %rcx
+	lea	(Vd,%rax,8), %rdx
+	mov	%rsi, %rdi
+	sub	%rax, %rdi
+	lea	(Ud,%rdi,8), %rdi
+	vpxorq	%zmm0, %zmm0, %zmm0
+	vpxorq	%zmm1, %zmm1, %zmm1
+	vpxorq	%zmm2, %zmm2, %zmm2
+	vpxorq	%zmm3, %zmm3, %zmm3
+	vpxorq	%zmm4, %zmm4, %zmm4
+	vpxorq	%zmm5, %zmm5, %zmm5
+	vpxorq	%zmm6, %zmm6, %zmm6
+	vpxorq	%zmm7, %zmm7, %zmm7
+	ALIGN(16)
+L(top):	vpbroadcastq (%rdx), %zmm8
+	vmovdqu64 (%rdi), %zmm9
+	vmovdqu64 64(%rdi), %zmm10
+	vmovdqu64 128(%rdi), %zmm11
+	vmovdqu64 192(%rdi), %zmm12
+	vpmadd52luq %zmm9, %zmm8, %zmm0
+	vpmadd52huq %zmm9, %zmm8, %zmm1
+	vpmadd52luq %zmm10, %zmm8, %zmm2
+	vpmadd52huq %zmm10, %zmm8, %zmm3
+	vpmadd52luq %zmm11, %zmm8, %zmm4
+	vpmadd52huq %zmm11, %zmm8, %zmm5
+	vpmadd52luq %zmm12, %zmm8, %zmm6
+	vpmadd52huq %zmm12, %zmm8, %zmm7
+	add	$8, %rdx
+	sub	$8, %rdi
+	dec	%rcx
+	jnz	L(top)
+	vmovdqa64 %zmm0, (Lp,%rsi,8)
+	vmovdqu64 %zmm1, (Hp,%rsi,8)
+	vmovdqa64 %zmm2, 64(Lp,%rsi,8)
+	vmovdqu64 %zmm3, 64(Hp,%rsi,8)
+	vmovdqa64 %zmm4, 128(Lp,%rsi,8)
+	vmovdqu64 %zmm5, 128(Hp,%rsi,8)
+	vmovdqa64 %zmm6, 192(Lp,%rsi,8)
+	vmovdqu64 %zmm7, 192(Hp,%rsi,8)
+	add	$32, %rsi
+	cmp	%r8, %rsi
+	jb	L(blk)
+
+C Add up columns and carries, 16 digits to 13 limbs per iteration, into a
+C staging area over Ud and Vd.
+	lea	-256(Ud), %rdi
+	mov	%rdi, %r15
+	sub	$8, Hp				C H[c-1] goes with L[c]
+	lea	15(%r8), %rcx
+	shr	$4, %rcx
+	mov	$52, %r9d
+	xor	%eax, %eax
+	ALIGN(16)
+L(pack):
+	add	(Lp), %rax
+	add	(Hp), %rax
+	bzhi	%r9, %rax, %rdx
+	shr	$52, %rax
+	add	8(Lp), %rax
+	add	8(Hp), %rax
+	bzhi	%r9, %rax, %rsi
+	shr	$52, %rax
+	mov	%rsi, %r8
+	shl	$52, %r8
+	or	%r8, %rdx
+	mov	%rdx, (%rdi)
+	shr	$12, %rsi
+	add	16(Lp), %rax
+	add	16(Hp), %rax
+	bzhi	%r9, %rax, %rbx
+	shr	$52, %rax
+	mov	%rbx, %r8
+	shl	$40, %r8
+	or	%r8, %rsi
+	mov	%rsi, 8(%rdi)
+	shr	$24, %rbx
+	add	24(Lp), %rax
+	add	24(Hp), %rax
+	bzhi	%r9, %rax, %rdx
+	shr	$52, %rax
+	mov	%rdx, %r8
+	shl	$28, %r8
+	or	%r8, %rbx
+	mov	%rbx, 16(%rdi)
+	shr	$36, %rdx
+	add	32(Lp), %rax
+	add	32(Hp), %rax
+	bzhi	%r9, %rax, %rsi
+	shr	$52, %rax
+	mov	%rsi, %r8
+	shl	$16, %r8
+	or	%r8, %rdx
+	mov	%rdx, 24(%rdi)
+	shr	$48, %rsi
+	add	40(Lp), %rax
+	add	40(Hp), %rax
+	bzhi	%r9, %rax, %rbx
+	shr	$52, %rax
+	shl	$4, %rbx
+	or	%rbx, %rsi
+	add	48(Lp), %rax
+	add	48(Hp), %rax
+	bzhi	%r9, %rax, %r8
+	shr	$52, %rax
+	mov	%r8, %rdx
+	shl	$56, %rdx
+	or	%rdx, %rsi
+	mov	%rsi, 32(%rdi)
+	shr	$8, %r8
+	add	56(Lp), %rax
+	add	56(Hp), %rax
+	bzhi	%r9, %rax, %rbx
+	shr	$52, %rax
+	mov	%rbx, %rdx
+	shl	$44, %rdx
+	or	%rdx, %r8
+	mov	%r8, 40(%rdi)
+	shr	$20, %rbx
+	add	64(Lp), %rax
+	add	64(Hp), %rax
+	bzhi	%r9, %rax, %rsi
+	shr	$52, %rax
+	mov	%rsi, %rdx
+	shl	$32, %rdx
+	or	%rdx, %rbx
+	mov	%rbx, 48(%rdi)
+	shr	$32, %rsi
+	add	72(Lp), %rax
+	add	72(Hp), %rax
+	bzhi	%r9, %rax, %r8
+	shr	$52, %rax
+	mov	%r8, %rdx
+	shl	$20, %rdx
+	or	%rdx, %rsi
+	mov	%rsi, 56(%rdi)
+	shr	$44, %r8
+	add	80(Lp), %rax
+	add	80(Hp), %rax
+	bzhi	%r9, %rax, %rbx
+	shr	$52, %rax
+	shl	$8, %rbx
+	or	%rbx, %r8
+	add	88(Lp), %rax
+	add	88(Hp), %rax
+	bzhi	%r9, %rax, %rdx
+	shr	$52, %rax
+	mov	%rdx, %rsi
+	shl	$60, %rsi
+	or	%rsi, %r8
+	mov	%r8, 64(%rdi)
+	shr	$4, %rdx
+	add	96(Lp), %rax
+	add	96(Hp), %rax
+	bzhi	%r9, %rax, %rbx
+	shr	$52, %rax
+	mov	%rbx, %rsi
+	shl	$48, %rsi
+	or	%rsi, %rdx
+	mov	%rdx, 72(%rdi)
+	shr	$16, %rbx
+	add	104(Lp), %rax
+	add	104(Hp), %rax
+	bzhi	%r9, %rax, %r8
+	shr	$52, %rax
+	mov	%r8, %rsi
+	shl	$36, %rsi
+	or	%rsi, %rbx
+	mov	%rbx, 80(%rdi)
+	shr	$28, %r8
+	add	112(Lp), %rax
+	add	112(Hp), %rax
+	bzhi	%r9, %rax, %rdx
+	shr	$52, %rax
+	mov	%rdx, %rsi
+	shl	$24, %rsi
+	or	%rsi, %r8
+	mov	%r8, 88(%rdi)
+	shr	$40, %rdx
+	add	120(Lp), %rax
+	add	120(Hp), %rax
+	bzhi	%r9, %rax, %rbx
+	shr	$52, %rax
+	mov	%rbx, %rsi
+	shl	$12, %rsi
+	or	%rsi, %rdx
+	mov	%rdx, 96(%rdi)
+	sub	$-128, Lp
+	sub	$-128, Hp
+	add	$104, %rdi
+	dec	%rcx
+	jnz	L(pack)
+
+	ALIGN(16)
+L(cpy):	GROUP_MASK(%r13)
+	vmovdqu64 (%r15), %zmm0{%k1}{z}
+	vmovdqu64 %zmm0, (%r12){%k1}
+	add	$64, %r15
+	add	$64, %r12
+	sub	$8, %r13
+	jg	L(cpy)
+
+	vzeroupper
+	lea	-40(%rbp), %rsp
+	pop	%r15
+	pop	%r14
+	pop	%r13
+	pop	%r12
+	pop	%rbx
+	pop	%rbp
+	FUNC_EXIT()
+	ret
+
+C Convert {rsi,rdx} to 16rcx digits at rdi, 13 limbs to 16 digits per
+C iteration.  Digits past the end of the operand come out zero.  The masked
+C loads are kept to the end, they can't take forwarded data and so stall
+C badly when they alias with our stores to the stack.  Clobbers rax, r8, k1
+C and zmm0-zmm2.
+	ALIGN(16)
+L(cvt):	cmp	$14, %rdx
+	jl	L(cvm)
+	vmovdqu64 (%rsi), %zmm0
+	CVT_GROUP(16, 17, 18, 19)
+	vmovdqu64 %zmm1, (%rdi)
+	vmovdqu64 48(%rsi), %zmm0
+	CVT_GROUP(20, 21, 22, 23)
+	vmovdqu64 %zmm1, 64(%rdi)
+	jmp	L(cvn)
+L(cvm):	GROUP_MASK(%rdx)
+	vmovdqu64 (%rsi), %zmm0{%k1}{z}
+	CVT_GROUP(16, 17, 18, 19)
+	vmovdqu64 %zmm1, (%rdi)
+	lea	-6(%rdx), %r8
+	GROUP_MASK(%r8)
+	vmovdqu64 48(%rsi), %zmm0{%k1}{z}
+	CVT_GROUP(20, 21, 22, 23)
+	vmovdqu64 %zmm1, 64(%rdi)
+L(cvn):	add	$104, %rsi
+	sub	$-128, %rdi
+	sub	$13, %rdx
+	dec	%rcx
+	jnz	L(cvt)
+	ret
+
+C Plain rows, for small vn and for un too large for the column sums.
+L(rows):
+	push	%rbx
+	push	%rbp
+	push	%r12
+	push	%r13
+	push	%r14
+	mov	rp, %rbx
+	mov	up, %rbp
+	mov	un_param, %r12
+	mov	vp_param, %r13
+	mov	vn_param, %r14
+	mov	(vp_param), %rcx
+	CALL(	mpn_mul_1)
+	mov	%rax, (%rbx,%r12,8)
+	dec	%r14
+	jz	L(rend)
+L(rtop):
+	add	$8, %rbx
+	add	$8, %r13
+	mov	%rbx, %rdi
+	mov	%rbp, %rsi
+	mov	%r12, %rdx
+	mov	(%r13), %rcx
+	CALL(	mpn_addmul_1)
+	mov	%rax, (%rbx,%r12,8)
+	dec	%r14
+	jnz	L(rtop)
+L(rend):
+	pop	%r14
+	pop	%r13
+	pop	%r12
+	pop	%rbp
+	pop	%rbx
+	FUNC_EXIT()
+	ret
+EPILOGUE()
+
+C Digit i of a group of 8 is bits 52i..52i+51 from the group start, which is
+C a multiple of 52*8 = 416 bits, i.e. limb 6.5 times the group index.  For
+C each digit, the limb index within the 8 limbs loaded for the group and the
+C shift, first for even then for odd groups.  Odd groups are loaded at limb
+C 6 and start 32 bits into it.
+	RODATA
+	ALIGN(64)
+L(cvtab):
+	.quad	0, 0, 1, 2, 3, 4, 4, 5
+	.quad	1, 1, 2, 3, 4, 5, 5, 6
+	.quad	0, 52, 40, 28, 16, 4, 56, 44
+	.quad	64, 12, 24, 36, 48, 60, 8, 20
+	.quad	0, 1, 2, 2, 3, 4, 5, 6
+	.quad	1, 2, 3, 3, 4, 5, 6, 7
+	.quad	32, 20, 8, 60, 48, 36, 24, 12
+	.quad	32, 44, 56, 4, 16, 28, 40, 52
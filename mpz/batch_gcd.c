@@ -0,0 +1,143 @@
+/* mpz_batch_gcd, mpz_batch_gcd_bounded -- gcds of many numbers with the
+   product of the others.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "gmp.h"
+#include "gmp-impl.h"
+
+
+/* Bernstein's batch gcd.  With P the product of all the N_i, P mod N_i^2
+   is N_i (P/N_i mod N_i), so gcd (N_i, P/N_i) comes from one remainder
+   tree of P over the squares, and a small gcd for each.
+
+   To bound the memory, the N_i are taken in groups.  The group products
+   P_j are formed first, which together take no more space than the N_i
+   themselves.  Then for each group a tree of the squares is built, and P
+   mod N_i^2 is accumulated as the product of the P_j mod N_i^2, from a
+   remainder tree for each P_j.  With g groups that's g^2 remainder trees
+   each 1/g the size, so about g times the work of a single tree, but the
+   space is only that of a group, rather than log2(n) times everything.
+
+   The tree code spreads the work over threads, when there's more than
+   one.  */
+
+void
+mpz_batch_gcd_bounded (const mpz_ptr *out, const mpz_srcptr *in, size_t n,
+		       size_t group)
+{
+  mpz_product_tree_t sq;
+  __mpz_struct *prod, *z, *t;
+  mpz_ptr *zp, *tp;
+  mpz_srcptr *np;
+  size_t groups, lo, hi, gn, i, j, l;
+  TMP_DECL;
+
+  if (n == 0)
+    return;
+  if (group == 0 || group > n)
+    group = n;
+  groups = (n + group - 1) / group;
+
+  TMP_MARK;
+  prod = TMP_ALLOC_TYPE (groups, __mpz_struct);
+  z = TMP_ALLOC_TYPE (group, __mpz_struct);
+  t = TMP_ALLOC_TYPE (group, __mpz_struct);
+  zp = TMP_ALLOC_TYPE (group, mpz_ptr);
+  tp = TMP_ALLOC_TYPE (group, mpz_ptr);
+  np = TMP_ALLOC_TYPE (group, mpz_srcptr);
+
+  for (j = 0; j < groups; j++)
+    {
+      lo = j * group;
+      hi = MIN (lo + group, n);
+      for (i = lo; i < hi; i++)
+	if (UNLIKELY (SIZ (in[i]) == 0))
+	  DIVIDE_BY_ZERO;
+      mpz_init (&prod[j]);
+      mpz_product_tree (&prod[j], in + lo, hi - lo);
+    }
+  for (i = 0; i < group; i++)
+    {
+      mpz_init (&z[i]);
+      mpz_init (&t[i]);
+      zp[i] = &z[i];
+      tp[i] = &t[i];
+      np[i] = &z[i];
+    }
+
+  for (l = 0; l < groups; l++)
+    {
+      lo = l * group;
+      hi = MIN (lo + group, n);
+      gn = hi - lo;
+
+      for (i = 0; i < gn; i++)
+	mpz_mul (&z[i], in[lo + i], in[lo + i]);
+      mpz_product_tree_init (sq, np, gn);
+
+      /* z[i] = P mod N_i^2, starting with the group's own product */
+      mpz_remainder_tree (zp, &prod[l], sq);
+      for (j = 0; j < groups; j++)
+	{
+	  if (j == l)
+	    continue;
+	  mpz_remainder_tree (tp, &prod[j], sq);
+	  for (i = 0; i < gn; i++)
+	    {
+	      mpz_mul (&z[i], &z[i], &t[i]);
+	      mpz_mod (&z[i], &z[i], &sq->_mp_node[gn - 1 + i]);
+	    }
+	}
+      mpz_product_tree_clear (sq);
+
+      /* Everything needed from this group's N_i has been read, so out[i]
+	 can be in[i].  */
+      for (i = 0; i < gn; i++)
+	{
+	  mpz_divexact (&z[i], &z[i], in[lo + i]);
+	  mpz_gcd (out[lo + i], &z[i], in[lo + i]);
+	}
+    }
+
+  for (i = 0; i < group; i++)
+    {
+      mpz_clear (&z[i]);
+      mpz_clear (&t[i]);
+    }
+  for (j = 0; j < groups; j++)
+    mpz_clear (&prod[j]);
+  TMP_FREE;
+}
+
+void
+mpz_batch_gcd (const mpz_ptr *out, const mpz_srcptr *in, size_t n)
+{
+  mpz_batch_gcd_bounded (out, in, n, 0);
+}
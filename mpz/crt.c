@@ -0,0 +1,203 @@
+/* mpz_crt_basis_init, mpz_crt_basis_clear, mpz_crt_combine -- Chinese
+   remainder reconstruction with precomputed moduli.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "gmp.h"
+#include "gmp-impl.h"
+
+
+/* With M the product of the m_i, x = sum r_i w_i M/m_i mod M, where the
+   weight w_i is the inverse of M/m_i mod m_i.
+
+   The M/m_i mod m_i come from M mod m_i^2, all at once from a remainder
+   tree over the squares, a division by m_i then giving M/m_i mod m_i.  If
+   that's not invertible the moduli aren't coprime.
+
+   The sum is formed up the product tree, a node's value being
+   left P_right + right P_left, with c_i = r_i w_i mod m_i at the leaves.
+   That's the sum at the root, less than k M, and it's reduced at the end.
+   With threads, subtrees are summed in parallel.  */
+
+#define CRT_LEAF_P(k,i)  ((i) + 1 >= (k))
+
+struct crt_combine
+{
+  const __mpz_struct *node;
+  const __mpz_struct *w;
+  const mpz_srcptr *r;
+  size_t k;
+  size_t f;			/* first node of the parallel level */
+  size_t stop;			/* first node taken from part[], or none */
+  mpz_ptr part;
+};
+
+/* Set v to the sum for the subtree at node i.  */
+static void
+crt_sum (mpz_ptr v, const struct crt_combine *C, size_t i)
+{
+  size_t j;
+  mpz_t t;
+
+  if (CRT_LEAF_P (C->k, i))
+    {
+      j = i - (C->k - 1);
+      mpz_mul (v, C->r[j], &C->w[j]);
+      mpz_mod (v, v, &C->node[i]);
+      return;
+    }
+  if (i >= C->stop)
+    {
+      mpz_swap (v, &C->part[i - C->stop]);
+      return;
+    }
+
+  mpz_init (t);
+  crt_sum (t, C, 2 * i + 1);
+  crt_sum (v, C, 2 * i + 2);
+  mpz_mul (v, v, &C->node[2 * i + 1]);
+  mpz_addmul (v, t, &C->node[2 * i + 2]);
+  mpz_clear (t);
+}
+
+static void
+crt_sum_item (void *arg, mp_size_t c)
+{
+  const struct crt_combine *C = (const struct crt_combine *) arg;
+  crt_sum (&C->part[c], C, C->f + c);
+}
+
+int
+mpz_crt_basis_init (mpz_crt_basis_t b, const mpz_srcptr *m, size_t k)
+{
+  mpz_product_tree_t sq;
+  __mpz_struct *node, *w;
+  mpz_ptr *wp;
+  mpz_srcptr *mp;
+  size_t i;
+  int ok;
+  TMP_DECL;
+
+  mpz_product_tree_init (b->_mp_tree, m, k);
+  if (k == 0)
+    {
+      b->_mp_w = NULL;
+      return 1;
+    }
+
+  node = b->_mp_tree->_mp_node;
+  w = __GMP_ALLOCATE_FUNC_TYPE (k, __mpz_struct);
+  b->_mp_w = w;
+
+  TMP_MARK;
+  mp = TMP_ALLOC_TYPE (k, mpz_srcptr);
+  wp = TMP_ALLOC_TYPE (k, mpz_ptr);
+  for (i = 0; i < k; i++)
+    {
+      mpz_init (&w[i]);
+      mpz_mul (&w[i], &node[k - 1 + i], &node[k - 1 + i]);
+      mp[i] = &w[i];
+      wp[i] = &w[i];
+    }
+
+  /* M mod m_i^2, in place of the squares */
+  mpz_product_tree_init (sq, mp, k);
+  mpz_remainder_tree (wp, &node[0], sq);
+  mpz_product_tree_clear (sq);
+
+  ok = 1;
+  for (i = 0; i < k; i++)
+    {
+      mpz_divexact (&w[i], &w[i], &node[k - 1 + i]);
+      ok &= mpz_invert (&w[i], &w[i], &node[k - 1 + i]) != 0;
+    }
+  TMP_FREE;
+  return ok;
+}
+
+void
+mpz_crt_basis_clear (mpz_crt_basis_t b)
+{
+  size_t i, k;
+
+  k = b->_mp_tree->_mp_k;
+  for (i = 0; i < k; i++)
+    mpz_clear (&b->_mp_w[i]);
+  if (k != 0)
+    __GMP_FREE_FUNC_TYPE (b->_mp_w, k, __mpz_struct);
+  mpz_product_tree_clear (b->_mp_tree);
+}
+
+void
+mpz_crt_combine (mpz_ptr rop, const mpz_srcptr *r, mpz_crt_basis_t b)
+{
+  struct crt_combine C;
+  mpz_t v;
+  size_t i, k, f;
+  TMP_DECL;
+
+  k = b->_mp_tree->_mp_k;
+  if (k == 0)
+    {
+      SIZ (rop) = 0;
+      return;
+    }
+
+  C.node = b->_mp_tree->_mp_node;
+  C.w = b->_mp_w;
+  C.r = r;
+  C.k = k;
+
+  TMP_MARK;
+  mpz_init (v);
+  f = mpz_product_tree_split (k, SIZ (&C.node[0]));
+  if (f != 0)
+    {
+      C.f = f;
+      C.stop = 2 * k;
+      C.part = TMP_ALLOC_TYPE (f + 1, __mpz_struct);
+      for (i = 0; i <= f; i++)
+	mpz_init (&C.part[i]);
+      __gmp_parallel_run (crt_sum_item, &C, f + 1);
+      C.stop = f;
+      crt_sum (v, &C, 0);
+      for (i = 0; i <= f; i++)
+	mpz_clear (&C.part[i]);
+    }
+  else
+    {
+      C.stop = 2 * k;
+      crt_sum (v, &C, 0);
+    }
+
+  /* All the r[i] have been read, so rop can be one of them.  */
+  mpz_mod (rop, v, &C.node[0]);
+  mpz_clear (v);
+  TMP_FREE;
+}
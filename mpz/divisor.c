@@ -0,0 +1,399 @@
+/* mpz_divisor_init, mpz_divisor_clear, mpz_tdiv_qr_pre, mpz_mod_pre,
+   mpz_divexact_pre -- division by a fixed integer with precomputed
+   inverses.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include <stdio.h> /* for NULL */
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "longlong.h"
+
+
+/* mpn_tdiv_qr normalizes the divisor and computes the inverse of its top
+   two limbs on every call, and above MUPI_DIV_QR_THRESHOLD an approximate
+   inverse for mpn_mu_div_qr too, which is a good part of the cost of a
+   division.  Likewise mpn_bdiv_q computes a 2-adic inverse for exact
+   division.  Here that's all done once, and the division proper picks
+   sbpi1, dcpi1 or preinv_mu as mpn_tdiv_qr would.
+
+   The table holds the normalized divisor, then when dn is at least
+   MUPI_DIV_QR_THRESHOLD its full dn limb approximate inverse, of which
+   each division uses the high limbs it wants.  Then for exact division
+   the odd part of d, of on limbs, and when on is at least
+   DC_BDIV_Q_THRESHOLD its 2-adic inverse, on limbs again.  A quotient of
+   qn <= on limbs is then a single mpn_mullo_n.
+
+   Divisors of one and two limbs gain nothing, mpn_divrem_1 and
+   mpn_divrem_2 are already quick to set up, so they have no table and go
+   straight to mpz_tdiv_qr and friends.  */
+
+#define DIVISOR_D2(D)	((D)->_mp_tab)
+#define DIVISOR_IP(D)	((D)->_mp_tab + ABSIZ ((D)->_mp_d))
+#define DIVISOR_OP(D)	(DIVISOR_IP (D) + (D)->_mp_in)
+
+#define DIVISOR_BINV_P(on)  ABOVE_THRESHOLD (on, DC_BDIV_Q_THRESHOLD)
+
+/* The odd part of d is d / 2^(z*GMP_NUMB_BITS + t), of the size returned.  */
+static mp_size_t
+divisor_odd (mpz_srcptr d, mp_size_t *zp, int *tp)
+{
+  mp_srcptr dp;
+  mp_size_t dn, z, on;
+  int t;
+
+  dp = PTR (d);
+  dn = ABSIZ (d);
+  for (z = 0; dp[z] == 0; z++)
+    ;
+  count_trailing_zeros (t, dp[z]);
+  on = dn - z;
+  if (t != 0 && on > 1 && (dp[dn - 1] >> t) == 0)
+    on--;
+
+  *zp = z;
+  *tp = t;
+  return on;
+}
+
+void
+mpz_divisor_init (mpz_divisor_t D, mpz_srcptr d)
+{
+  mp_size_t dn, in, on, z, size;
+  mp_srcptr dp;
+  mp_ptr d2p, op, tp, xp;
+  gmp_pi1_t dinv;
+  int cnt, t;
+  TMP_DECL;
+
+  dn = ABSIZ (d);
+  if (UNLIKELY (dn == 0))
+    DIVIDE_BY_ZERO;
+
+  mpz_init_set (D->_mp_d, d);
+  D->_mp_tab = NULL;
+  D->_mp_in = 0;
+  D->_mp_inv32 = 0;
+  D->_mp_shift = 0;
+
+  if (dn <= 2)
+    return;
+
+  dp = PTR (D->_mp_d);
+  in = ABOVE_THRESHOLD (dn, MUPI_DIV_QR_THRESHOLD) ? dn : 0;
+  on = divisor_odd (d, &z, &t);
+  size = dn + in + on + (DIVISOR_BINV_P (on) ? on : 0);
+
+  D->_mp_tab = __GMP_ALLOCATE_FUNC_LIMBS (size);
+  D->_mp_in = in;
+
+  d2p = DIVISOR_D2 (D);
+  count_leading_zeros (cnt, dp[dn - 1]);
+  cnt -= GMP_NAIL_BITS;
+  if (cnt != 0)
+    mpn_lshift (d2p, dp, dn, cnt);
+  else
+    MPN_COPY (d2p, dp, dn);
+  D->_mp_shift = cnt;
+
+  invert_pi1 (dinv, d2p[dn - 1], d2p[dn - 2]);
+  D->_mp_inv32 = dinv.inv32;
+
+  TMP_MARK;
+  if (in != 0)
+    {
+      /* As in mpn_mu_div_qr2, an inverse of in+1 limbs rounded to in, here
+	 with in = dn.  */
+      TMP_ALLOC_LIMBS_2 (xp, in + 1,
+			 tp, in + 1 + mpn_invertappr_itch (in + 1));
+      MPN_COPY (tp + 1, d2p, in);
+      tp[0] = 1;
+      mpn_invertappr (xp, tp, in + 1, tp + in + 1);
+      MPN_COPY (DIVISOR_IP (D), xp + 1, in);
+    }
+
+  op = DIVISOR_OP (D);
+  tp = TMP_ALLOC_LIMBS (MAX (dn - z, mpn_binvert_itch (on)));
+  if (t != 0)
+    mpn_rshift (tp, dp + z, dn - z, t);
+  else
+    MPN_COPY (tp, dp + z, dn - z);
+  MPN_COPY (op, tp, on);
+
+  if (DIVISOR_BINV_P (on))
+    mpn_binvert (op + on, op, on, tp);
+
+  TMP_FREE;
+}
+
+void
+mpz_divisor_clear (mpz_divisor_t D)
+{
+  mp_size_t on, z;
+  int t;
+
+  if (D->_mp_tab != NULL)
+    {
+      on = divisor_odd (D->_mp_d, &z, &t);
+      __GMP_FREE_FUNC_LIMBS (D->_mp_tab, ABSIZ (D->_mp_d) + D->_mp_in + on
+			     + (DIVISOR_BINV_P (on) ? on : 0));
+    }
+  mpz_clear (D->_mp_d);
+}
+
+/* Divide {np,nn} by the divisor, nn >= dn, with the quotient at qp, of
+   nn-dn+1 limbs, and the remainder at rp, of dn limbs.  */
+static void
+divisor_qr (mp_ptr qp, mp_ptr rp, mp_srcptr np, mp_size_t nn,
+	    mpz_divisor_t D)
+{
+  mp_size_t dn, qn, in;
+  mp_srcptr d2p;
+  mp_ptr n2p, scratch;
+  mp_limb_t cy;
+  gmp_pi1_t dinv;
+  int adjust, cnt, use_sb, use_dc;
+  TMP_DECL;
+
+  dn = ABSIZ (D->_mp_d);
+  d2p = DIVISOR_D2 (D);
+  cnt = D->_mp_shift;
+
+  ASSERT (nn >= dn);
+
+  TMP_MARK;
+
+  /* The same numerator adjustment as mpn_tdiv_qr, so the quotient fits
+     nn-dn+1 limbs and there's never a high quotient limb to return.  */
+  adjust = np[nn - 1] >= PTR (D->_mp_d)[dn - 1];
+  qp[nn - dn] = 0;
+  n2p = TMP_ALLOC_LIMBS (nn + 1);
+  if (cnt != 0)
+    cy = mpn_lshift (n2p, np, nn, cnt);
+  else
+    {
+      MPN_COPY (n2p, np, nn);
+      cy = 0;
+    }
+  n2p[nn] = cy;
+  nn += adjust;
+  qn = nn - dn;
+
+  /* The algorithm choice of mpn_tdiv_qr.  It goes by dn when nn >= 2dn,
+     but when qn < dn it divides the top 2qn limbs by the top qn of d, and
+     goes by qn.  With no inverse in the table, dn being below
+     MUPI_DIV_QR_THRESHOLD, dcpi1 stands in for mu.  */
+  if (nn >= 2 * dn)
+    {
+      use_sb = BELOW_THRESHOLD (dn, DC_DIV_QR_THRESHOLD);
+      use_dc = D->_mp_in == 0
+	|| BELOW_THRESHOLD (nn, 2 * MU_DIV_QR_THRESHOLD)
+	|| ((double) (2 * (MU_DIV_QR_THRESHOLD - MUPI_DIV_QR_THRESHOLD)) * dn
+	    + (double) MUPI_DIV_QR_THRESHOLD * nn > (double) dn * nn);
+    }
+  else
+    {
+      use_sb = BELOW_THRESHOLD (qn, DC_DIV_QR_THRESHOLD);
+      use_dc = D->_mp_in == 0 || BELOW_THRESHOLD (qn, MU_DIV_QR_THRESHOLD);
+    }
+
+  if (use_sb || qn < 3)
+    mpn_sbpi1_div_qr (qp, n2p, nn, d2p, dn, D->_mp_inv32);
+  else if (use_dc)
+    {
+      dinv.inv32 = D->_mp_inv32;
+      mpn_dcpi1_div_qr (qp, n2p, nn, d2p, dn, &dinv);
+    }
+  else
+    {
+      in = mpn_mu_div_qr_choose_in (qn, dn, 0);
+      scratch = TMP_ALLOC_LIMBS (mpn_preinv_mu_div_qr_itch (nn, dn, in));
+      mpn_preinv_mu_div_qr (qp, rp, n2p, nn, d2p, dn,
+			    DIVISOR_IP (D) + dn - in, in, scratch);
+      n2p = rp;
+    }
+
+  if (cnt != 0)
+    mpn_rshift (rp, n2p, dn, cnt);
+  else
+    MPN_COPY (rp, n2p, dn);
+  TMP_FREE;
+}
+
+void
+mpz_tdiv_qr_pre (mpz_ptr quot, mpz_ptr rem, mpz_srcptr num, mpz_divisor_t D)
+{
+  mp_size_t nn, dn, qn, rn;
+  mp_size_t ns, ds;
+  mp_ptr qp, rp;
+  TMP_DECL;
+
+  ns = SIZ (num);
+  ds = SIZ (D->_mp_d);
+  nn = ABS (ns);
+  dn = ABS (ds);
+
+  if (D->_mp_tab == NULL || nn < dn)
+    {
+      mpz_tdiv_qr (quot, rem, num, D->_mp_d);
+      return;
+    }
+
+  /* Work in temporaries, quot and rem can be num.  */
+  TMP_MARK;
+  qn = nn - dn + 1;
+  TMP_ALLOC_LIMBS_2 (qp, qn, rp, dn);
+  divisor_qr (qp, rp, PTR (num), nn, D);
+
+  qn -= qp[qn - 1] == 0;
+  rn = dn;
+  MPN_NORMALIZE (rp, rn);
+
+  MPN_COPY (MPZ_NEWALLOC (quot, qn), qp, qn);
+  SIZ (quot) = (ns ^ ds) >= 0 ? qn : -qn;
+  MPN_COPY (MPZ_NEWALLOC (rem, rn), rp, rn);
+  SIZ (rem) = ns >= 0 ? rn : -rn;
+  TMP_FREE;
+}
+
+void
+mpz_mod_pre (mpz_ptr rem, mpz_srcptr num, mpz_divisor_t D)
+{
+  mp_size_t nn, dn, rn;
+  mp_ptr qp, rp;
+  TMP_DECL;
+
+  nn = ABSIZ (num);
+  dn = ABSIZ (D->_mp_d);
+
+  if (D->_mp_tab == NULL || nn < dn)
+    {
+      mpz_mod (rem, num, D->_mp_d);
+      return;
+    }
+
+  TMP_MARK;
+  TMP_ALLOC_LIMBS_2 (qp, nn - dn + 1, rp, dn);
+  divisor_qr (qp, rp, PTR (num), nn, D);
+
+  rn = dn;
+  MPN_NORMALIZE (rp, rn);
+  if (SIZ (num) < 0 && rn != 0)
+    {
+      mpn_sub (rp, PTR (D->_mp_d), dn, rp, rn);
+      rn = dn;
+      MPN_NORMALIZE (rp, rn);
+    }
+
+  MPN_COPY (MPZ_NEWALLOC (rem, rn), rp, rn);
+  SIZ (rem) = rn;
+  TMP_FREE;
+}
+
+void
+mpz_divexact_pre (mpz_ptr quot, mpz_srcptr num, mpz_divisor_t D)
+{
+  mp_size_t nn, dn, qn, on, z, sn, b, done;
+  mp_size_t ns, ds;
+  mp_srcptr op, bip;
+  mp_ptr qp, tp, sp;
+  mp_limb_t di;
+  int t;
+  TMP_DECL;
+
+  ns = SIZ (num);
+  ds = SIZ (D->_mp_d);
+  nn = ABS (ns);
+  dn = ABS (ds);
+
+  if (D->_mp_tab == NULL || nn < dn)
+    {
+      mpz_divexact (quot, num, D->_mp_d);
+      return;
+    }
+
+  /* Divide n / 2^(z*GMP_NUMB_BITS + t) by the odd part of d, as a 2-adic
+     division, which needs only the low qn limbs of each.  */
+  on = divisor_odd (D->_mp_d, &z, &t);
+  op = DIVISOR_OP (D);
+  /* The quotient has nn-dn limbs if the top of n is below the top of d,
+     and it's worth knowing, a quotient that fits on limbs is one block.  */
+  qn = nn - dn + (PTR (num)[nn - 1] >= PTR (D->_mp_d)[dn - 1]);
+  if (qn == 0)
+    {
+      SIZ (quot) = 0;
+      return;
+    }
+
+  TMP_MARK;
+  TMP_ALLOC_LIMBS_2 (qp, qn, tp, qn + 1);
+  sn = MIN (qn + 1, nn - z);
+  if (t != 0)
+    mpn_rshift (tp, PTR (num) + z, sn, t);
+  else
+    MPN_COPY (tp, PTR (num) + z, sn);
+
+  if (DIVISOR_BINV_P (MIN (on, qn)))
+    {
+      /* Blocks of on limbs, each a mullo by the inverse, then the block
+	 times d subtracted from what's left.  */
+      bip = op + on;
+      sp = TMP_ALLOC_LIMBS (2 * on);
+      for (done = 0; done < qn; done += b)
+	{
+	  b = MIN (on, qn - done);
+	  mpn_mullo_n (qp + done, tp + done, bip, b);
+	  if (done + b < qn)
+	    {
+	      mpn_mul_n (sp, op, qp + done, b);
+	      mpn_sub (tp + done, tp + done, qn - done,
+		       sp, MIN (2 * b, qn - done));
+	    }
+	}
+    }
+  else
+    {
+      on = MIN (on, qn);
+      if (on == 1)
+	MPN_DIVREM_OR_DIVEXACT_1 (qp, tp, qn, op[0]);
+      else
+	{
+	  /* on is below DC_BDIV_Q_THRESHOLD here, or there'd be an inverse
+	     for the mullo blocks above.  */
+	  binvert_limb (di, op[0]);
+	  di = -di;
+	  mpn_sbpi1_bdiv_q (qp, tp, qn, op, on, di);
+	}
+    }
+
+  qn -= qp[qn - 1] == 0;
+  MPN_COPY (MPZ_NEWALLOC (quot, qn), qp, qn);
+  SIZ (quot) = (ns ^ ds) >= 0 ? qn : -qn;
+  TMP_FREE;
+}
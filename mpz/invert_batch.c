@@ -0,0 +1,346 @@
+/* mpz_invert_batch -- inverses of many numbers modulo one modulus.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include <string.h> /* for memset */
+#include "gmp.h"
+#include "gmp-impl.h"
+
+
+/* Montgomery's trick.  With prefix products c[i] = a[0]...a[i], one
+   inversion u = 1/c[k-1] gives 1/a[i] = u c[i-1], and then u a[i] is
+   1/c[i-1] for the next step down, 3(k-1) multiplications in all.
+
+   For odd m the products are REDCs, M(x,y) = x y / R mod m with R = B^n.
+   Then c[i] is a[0]...a[i] / R^i, and its plain inverse u has a factor
+   R^i which each M(u,a[i]) takes down by one, just as is wanted for the
+   M(u,c[i-1]).  So the a[i] need no conversion to Montgomery form and the
+   results come out plain.  Even m use plain products and division.
+
+   With threads the numbers are split into one chunk per thread.  Each
+   chunk forms its own prefix products, the chunk totals are inverted by
+   the same trick, serially, and then each chunk works down from the
+   inverse of its total.  That's still 3(k-1) multiplications.
+
+   Zeros are set aside at the start.  Any other number with a factor in
+   common with m makes the product non-invertible, and then the numbers
+   are bisected until those are found, which costs an inversion for each
+   piece, but only in that case.  */
+
+struct invert_batch
+{
+  mpz_srcptr m;
+  mp_srcptr mp;
+  mp_size_t n;
+  mp_srcptr ip;			/* REDC inverse, or NULL for even m */
+  mp_ptr ap;			/* the numbers, reduced mod m */
+  mp_ptr cp;			/* prefix products, then inverses */
+  mp_ptr tinv;			/* inverses of the chunk totals */
+  mp_size_t k;
+  mp_size_t chunks;
+};
+
+#define BATCH_ITCH(n)  (4 * (n) + 1)
+
+/* {rp,n} = {xp,n} {yp,n} (/ R) mod m, using 3n+1 limbs at tp.  rp can be
+   xp or yp.  */
+static void
+batch_mulmod (mp_ptr rp, mp_srcptr xp, mp_srcptr yp,
+	      const struct invert_batch *b, mp_ptr tp)
+{
+  mp_size_t n = b->n;
+
+  mpn_mul_n (tp, xp, yp, n);
+  if (b->ip != NULL)
+    {
+      mpn_redc (rp, tp, b->mp, n, b->ip);
+      if (mpn_cmp (rp, b->mp, n) >= 0)
+	mpn_sub_n (rp, rp, b->mp, n);
+    }
+  else
+    mpn_tdiv_qr (tp + 2 * n, rp, 0L, tp, 2 * n, b->mp, n);
+}
+
+static void
+batch_prefix (mp_ptr cp, mp_srcptr ap, mp_size_t k,
+	      const struct invert_batch *b, mp_ptr tp)
+{
+  mp_size_t n = b->n;
+  mp_size_t i;
+
+  MPN_COPY (cp, ap, n);
+  for (i = 1; i < k; i++)
+    batch_mulmod (cp + i * n, cp + (i - 1) * n, ap + i * n, b, tp);
+}
+
+/* With {up,n} the inverse of the last prefix product, replace the prefix
+   products at cp with the inverses of the numbers at ap.  Clobbers up.  */
+static void
+batch_back (mp_ptr cp, mp_srcptr ap, mp_size_t k, mp_ptr up,
+	    const struct invert_batch *b, mp_ptr tp)
+{
+  mp_size_t n = b->n;
+  mp_size_t i;
+
+  for (i = k - 1; i > 0; i--)
+    {
+      batch_mulmod (cp + i * n, up, cp + (i - 1) * n, b, tp);
+      batch_mulmod (up, up, ap + i * n, b, tp);
+    }
+  MPN_COPY (cp, up, n);
+}
+
+/* Set {up,n} to the inverse of {cp,n}, returning 0 if there's none.  */
+static int
+batch_invert_one (mp_ptr up, mp_srcptr cp, const struct invert_batch *b)
+{
+  mp_size_t n = b->n;
+  mpz_t x, t;
+  int ok;
+  TMP_DECL;
+
+  TMP_MARK;
+  MPZ_TMP_INIT (t, n + 1);
+  ok = mpz_invert (t, mpz_roinit_n (x, cp, n), b->m);
+  if (ok)
+    {
+      MPN_COPY (up, PTR (t), SIZ (t));
+      MPN_ZERO (up + SIZ (t), n - SIZ (t));
+    }
+  TMP_FREE;
+  return ok;
+}
+
+/* Invert the k numbers at ap, giving the inverses at cp.  Return 0 if
+   their product isn't invertible, and cp is then garbage.  Uses
+   BATCH_ITCH(n) limbs at tp.  */
+static int
+batch_serial (mp_ptr cp, mp_srcptr ap, mp_size_t k,
+	      const struct invert_batch *b, mp_ptr tp)
+{
+  mp_size_t n = b->n;
+
+  batch_prefix (cp, ap, k, b, tp + n);
+  if (! batch_invert_one (tp, cp + (k - 1) * n, b))
+    return 0;
+  batch_back (cp, ap, k, tp, b, tp + n);
+  return 1;
+}
+
+/* As batch_serial, but bisecting until the non-invertible numbers are
+   isolated, with ok[i] set to whether the i'th was inverted.  */
+static void
+batch_split (mp_ptr cp, mp_srcptr ap, mp_size_t k, char *ok,
+	     const struct invert_batch *b, mp_ptr tp)
+{
+  mp_size_t n = b->n;
+  mp_size_t h;
+
+  if (batch_serial (cp, ap, k, b, tp))
+    {
+      memset (ok, 1, k);
+      return;
+    }
+  if (k == 1)
+    {
+      ok[0] = 0;
+      return;
+    }
+  h = k / 2;
+  batch_split (cp, ap, h, ok, b, tp);
+  batch_split (cp + h * n, ap + h * n, k - h, ok + h, b, tp);
+}
+
+#define CHUNK_START(b,c)  ((b)->k * (c) / (b)->chunks)
+
+static void
+batch_prefix_item (void *arg, mp_size_t c)
+{
+  struct invert_batch *b = (struct invert_batch *) arg;
+  mp_size_t n = b->n;
+  mp_size_t lo, hi;
+  mp_ptr tp;
+  TMP_DECL;
+
+  lo = CHUNK_START (b, c);
+  hi = CHUNK_START (b, c + 1);
+  TMP_MARK;
+  tp = TMP_ALLOC_LIMBS (BATCH_ITCH (n));
+  batch_prefix (b->cp + lo * n, b->ap + lo * n, hi - lo, b, tp);
+  TMP_FREE;
+}
+
+static void
+batch_back_item (void *arg, mp_size_t c)
+{
+  struct invert_batch *b = (struct invert_batch *) arg;
+  mp_size_t n = b->n;
+  mp_size_t lo, hi;
+  mp_ptr tp;
+  TMP_DECL;
+
+  lo = CHUNK_START (b, c);
+  hi = CHUNK_START (b, c + 1);
+  TMP_MARK;
+  tp = TMP_ALLOC_LIMBS (BATCH_ITCH (n));
+  MPN_COPY (tp, b->tinv + c * n, n);
+  batch_back (b->cp + lo * n, b->ap + lo * n, hi - lo, tp, b, tp + n);
+  TMP_FREE;
+}
+
+/* The threaded form of batch_serial.  */
+static int
+batch_parallel (struct invert_batch *b, mp_ptr tp)
+{
+  mp_size_t n = b->n;
+  mp_size_t c;
+  mp_ptr tot;
+  int ok;
+  TMP_DECL;
+
+  __gmp_parallel_run (batch_prefix_item, b, b->chunks);
+
+  TMP_MARK;
+  tot = TMP_ALLOC_LIMBS (b->chunks * n);
+  for (c = 0; c < b->chunks; c++)
+    MPN_COPY (tot + c * n, b->cp + (CHUNK_START (b, c + 1) - 1) * n, n);
+  ok = batch_serial (b->tinv, tot, b->chunks, b, tp);
+  TMP_FREE;
+  if (! ok)
+    return 0;
+
+  __gmp_parallel_run (batch_back_item, b, b->chunks);
+  return 1;
+}
+
+size_t
+mpz_invert_batch (const mpz_ptr *rop, const mpz_srcptr *op, size_t count,
+		  mpz_srcptr mod)
+{
+  struct invert_batch b;
+  mp_size_t n, an, rn, k, j;
+  mp_srcptr mp;
+  mp_ptr tp;
+  size_t *pos;
+  size_t i, done;
+  char *ok;
+  int threads;
+  mpz_t t;
+  TMP_DECL;
+
+  n = ABSIZ (mod);
+  if (UNLIKELY (n == 0))
+    DIVIDE_BY_ZERO;
+  mp = PTR (mod);
+
+  if (count == 0)
+    return 0;
+
+  if (n == 1 && mp[0] == 1)
+    {
+      for (i = 0; i < count; i++)
+	SIZ (rop[i]) = 0;
+      return count;
+    }
+
+  TMP_MARK;
+  b.m = mod;
+  b.mp = mp;
+  b.n = n;
+  TMP_ALLOC_LIMBS_2 (b.ap, count * n, b.cp, count * n);
+  pos = TMP_ALLOC_TYPE (count, size_t);
+  ok = TMP_ALLOC_TYPE (count, char);
+  MPZ_TMP_INIT (t, n + 1);
+
+  /* The numbers reduced to [0,m), with the zeros left out.  Everything's
+     read before any rop is written, so rop[i] can be op[i].  */
+  k = 0;
+  for (i = 0; i < count; i++)
+    {
+      an = SIZ (op[i]);
+      if (LIKELY (an >= 0 && an <= n
+		  && (an < n || mpn_cmp (PTR (op[i]), mp, n) < 0)))
+	{
+	  if (an == 0)
+	    continue;
+	  MPN_COPY (b.ap + k * n, PTR (op[i]), an);
+	}
+      else
+	{
+	  mpz_mod (t, op[i], mod);
+	  an = SIZ (t);
+	  if (an == 0)
+	    continue;
+	  MPN_COPY (b.ap + k * n, PTR (t), an);
+	}
+      MPN_ZERO (b.ap + k * n + an, n - an);
+      pos[k++] = i;
+    }
+
+  tp = TMP_ALLOC_LIMBS (MAX (BATCH_ITCH (n), mpn_binvert_itch (n)));
+  if ((mp[0] & 1) != 0)
+    {
+      b.ip = TMP_ALLOC_LIMBS (n);
+      mpn_redc_inverse ((mp_ptr) b.ip, mp, n, tp);
+    }
+  else
+    b.ip = NULL;
+
+  threads = __gmp_parallel_threads ();
+  b.k = k;
+  b.chunks = MIN (threads, k / 4);
+  if (threads > 1 && b.chunks > 1
+      && k * n >= INVERT_BATCH_PARALLEL_THRESHOLD)
+    {
+      b.tinv = TMP_ALLOC_LIMBS (b.chunks * n);
+      if (batch_parallel (&b, tp))
+	memset (ok, 1, k);
+      else
+	batch_split (b.cp, b.ap, k, ok, &b, tp);
+    }
+  else if (k != 0)
+    batch_split (b.cp, b.ap, k, ok, &b, tp);
+
+  for (i = 0; i < count; i++)
+    SIZ (rop[i]) = 0;
+  done = 0;
+  for (j = 0; j < k; j++)
+    {
+      if (! ok[j])
+	continue;
+      rn = n;
+      MPN_NORMALIZE (b.cp + j * n, rn);
+      MPN_COPY (MPZ_NEWALLOC (rop[pos[j]], rn), b.cp + j * n, rn);
+      SIZ (rop[pos[j]]) = rn;
+      done++;
+    }
+
+  TMP_FREE;
+  return done;
+}
@@ -1,15 +1,16 @@
-/* mpz_millerrabin(n,reps) -- An implementation of the probabilistic primality
-   test found in Knuth's Seminumerical Algorithms book.  If the function
-   mpz_millerrabin() returns 0 then n is not prime.  If it returns 1, then n is
-   'probably' prime.  The probability of a false positive is (1/4)**reps, where
-   reps is the number of internal passes of the probabilistic algorithm.  Knuth
-   indicates that 25 passes are reasonable.
+/* mpz_millerrabin(n,reps) -- A Baillie-PSW probable prime test, followed
+   by Miller-Rabin tests as found in Knuth's Seminumerical Algorithms book.
+   If the function mpz_millerrabin() returns 0 then n is not prime.  If it
+   returns 2, n is below 2^64 and certainly prime, if it returns 1, then n is
+   'probably' prime.  No composite is known to pass the Baillie-PSW test.
+   Beyond that, reps-25 random Miller-Rabin passes are done, each with a
+   probability of a false positive of at most 1/4.
 
    THE FUNCTIONS IN THIS FILE ARE FOR INTERNAL USE ONLY.  THEY'RE ALMOST
    CERTAIN TO BE SUBJECT TO INCOMPATIBLE CHANGES OR DISAPPEAR COMPLETELY IN
    FUTURE GNU MP RELEASES.
 
-Copyright 1991, 1993, 1994, 1996-2002, 2005, 2014 Free Software
+Copyright 1991, 1993, 1994, 1996-2002, 2005, 2014, 2026 Free Software
 Foundation, Inc.
 
 Contributed by John Amanatides.
@@ -47,10 +48,29 @@ static int millerrabin (mpz_srcptr, mpz_srcptr,
 			mpz_ptr, mpz_ptr,
 			mpz_srcptr, unsigned long int);
 
+/* Baillie-PSW is a strong test to base 2 and a strong Lucas test.  There
+   are no base 2 strong pseudoprimes that are also strong Lucas
+   pseudoprimes below 2^64, see Feitsma and Galway's tables of base 2
+   pseudoprimes, so below that it proves primality.  Counting a Lucas test
+   as about three Miller-Rabin tests, it costs about as much as 4 of those,
+   but it's stronger than any number of them, so the first 25 reps are
+   taken as covered.  */
+#define BPSW_REPS  25
+
 int
 mpz_millerrabin (mpz_srcptr n, int reps)
 {
-  int r;
+  return mpz_millerrabin_stop (n, reps, NULL, NULL);
+}
+
+/* A search testing several numbers at once can call off the test of one
+   as soon as another settles the answer, so stop is asked before the
+   Lucas test and before each further Miller-Rabin test.  */
+#define STOP_P(stop, arg)  ((stop) != NULL && (*(stop)) (arg))
+
+int
+mpz_millerrabin_stop (mpz_srcptr n, int reps, int (*stop) (void *), void *arg)
+{
   mpz_t nm1, nm3, x, y, q;
   unsigned long int k;
   gmp_randstate_t rstate;
@@ -64,39 +84,39 @@ mpz_millerrabin (mpz_srcptr n, int reps)
   MPZ_TMP_INIT (x, SIZ (n) + 1);
   MPZ_TMP_INIT (y, 2 * SIZ (n)); /* mpz_powm_ui needs excessive memory!!! */
 
-  /* Perform a Fermat test.  */
-  mpz_set_ui (x, 210L);
-  mpz_powm (y, x, nm1, n);
-  if (mpz_cmp_ui (y, 1L) != 0)
-    {
-      TMP_FREE;
-      return 0;
-    }
-
   MPZ_TMP_INIT (q, SIZ (n));
 
   /* Find q and k, where q is odd and n = 1 + 2**k * q.  */
   k = mpz_scan1 (nm1, 0L);
   mpz_tdiv_q_2exp (q, nm1, k);
 
-  /* n-3 */
-  MPZ_TMP_INIT (nm3, SIZ (n) + 1);
-  mpz_sub_ui (nm3, n, 3L);
-  ASSERT (mpz_cmp_ui (nm3, 1L) >= 0);
+  /* Baillie-PSW */
+  mpz_set_ui (x, 2L);
+  is_prime = millerrabin (n, nm1, x, y, q, k)
+    && ! STOP_P (stop, arg) && mpz_stronglucas (n);
 
-  gmp_randinit_default (rstate);
-
-  is_prime = 1;
-  for (r = 0; r < reps && is_prime; r++)
+  if (is_prime && mpz_sizeinbase (n, 2) <= 64)
+    is_prime = 2;
+  else if (is_prime && reps > BPSW_REPS)
     {
-      /* 2 to n-2 inclusive, don't want 1, 0 or -1 */
-      mpz_urandomm (x, rstate, nm3);
-      mpz_add_ui (x, x, 2L);
+      /* n-3 */
+      MPZ_TMP_INIT (nm3, SIZ (n) + 1);
+      mpz_sub_ui (nm3, n, 3L);
+      ASSERT (mpz_cmp_ui (nm3, 1L) >= 0);
 
-      is_prime = millerrabin (n, nm1, x, y, q, k);
-    }
+      gmp_randinit_default (rstate);
 
-  gmp_randclear (rstate);
+      for (reps -= BPSW_REPS; reps > 0 && is_prime; reps--)
+	{
+	  /* 2 to n-2 inclusive, don't want 1, 0 or -1 */
+	  mpz_urandomm (x, rstate, nm3);
+	  mpz_add_ui (x, x, 2L);
+
+	  is_prime = ! STOP_P (stop, arg) && millerrabin (n, nm1, x, y, q, k);
+	}
+
+      gmp_randclear (rstate);
+    }
 
   TMP_FREE;
   return is_prime;
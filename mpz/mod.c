@@ -35,13 +35,37 @@ see https://www.gnu.org/licenses/.  */
 void
 mpz_mod (mpz_ptr rem, mpz_srcptr dividend, mpz_srcptr divisor)
 {
-  mp_size_t rn, bn;
+  mp_size_t rn, bn, an;
   mpz_t temp_divisor;
+  gmp_2expc_t red;
+  mp_ptr rp, tp, cp;
   TMP_DECL;
 
   TMP_MARK;
 
   bn = ABSIZ(divisor);
+  an = ABSIZ(dividend);
+
+  /* A divisor 2^k - c or 2^k + c with c small is done by folding.
+     mpn_mod_2expc takes a long dividend bn limbs at a time from the top,
+     so it's O(an cn), linear in the dividend for a given c.  */
+  if (an >= bn && bn >= 2)
+    {
+      cp = TMP_ALLOC_LIMBS (bn);
+      if (mpn_mod_2expc_init (&red, cp, PTR(divisor), bn))
+	{
+	  TMP_ALLOC_LIMBS_2 (rp, bn, tp, mpn_mod_2expc_itch (an, bn));
+	  mpn_mod_2expc (rp, PTR(dividend), an, PTR(divisor), bn, &red, tp);
+	  if (SIZ(dividend) < 0 && ! mpn_zero_p (rp, bn))
+	    mpn_sub_n (rp, PTR(divisor), rp, bn);
+	  rn = bn;
+	  MPN_NORMALIZE (rp, rn);
+	  MPN_COPY (MPZ_NEWALLOC (rem, rn), rp, rn);
+	  SIZ(rem) = rn;
+	  TMP_FREE;
+	  return;
+	}
+    }
 
   /* We need the original value of the divisor after the remainder has been
      preliminary calculated.  We have to copy it to temporary space if it's
@@ -0,0 +1,339 @@
+/* mpz_modctx_init, mpz_modctx_clear, mpz_to_mont_ctx, mpz_from_mont_ctx,
+   mpz_mulmod_ctx, mpz_sqrmod_ctx, mpz_powm_ctx -- arithmetic modulo a
+   fixed integer, in Montgomery form.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include <stdio.h> /* for NULL */
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "longlong.h"
+
+
+/* For an odd m > 1 of n limbs, with R = B^n, an x mod m is represented by
+   x R mod m, and a product of two such is brought back with one REDC.
+   The table holds the inverse from mpn_redc_inverse, then R^2 mod m for
+   conversions into that form, then R mod m, the form of 1.  The choice
+   of redc_1, redc_2 or redc_n is fixed by n, and made in mpn_redc.
+
+   All results are fully reduced, 0 <= r < m.  A REDC of a product of two
+   numbers below m is below 2m, so that's one compare and subtract.
+
+   A modulus 2^k - c or 2^k + c with a small c is better reduced by
+   folding with mpn_mod_2expc, and then the table is just c.  Such moduli,
+   even moduli and m = 1 don't use Montgomery form, the "Montgomery form"
+   of x is just x mod m.  Even moduli and m = 1 have no table, and
+   everything goes through mpz_mul and mpz_mod.  */
+
+#define CTX_PLAIN	0
+#define CTX_REDC	1
+#define CTX_2EXPC	2	/* 2^k - c */
+#define CTX_2EXPC_NEG	3	/* 2^k + c */
+
+#define CTX_N(C)	SIZ ((C)->_mp_m)
+#define CTX_IP(C)	((C)->_mp_tab)
+#define CTX_R2(C)	((C)->_mp_tab + CTX_N (C))
+#define CTX_ONE(C)	((C)->_mp_tab + 2 * CTX_N (C))
+
+void
+mpz_modctx_init (mpz_modctx_t C, mpz_srcptr m)
+{
+  mp_size_t n;
+  mp_srcptr mp;
+  mp_ptr tp, qp;
+  gmp_2expc_t red;
+  TMP_DECL;
+
+  n = ABSIZ (m);
+  if (UNLIKELY (n == 0))
+    DIVIDE_BY_ZERO;
+
+  mpz_init (C->_mp_m);
+  mpz_abs (C->_mp_m, m);
+  C->_mp_tab = NULL;
+  C->_mp_red = CTX_PLAIN;
+
+  mp = PTR (C->_mp_m);
+  TMP_MARK;
+  tp = TMP_ALLOC_LIMBS (n);
+  if (mpn_mod_2expc_init (&red, tp, mp, n) && POWM_2EXPC_P (&red, n))
+    {
+      C->_mp_tab = __GMP_ALLOCATE_FUNC_LIMBS (n);
+      MPN_COPY (C->_mp_tab, tp, n);
+      C->_mp_red = red.neg ? CTX_2EXPC_NEG : CTX_2EXPC;
+      TMP_FREE;
+      return;
+    }
+  TMP_FREE;
+
+  if ((mp[0] & 1) == 0 || (n == 1 && mp[0] == 1))
+    return;
+
+  C->_mp_tab = __GMP_ALLOCATE_FUNC_LIMBS (3 * n);
+  C->_mp_red = CTX_REDC;
+
+  TMP_MARK;
+  TMP_ALLOC_LIMBS_2 (tp, MAX (mpn_binvert_itch (n), 2 * n + 1),
+		     qp, n + 2);
+  mpn_redc_inverse (CTX_IP (C), mp, n, tp);
+
+  MPN_ZERO (tp, 2 * n);
+  tp[2 * n] = 1;
+  mpn_tdiv_qr (qp, CTX_R2 (C), 0L, tp, 2 * n + 1, mp, n);
+
+  MPN_ZERO (tp, n);
+  tp[n] = 1;
+  mpn_tdiv_qr (qp, CTX_ONE (C), 0L, tp, n + 1, mp, n);
+  TMP_FREE;
+}
+
+void
+mpz_modctx_clear (mpz_modctx_t C)
+{
+  if (C->_mp_red == CTX_REDC)
+    __GMP_FREE_FUNC_LIMBS (C->_mp_tab, 3 * CTX_N (C));
+  else if (C->_mp_red != CTX_PLAIN)
+    __GMP_FREE_FUNC_LIMBS (C->_mp_tab, CTX_N (C));
+  mpz_clear (C->_mp_m);
+}
+
+/* Set *red for a 2^k - c or 2^k + c modulus, from the c in the table.  */
+static void
+ctx_2expc (gmp_2expc_t *red, mpz_modctx_t C)
+{
+  mp_size_t cn;
+  mp_bitcnt_t mbits;
+
+  cn = CTX_N (C);
+  MPN_NORMALIZE (C->_mp_tab, cn);
+  MPN_SIZEINBASE_2EXP (mbits, PTR (C->_mp_m), CTX_N (C), 1);
+  red->cp = C->_mp_tab;
+  red->cn = cn;
+  red->neg = C->_mp_red == CTX_2EXPC_NEG;
+  red->k = mbits - red->neg;
+}
+
+/* Set {xp,n} to a, which is normally already in [0,m), or else is reduced
+   to it.  */
+static void
+ctx_operand (mp_ptr xp, mpz_srcptr a, mpz_modctx_t C)
+{
+  mp_size_t n, an;
+  mpz_t t;
+  TMP_DECL;
+
+  n = CTX_N (C);
+  an = SIZ (a);
+  if (LIKELY (an >= 0 && an <= n
+	      && (an < n || mpn_cmp (PTR (a), PTR (C->_mp_m), n) < 0)))
+    {
+      MPN_COPY (xp, PTR (a), an);
+      MPN_ZERO (xp + an, n - an);
+      return;
+    }
+
+  TMP_MARK;
+  MPZ_TMP_INIT (t, n + 1);
+  mpz_mod (t, a, C->_mp_m);
+  MPN_COPY (xp, PTR (t), SIZ (t));
+  MPN_ZERO (xp + SIZ (t), n - SIZ (t));
+  TMP_FREE;
+}
+
+/* Set r to the REDC of {tp,2n}, reduced to [0,m).  The caller ensures it's
+   below 2m.  */
+static void
+ctx_redc_set (mpz_ptr r, mp_ptr tp, mpz_modctx_t C)
+{
+  mp_size_t n, rn;
+  mp_srcptr mp;
+  mp_ptr rp;
+
+  n = CTX_N (C);
+  mp = PTR (C->_mp_m);
+  rp = tp + 2 * n;
+  mpn_redc (rp, tp, mp, n, CTX_IP (C));
+  if (mpn_cmp (rp, mp, n) >= 0)
+    mpn_sub_n (rp, rp, mp, n);
+
+  rn = n;
+  MPN_NORMALIZE (rp, rn);
+  MPN_COPY (MPZ_NEWALLOC (r, rn), rp, rn);
+  SIZ (r) = rn;
+}
+
+void
+mpz_to_mont_ctx (mpz_ptr r, mpz_srcptr a, mpz_modctx_t C)
+{
+  mp_size_t n;
+  mp_ptr tp;
+  TMP_DECL;
+
+  if (C->_mp_red != CTX_REDC)
+    {
+      mpz_mod (r, a, C->_mp_m);
+      return;
+    }
+
+  n = CTX_N (C);
+  TMP_MARK;
+  tp = TMP_ALLOC_LIMBS (4 * n);
+  ctx_operand (tp + 2 * n, a, C);
+  mpn_mul_n (tp, tp + 2 * n, CTX_R2 (C), n);
+  ctx_redc_set (r, tp, C);
+  TMP_FREE;
+}
+
+void
+mpz_from_mont_ctx (mpz_ptr r, mpz_srcptr a, mpz_modctx_t C)
+{
+  mp_size_t n;
+  mp_ptr tp;
+  TMP_DECL;
+
+  if (C->_mp_red != CTX_REDC)
+    {
+      mpz_mod (r, a, C->_mp_m);
+      return;
+    }
+
+  n = CTX_N (C);
+  TMP_MARK;
+  tp = TMP_ALLOC_LIMBS (3 * n);
+  ctx_operand (tp, a, C);
+  MPN_ZERO (tp + n, n);
+  ctx_redc_set (r, tp, C);
+  TMP_FREE;
+}
+
+void
+mpz_mulmod_ctx (mpz_ptr r, mpz_srcptr a, mpz_srcptr b, mpz_modctx_t C)
+{
+  mp_size_t n, rn;
+  mp_ptr tp, ap, bp, rp;
+  gmp_2expc_t red;
+  TMP_DECL;
+
+  if (C->_mp_red == CTX_PLAIN)
+    {
+      mpz_mul (r, a, b);
+      mpz_mod (r, r, C->_mp_m);
+      return;
+    }
+
+  n = CTX_N (C);
+  TMP_MARK;
+  tp = TMP_ALLOC_LIMBS (5 * n);
+  ap = tp + 3 * n;
+  bp = tp + 4 * n;
+  ctx_operand (ap, a, C);
+  if (b == a)
+    mpn_sqr (tp, ap, n);
+  else
+    {
+      ctx_operand (bp, b, C);
+      mpn_mul_n (tp, ap, bp, n);
+    }
+
+  if (C->_mp_red == CTX_REDC)
+    ctx_redc_set (r, tp, C);
+  else
+    {
+      ctx_2expc (&red, C);
+      rp = tp + 2 * n;
+      mpn_mod_2expc (rp, tp, 2 * n, PTR (C->_mp_m), n, &red,
+		     TMP_ALLOC_LIMBS (mpn_mod_2expc_itch (2 * n, n)));
+      rn = n;
+      MPN_NORMALIZE (rp, rn);
+      MPN_COPY (MPZ_NEWALLOC (r, rn), rp, rn);
+      SIZ (r) = rn;
+    }
+  TMP_FREE;
+}
+
+void
+mpz_sqrmod_ctx (mpz_ptr r, mpz_srcptr a, mpz_modctx_t C)
+{
+  mpz_mulmod_ctx (r, a, a, C);
+}
+
+void
+mpz_powm_ctx (mpz_ptr r, mpz_srcptr b, mpz_srcptr e, mpz_modctx_t C)
+{
+  mp_size_t n, en;
+  mp_ptr tp, bp;
+  mp_srcptr bq, ep;
+  mpz_t t;
+  TMP_DECL;
+
+  if (C->_mp_red != CTX_REDC)
+    {
+      mpz_powm (r, b, e, C->_mp_m);
+      return;
+    }
+
+  n = CTX_N (C);
+  en = SIZ (e);
+  if (en == 0)
+    {
+      MPN_COPY (MPZ_NEWALLOC (r, n), CTX_ONE (C), n);
+      MPN_NORMALIZE (PTR (r), n);
+      SIZ (r) = n;
+      return;
+    }
+
+  TMP_MARK;
+  tp = TMP_ALLOC_LIMBS (4 * n);
+  bp = tp + 3 * n;
+  if (en < 0)
+    {
+      /* (b/R)^-1 R = R^2 / b, by way of plain form */
+      MPZ_TMP_INIT (t, n + 1);
+      mpz_from_mont_ctx (t, b, C);
+      if (UNLIKELY (! mpz_invert (t, t, C->_mp_m)))
+	DIVIDE_BY_ZERO;
+      mpz_to_mont_ctx (t, t, C);
+      ctx_operand (bp, t, C);
+      en = -en;
+    }
+  else
+    ctx_operand (bp, b, C);
+
+  bq = bp;
+  ep = PTR (e);
+  mpn_powm_multi_redc (tp, &bq, &ep, &en, 1,
+		       PTR (C->_mp_m), n, CTX_IP (C));
+
+  /* That's below B^n, but not necessarily below 2m.  REDC of its product
+     with R mod m is the same number, and below 2m.  */
+  MPN_COPY (bp, tp, n);
+  mpn_mul_n (tp, bp, CTX_ONE (C), n);
+  ctx_redc_set (r, tp, C);
+  TMP_FREE;
+}
@@ -0,0 +1,110 @@
+/* mpz_mul_precomp_init, mpz_mul_precomp, mpz_mul_precomp_clear -- repeated
+   multiplication by a fixed integer.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include <stdio.h> /* for NULL */
+#include "gmp.h"
+#include "gmp-impl.h"
+
+
+/* When both operands are in FFT range, b is transformed once for each of
+   the mpn_mul_fft calls in an mpn_mulmod_bnm1 of a size fit for products
+   with a of up to amax limbs.  That size is at least amax+bn, so the
+   product mod B^rn-1 is the full product.
+
+   Each multiplication then does one forward and one inverse transform
+   where mpz_mul would do three.  Operands a good deal smaller than the
+   amax given at init would be better off with an FFT of their own size,
+   so they, and everything below the FFT threshold, go to mpz_mul.  */
+
+void
+mpz_mul_precomp_init (mpz_mul_precomp_t P, mpz_srcptr b, mp_bitcnt_t abits)
+{
+  mp_size_t amax, bn, rn;
+
+  mpz_init_set (P->_mp_b, b);
+  amax = MAX (BITS_TO_LIMBS (abits), 1);
+  bn = ABSIZ (b);
+  P->_mp_amax = amax;
+  P->_mp_fft = NULL;
+
+  if (BELOW_THRESHOLD (MIN (amax, bn), MUL_FFT_THRESHOLD))
+    return;
+
+  rn = mpn_mulmod_bnm1_next_size (amax + bn);
+  P->_mp_fft = mpn_mulmod_bnm1_precomp_init (rn, PTR (b), bn);
+}
+
+void
+mpz_mul_precomp (mpz_ptr r, mpz_srcptr a, mpz_mul_precomp_t P)
+{
+  mp_size_t an, bn, rn, pn, sign_product;
+  mp_ptr rp, tp;
+  TMP_DECL;
+
+  an = ABSIZ (a);
+  bn = ABSIZ (P->_mp_b);
+  if (P->_mp_fft == NULL || an > P->_mp_amax
+      || BELOW_THRESHOLD (an, MUL_FFT_THRESHOLD))
+    goto plain;
+  rn = mpn_mulmod_bnm1_next_size (P->_mp_amax + bn);
+  if (3 * (an + bn) < 2 * rn)
+    goto plain;
+
+  sign_product = SIZ (a) ^ SIZ (P->_mp_b);
+  pn = an + bn;
+
+  TMP_MARK;
+  tp = TMP_ALLOC_LIMBS (mpn_mulmod_bnm1_itch (rn, MAX (an, bn), MIN (an, bn)));
+  if (r == a)
+    rp = TMP_ALLOC_LIMBS (pn);
+  else
+    rp = MPZ_NEWALLOC (r, pn);
+
+  mpn_mulmod_bnm1_precomp (rp, rn, PTR (a), an, PTR (P->_mp_b), bn,
+			   (const struct mul_fft_precomp *) P->_mp_fft, tp);
+  pn -= rp[pn - 1] == 0;
+
+  if (r == a)
+    MPN_COPY (MPZ_NEWALLOC (r, pn), rp, pn);
+  SIZ (r) = sign_product >= 0 ? pn : -pn;
+  TMP_FREE;
+  return;
+
+ plain:
+  mpz_mul (r, a, P->_mp_b);
+}
+
+void
+mpz_mul_precomp_clear (mpz_mul_precomp_t P)
+{
+  mpn_mulmod_bnm1_precomp_clear ((struct mul_fft_precomp *) P->_mp_fft);
+  mpz_clear (P->_mp_b);
+}
@@ -1,6 +1,7 @@
 /* mpz_nextprime(p,t) - compute the next prime > t and store that in p.
+   mpz_prevprime(p,t) - compute the previous prime < t and store that in p.
 
-Copyright 1999-2001, 2008, 2009, 2012 Free Software Foundation, Inc.
+Copyright 1999-2001, 2008, 2009, 2012, 2026 Free Software Foundation, Inc.
 
 Contributed to the GNU project by Niels Möller and Torbjorn Granlund.
 
@@ -30,11 +31,28 @@ You should have received copies of the GNU General Public License and the
 GNU Lesser General Public License along with the GNU MP Library.  If not,
 see https://www.gnu.org/licenses/.  */
 
+#include <string.h> /* for memset */
 #include "gmp.h"
 #include "gmp-impl.h"
 #include "longlong.h"
 
-static const unsigned char primegap[] =
+/* The candidates p, p+2, p+4, ... (or downwards) are taken a window at a
+   time.  Each window is sieved with the odd primes up to a bound depending
+   on the size of p, and the survivors get the Baillie-PSW test of
+   mpz_millerrabin.
+
+   The sieving primes come from gmp_primeiter_next.  With primes up to L, a
+   fraction of about 1.12/log(L) of the odd candidates survive, and each
+   survivor costs a strong test to base 2, so L should grow with the size.
+   The residues of p modulo the primes are computed once, a limb's worth
+   of primes per mpn_mod_1, and stepped along from window to window.
+
+   The window is sized so that it nearly always contains a prime, and the
+   next window is very rarely needed.  */
+
+#define NUMBER_OF_PRIMES 167
+
+static const unsigned char primegap_small[] =
 {
   2,2,4,2,4,2,4,6,2,6,4,2,4,6,6,2,6,4,2,6,4,6,8,4,2,4,2,4,14,4,6,
   2,10,2,6,6,4,6,6,2,10,2,4,2,12,12,4,2,4,6,2,10,6,6,6,2,6,4,2,10,14,4,2,
@@ -44,86 +62,270 @@ static const unsigned char primegap[] =
   6,14,4,6,6,8,6,12
 };
 
-#define NUMBER_OF_PRIMES 167
+/* Primes up to SIEVE_LIMIT_MAX take 8 bytes each, about 8 Mbyte.  */
+#define SIEVE_LIMIT_MAX  (CNST_LIMB(1) << 24)
 
-void
-mpz_nextprime (mpz_ptr p, mpz_srcptr n)
+/* Balancing the primes L/log(L) divisions of a window, against the tests
+   saved, which cost O(nbits^2.6) for mid-size multiplication, gives a bound
+   of about nbits^2.5 / 124.  */
+static mp_limb_t
+sieve_limit (mp_bitcnt_t nbits)
+{
+  mp_limb_t s;
+
+  if (nbits >= 5300)
+    return SIEVE_LIMIT_MAX;
+  for (s = 1; (s + 1) * (s + 1) <= nbits; s++)
+    ;
+  return MAX (nbits * nbits * s / 124, 1000);
+}
+
+/* Odd candidates in a window.  Below 2^32 and 2^64 the largest prime gaps
+   are 336 and 1550, above that 5 nbits is a gap of merit 14.  */
+static mp_size_t
+window_odds (mp_bitcnt_t nbits)
 {
-  unsigned short *moduli;
+  if (nbits <= 32)
+    return 336 / 2;
+  else if (nbits <= 64)
+    return 1550 / 2;
+  else
+    return 5 * nbits;
+}
+
+
+/* With threads, the candidates left by the sieve are tested in batches of
+   a few per thread by mpz_millerrabin_first, where a test is called off
+   as soon as a lower candidate in the batch is found prime.  The prime
+   returned is always the first, the same as serially.  */
+
+#define PRIME_SEARCH_BATCH(threads)  (4 * (threads))
+
+/* Test the n candidates at cand, odd steps from p, on the given number of
+   threads.  For the first probable prime, set p to it and return as
+   mpz_millerrabin.  If there's none return 0, with p unchanged.  */
+static int
+search_parallel (mpz_ptr p, const mp_size_t *cand, mp_size_t n, int up,
+		 int threads)
+{
+  mp_size_t i, j, k, batch;
   unsigned long difference;
-  int i;
-  unsigned prime_limit;
-  unsigned long prime;
-  mp_size_t pn;
-  mp_bitcnt_t nbits;
-  unsigned incr;
-  TMP_SDECL;
+  mpz_t *c;
+  mpz_srcptr *cp;
+  int is_prime;
+  TMP_DECL;
 
-  /* First handle tiny numbers */
-  if (mpz_cmp_ui (n, 2) < 0)
+  TMP_MARK;
+  batch = PRIME_SEARCH_BATCH (threads);
+  c = TMP_ALLOC_TYPE (batch, mpz_t);
+  cp = TMP_ALLOC_TYPE (batch, mpz_srcptr);
+  for (j = 0; j < batch; j++)
     {
-      mpz_set_ui (p, 2);
-      return;
+      mpz_init2 (c[j], mpz_sizeinbase (p, 2) + 1);
+      cp[j] = c[j];
     }
-  mpz_add_ui (p, n, 1);
-  mpz_setbit (p, 0);
 
-  if (mpz_cmp_ui (p, 7) <= 0)
-    return;
+  is_prime = 0;
+  for (i = 0; i < n && is_prime == 0; i += batch)
+    {
+      k = MIN (batch, n - i);
+      for (j = 0; j < k; j++)
+	{
+	  difference = 2 * (unsigned long) cand[i + j];
+	  if (up)
+	    mpz_add_ui (c[j], p, difference);
+	  else
+	    mpz_sub_ui (c[j], p, difference);
+	}
+
+      j = mpz_millerrabin_first (&is_prime, cp, k, 25);
+      if (j < k)
+	mpz_swap (p, c[j]);
+    }
+
+  for (j = 0; j < batch; j++)
+    mpz_clear (c[j]);
+  TMP_FREE;
+  return is_prime;
+}
+
+/* Set p to the first probable prime among p, p+2, p+4, ... if up is
+   non-zero, or p, p-2, p-4, ... if it's zero.  p must be odd and at least
+   9.  Return as mpz_millerrabin.  */
+static int
+findprime (mpz_ptr p, int up)
+{
+  unsigned *primes, *res;
+  mp_size_t np, i, j, k, w, pn;
+  mp_size_t *cand;
+  mp_bitcnt_t nbits;
+  mp_limb_t lim, q, r, m, prod, hi, lo, step;
+  unsigned long difference;
+  char *composite;
+  int is_prime, threads;
+  TMP_DECL;
+
+  TMP_MARK;
+  pn = SIZ (p);
+  MPN_SIZEINBASE_2EXP (nbits, PTR (p), pn, 1);
+  ASSERT (mpz_odd_p (p));
+  ASSERT (nbits >= 4);
 
-  pn = SIZ(p);
-  MPN_SIZEINBASE_2EXP(nbits, PTR(p), pn, 1);
-  if (nbits / 2 >= NUMBER_OF_PRIMES)
-    prime_limit = NUMBER_OF_PRIMES - 1;
+  /* The sieving primes.  For small p there are few enough of them that
+     none is p itself, or above the prime to be found.  */
+  if (nbits / 2 <= NUMBER_OF_PRIMES)
+    {
+      np = nbits / 2;
+      primes = TMP_ALLOC_TYPE (np, unsigned);
+      q = 3;
+      for (i = 0; i < np; i++)
+	{
+	  primes[i] = q;
+	  q += primegap_small[i];
+	}
+    }
   else
-    prime_limit = nbits / 2;
+    {
+      gmp_primeiter_t it;
+      int cnt;
 
-  TMP_SMARK;
+      /* pi(x) < 1.26 x / ln x, less than 2 x / (b-1) for x of b bits */
+      lim = sieve_limit (nbits);
+      count_leading_zeros (cnt, lim);
+      primes = TMP_ALLOC_TYPE (2 * lim / (GMP_LIMB_BITS - 1 - cnt), unsigned);
+      gmp_primeiter_init (it, 3, lim);
+      for (np = 0; (q = gmp_primeiter_next (it)) != 0; np++)
+	primes[np] = q;
+      gmp_primeiter_clear (it);
+    }
+
+  /* p mod each prime, from p mod products of primes */
+  res = TMP_ALLOC_TYPE (np, unsigned);
+  for (i = 0; i < np; i = j)
+    {
+      prod = primes[i];
+      for (j = i + 1; j < np; j++)
+	{
+	  umul_ppmm (hi, lo, prod, (mp_limb_t) primes[j]);
+	  if (hi != 0)
+	    break;
+	  prod = lo;
+	}
+      r = mpn_mod_1 (PTR (p), pn, prod);
+      for (; i < j; i++)
+	res[i] = r % primes[i];
+    }
 
-  /* Compute residues modulo small odd primes */
-  moduli = TMP_SALLOC_TYPE (prime_limit * sizeof moduli[0], unsigned short);
+  w = window_odds (nbits);
+  composite = TMP_ALLOC_TYPE (w, char);
+
+  threads = __gmp_parallel_threads ();
+  if (threads > 1 && pn >= NEXTPRIME_PARALLEL_THRESHOLD)
+    cand = TMP_ALLOC_TYPE (w, mp_size_t);
+  else
+    cand = NULL;
 
   for (;;)
     {
-      /* FIXME: Compute lazily? */
-      prime = 3;
-      for (i = 0; i < prime_limit; i++)
+      memset (composite, 0, w);
+      for (i = 0; i < np; i++)
 	{
-	  moduli[i] = mpz_fdiv_ui (p, prime);
-	  prime += primegap[i];
+	  q = primes[i];
+	  /* Distance to the next multiple of q, in the search direction,
+	     and then to the next odd one, counted in odd steps.  */
+	  m = up ? (q - res[i]) % q : res[i];
+	  if (m & 1)
+	    m += q;
+	  for (m >>= 1; m < w; m += q)
+	    composite[m] = 1;
 	}
 
-#define INCR_LIMIT 0x10000	/* deep science */
-
-      for (difference = incr = 0; incr < INCR_LIMIT; difference += 2)
+      if (cand != NULL)
 	{
-	  /* First check residues */
-	  prime = 3;
-	  for (i = 0; i < prime_limit; i++)
+	  for (j = k = 0; j < w; j++)
+	    if (! composite[j])
+	      cand[k++] = j;
+	  is_prime = search_parallel (p, cand, k, up, threads);
+	  if (is_prime)
 	    {
-	      unsigned r;
-	      /* FIXME: Reduce moduli + incr and store back, to allow for
-		 division-free reductions.  Alternatively, table primes[]'s
-		 inverses (mod 2^16).  */
-	      r = (moduli[i] + incr) % prime;
-	      prime += primegap[i];
-
-	      if (r == 0)
-		goto next;
+	      TMP_FREE;
+	      return is_prime;
 	    }
-
-	  mpz_add_ui (p, p, difference);
+	  difference = 2 * (unsigned long) w;
+	}
+      else
+	{
 	  difference = 0;
+	  for (j = 0; j < w; j++, difference += 2)
+	    {
+	      if (composite[j])
+		continue;
+
+	      if (up)
+		mpz_add_ui (p, p, difference);
+	      else
+		mpz_sub_ui (p, p, difference);
+	      difference = 0;
+
+	      is_prime = mpz_millerrabin (p, 25);
+	      if (is_prime)
+		{
+		  TMP_FREE;
+		  return is_prime;
+		}
+	    }
+	}
 
-	  /* Miller-Rabin test */
-	  if (mpz_millerrabin (p, 25))
-	    goto done;
-	next:;
-	  incr += 2;
+      /* On to the next window, very rare */
+      if (up)
+	mpz_add_ui (p, p, difference);
+      else
+	mpz_sub_ui (p, p, difference);
+      for (i = 0; i < np; i++)
+	{
+	  q = primes[i];
+	  step = (2 * (mp_limb_t) w) % q;
+	  r = up ? res[i] + step : res[i] + q - step;
+	  res[i] = r >= q ? r - q : r;
 	}
-      mpz_add_ui (p, p, difference);
-      difference = 0;
     }
- done:
-  TMP_SFREE;
+}
+
+void
+mpz_nextprime (mpz_ptr p, mpz_srcptr n)
+{
+  /* First handle tiny numbers */
+  if (mpz_cmp_ui (n, 2) < 0)
+    {
+      mpz_set_ui (p, 2);
+      return;
+    }
+  mpz_add_ui (p, n, 1);
+  mpz_setbit (p, 0);
+
+  if (mpz_cmp_ui (p, 7) <= 0)
+    return;
+
+  findprime (p, 1);
+}
+
+int
+mpz_prevprime (mpz_ptr p, mpz_srcptr n)
+{
+  /* First handle tiny numbers */
+  if (mpz_cmp_ui (n, 3) <= 0)
+    {
+      if (mpz_cmp_ui (n, 3) < 0)
+	return 0;
+      mpz_set_ui (p, 2);
+      return 2;
+    }
+  mpz_sub_ui (p, n, 1);
+  if (mpz_even_p (p))
+    mpz_sub_ui (p, p, 1);
+
+  if (mpz_cmp_ui (p, 7) <= 0)
+    return 2;
+
+  return findprime (p, 0);
 }
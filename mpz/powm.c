@@ -68,6 +68,7 @@ mpz_powm (mpz_ptr r, mpz_srcptr b, mpz_srcptr e, mpz_srcptr m)
   mp_srcptr bp, ep, mp;
   mp_size_t rn, bn, es, en, itch;
   mpz_t new_b;			/* note: value lives long via 'b' */
+  gmp_2expc_t red;
   TMP_DECL;
 
   n = ABSIZ(m);
@@ -150,6 +151,19 @@ mpz_powm (mpz_ptr r, mpz_srcptr b, mpz_srcptr e, mpz_srcptr m)
       goto ret;
     }
 
+  /* m = 2^k - c or 2^k + c with c small, reduce by folding.  That works on
+     plain residues and needs no inverse, so an even m is taken whole,
+     without the split into an odd part and a power of 2 below.  */
+  tp = TMP_ALLOC_LIMBS (n);
+  if (mpn_mod_2expc_init (&red, tp, mp, n) && POWM_2EXPC_P (&red, n))
+    {
+      rp = TMP_ALLOC_LIMBS (n);
+      bp = PTR(b);
+      mpn_powm_2expc (rp, bp, bn, ep, en, mp, n, &red);
+      rn = n;
+      goto neg;
+    }
+
   /* Remove low zero limbs from M.  This loop will terminate for correctly
      represented mpz numbers.  */
   ncnt = 0;
@@ -265,6 +279,7 @@ mpz_powm (mpz_ptr r, mpz_srcptr b, mpz_srcptr e, mpz_srcptr m)
       ASSERT (nodd + ncnt <= n + 1);
     }
 
+ neg:
   MPN_NORMALIZE (rp, rn);
 
   if ((ep[0] & 1) && SIZ(b) < 0 && rn != 0)
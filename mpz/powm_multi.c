@@ -0,0 +1,115 @@
+/* mpz_powm_multi -- product of several powers modulo an integer.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "gmp.h"
+#include "gmp-impl.h"
+
+
+/* Odd moduli go to mpn_powm_multi, with negative exponents turned into
+   positive ones of the inverse, the same as mpz_powm does.  Even moduli
+   are rare enough in this sort of use that they simply multiply together
+   separate mpz_powm results.  */
+
+void
+mpz_powm_multi (mpz_ptr r, const mpz_srcptr *b, const mpz_srcptr *e,
+		size_t k, mpz_srcptr m)
+{
+  mp_size_t n, rn, i, j;
+  mp_srcptr mp;
+  mp_ptr rp, bq;
+  mp_srcptr *bpp, *epp;
+  mp_size_t *enp;
+  mpz_t t;
+  TMP_DECL;
+
+  n = ABSIZ (m);
+  if (UNLIKELY (n == 0))
+    DIVIDE_BY_ZERO;
+  mp = PTR (m);
+
+  if ((mp[0] & 1) == 0)
+    {
+      mpz_t acc;
+      mpz_init_set_ui (acc, 1);
+      mpz_init (t);
+      for (i = 0; i < k; i++)
+	{
+	  mpz_powm (t, b[i], e[i], m);
+	  mpz_mul (acc, acc, t);
+	  mpz_tdiv_r (acc, acc, m);
+	}
+      mpz_mod (r, acc, m);
+      mpz_clear (t);
+      mpz_clear (acc);
+      return;
+    }
+
+  if (n == 1 && mp[0] == 1)
+    {
+      SIZ (r) = 0;
+      return;
+    }
+
+  TMP_MARK;
+  bpp = TMP_ALLOC_TYPE (MAX (k, 1), mp_srcptr);
+  epp = TMP_ALLOC_TYPE (MAX (k, 1), mp_srcptr);
+  enp = TMP_ALLOC_TYPE (MAX (k, 1), mp_size_t);
+  TMP_ALLOC_LIMBS_2 (rp, n, bq, MAX (k, 1) * n);
+  MPZ_TMP_INIT (t, n + 1);
+
+  /* The bases reduced mod m, and inverted for negative exponents.  Zero
+     exponents are left out.  */
+  for (i = j = 0; i < k; i++)
+    {
+      if (SIZ (e[i]) == 0)
+	continue;
+      if (SIZ (e[i]) < 0)
+	{
+	  if (UNLIKELY (! mpz_invert (t, b[i], m)))
+	    DIVIDE_BY_ZERO;
+	}
+      else
+	mpz_mod (t, b[i], m);
+      MPN_COPY (bq + j * n, PTR (t), SIZ (t));
+      MPN_ZERO (bq + j * n + SIZ (t), n - SIZ (t));
+      bpp[j] = bq + j * n;
+      epp[j] = PTR (e[i]);
+      enp[j] = ABSIZ (e[i]);
+      j++;
+    }
+
+  mpn_powm_multi (rp, bpp, epp, enp, j, mp, n);
+
+  rn = n;
+  MPN_NORMALIZE (rp, rn);
+  MPN_COPY (MPZ_NEWALLOC (r, rn), rp, rn);
+  SIZ (r) = rn;
+  TMP_FREE;
+}
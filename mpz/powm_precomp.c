@@ -0,0 +1,231 @@
+/* mpz_powm_precomp_init, mpz_powm_precomp, mpz_powm_precomp_clear --
+   modular exponentiation of a fixed base.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include <stdio.h> /* for NULL */
+#include "gmp.h"
+#include "gmp-impl.h"
+
+
+/* This is the Lim-Lee comb with a single table.  Exponents of up to ebits
+   bits are cut into h rows of a = ceil(ebits/h) bits,
+
+       e = e[0] + e[1] 2^a + ... + e[h-1] 2^((h-1)a)
+
+   and with g[i] = b^(2^(ia)) the table has, for each 0 <= j < 2^h, the
+   product of the g[i] with bit i set in j.  Bit k of all the rows together
+   then picks one table entry, and
+
+       b^e = prod_{k=a-1..0} T[column k] ^ (2^k)
+
+   takes a-1 squarings and at most a multiplications, left to right.  A
+   sliding window needs ebits squarings and around ebits/(w+1)
+   multiplications, so the comb's saving in squarings is h.
+
+   Everything is kept in REDC form, reduced with mpn_redc.  */
+
+/* The table has 2^h entries of n limbs.  Going from h to h+1 doubles it,
+   and saves a factor (h+1)/h in the per-exponent work.  This stops at 256
+   entries, reached for exponents of 2048 bits.  */
+#define POWM_PRECOMP_MAX_TEETH 8
+
+static int
+powm_precomp_teeth (mp_bitcnt_t ebits)
+{
+  int h;
+  for (h = 1; h < POWM_PRECOMP_MAX_TEETH; h++)
+    if (((mp_bitcnt_t) 16 << h) > ebits)
+      break;
+  return h;
+}
+
+void
+mpz_powm_precomp_init (mpz_powm_precomp_t P, mpz_srcptr b, mpz_srcptr m,
+		       mp_bitcnt_t ebits)
+{
+  mp_size_t n, bn, i, j, k, a;
+  mp_srcptr mp;
+  mp_ptr mip, tab, tp, qp;
+  int h;
+  TMP_DECL;
+
+  mpz_init_set (P->_mp_b, b);
+  mpz_init_set (P->_mp_m, m);
+  P->_mp_ebits = ebits;
+  P->_mp_h = 0;
+  P->_mp_tab = NULL;
+
+  /* Even moduli and the trivial ones are left to mpz_powm.  */
+  n = ABSIZ (m);
+  mp = PTR (P->_mp_m);
+  if (n == 0 || (mp[0] & 1) == 0 || (n == 1 && mp[0] == 1) || ebits == 0)
+    return;
+
+  h = powm_precomp_teeth (ebits);
+  a = (ebits + h - 1) / h;
+  P->_mp_h = h;
+  P->_mp_tab = tab = __GMP_ALLOCATE_FUNC_LIMBS (n + (n << h));
+  mip = tab;
+  tab += n;
+
+  bn = ABSIZ (b);
+  TMP_MARK;
+  TMP_ALLOC_LIMBS_2 (tp, MAX (mpn_binvert_itch (n), MAX (bn, 1) + n),
+		     qp, MAX (bn, 1) + 1);
+
+  mpn_redc_inverse (mip, mp, n, tp);
+
+  /* T[0] = B^n mod m, the REDC form of 1 */
+  MPN_ZERO (tp, n);
+  tp[n] = 1;
+  mpn_tdiv_qr (qp, tab, 0L, tp, n + 1, mp, n);
+
+  /* T[1] = B^n b mod m */
+  if (bn == 0)
+    MPN_ZERO (tab + n, n);
+  else
+    {
+      MPN_ZERO (tp, n);
+      MPN_COPY (tp + n, PTR (b), bn);
+      mpn_tdiv_qr (qp, tab + n, 0L, tp, bn + n, mp, n);
+      if (SIZ (b) < 0 && ! mpn_zero_p (tab + n, n))
+	mpn_sub_n (tab + n, mp, tab + n, n);
+    }
+  TMP_FREE;
+
+  TMP_MARK;
+  tp = TMP_ALLOC_LIMBS (2 * n);
+
+  /* T[2^i] = g[i] = g[i-1]^(2^a) */
+  for (i = 1; i < h; i++)
+    {
+      MPN_COPY (tab + (n << i), tab + (n << (i - 1)), n);
+      for (k = 0; k < a; k++)
+	{
+	  mpn_sqr (tp, tab + (n << i), n);
+	  mpn_redc (tab + (n << i), tp, mp, n, mip);
+	}
+    }
+
+  /* T[2^i + j] = g[i] T[j] */
+  for (i = 1; i < h; i++)
+    for (j = 1; j < ((mp_size_t) 1 << i); j++)
+      {
+	mpn_mul_n (tp, tab + (n << i), tab + n * j, n);
+	mpn_redc (tab + n * ((1 << i) + j), tp, mp, n, mip);
+      }
+  TMP_FREE;
+}
+
+/* Bit k of each of the h rows of a bits in {ep,en}.  */
+static mp_size_t
+powm_precomp_column (mp_srcptr ep, mp_size_t en, mp_bitcnt_t k,
+		     mp_bitcnt_t a, int h)
+{
+  mp_size_t idx;
+  mp_limb_t bit;
+  mp_bitcnt_t pos;
+  int i;
+
+  idx = 0;
+  for (i = 0, pos = k; i < h && pos / GMP_NUMB_BITS < en; i++, pos += a)
+    {
+      bit = (ep[pos / GMP_NUMB_BITS] >> (pos % GMP_NUMB_BITS)) & 1;
+      idx |= (mp_size_t) bit << i;
+    }
+  return idx;
+}
+
+void
+mpz_powm_precomp (mpz_ptr r, mpz_srcptr e, mpz_powm_precomp_t P)
+{
+  mp_size_t n, en, rn, idx;
+  mp_bitcnt_t a, k;
+  mp_srcptr mp, ep, mip, tab;
+  mp_ptr rp, tp;
+  int h;
+  TMP_DECL;
+
+  h = P->_mp_h;
+  en = SIZ (e);
+  if (h == 0 || en <= 0 || mpz_sizeinbase (e, 2) > P->_mp_ebits)
+    {
+      mpz_powm (r, P->_mp_b, e, P->_mp_m);
+      return;
+    }
+
+  n = ABSIZ (P->_mp_m);
+  mp = PTR (P->_mp_m);
+  ep = PTR (e);
+  mip = P->_mp_tab;
+  tab = P->_mp_tab + n;
+  a = (P->_mp_ebits + h - 1) / h;
+
+  TMP_MARK;
+  TMP_ALLOC_LIMBS_2 (rp, n, tp, 2 * n);
+
+  idx = powm_precomp_column (ep, en, a - 1, a, h);
+  MPN_COPY (rp, tab + n * idx, n);
+
+  for (k = a - 1; k-- > 0; )
+    {
+      mpn_sqr (tp, rp, n);
+      mpn_redc (rp, tp, mp, n, mip);
+      idx = powm_precomp_column (ep, en, k, a, h);
+      if (idx != 0)
+	{
+	  mpn_mul_n (tp, rp, tab + n * idx, n);
+	  mpn_redc (rp, tp, mp, n, mip);
+	}
+    }
+
+  /* Convert out of REDC form */
+  MPN_COPY (tp, rp, n);
+  MPN_ZERO (tp + n, n);
+  mpn_redc (rp, tp, mp, n, mip);
+  if (mpn_cmp (rp, mp, n) >= 0)
+    mpn_sub_n (rp, rp, mp, n);
+
+  rn = n;
+  MPN_NORMALIZE (rp, rn);
+  MPN_COPY (MPZ_NEWALLOC (r, rn), rp, rn);
+  SIZ (r) = rn;
+  TMP_FREE;
+}
+
+void
+mpz_powm_precomp_clear (mpz_powm_precomp_t P)
+{
+  if (P->_mp_tab != NULL)
+    __GMP_FREE_FUNC_LIMBS (P->_mp_tab,
+			   ABSIZ (P->_mp_m) + (ABSIZ (P->_mp_m) << P->_mp_h));
+  mpz_clear (P->_mp_b);
+  mpz_clear (P->_mp_m);
+}
@@ -0,0 +1,134 @@
+/* mpz_probab_prime_batch -- probable prime tests of many numbers.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "gmp.h"
+#include "gmp-impl.h"
+
+/* Each number is an item for __gmp_parallel_run, so with threads the tests
+   are shared among them, and without it's a plain loop.  */
+
+struct pprime_batch
+{
+  int *rop;
+  const mpz_srcptr *op;
+  int reps;
+};
+
+static void
+pprime_batch_item (void *arg, mp_size_t i)
+{
+  const struct pprime_batch *B = (const struct pprime_batch *) arg;
+  B->rop[i] = mpz_probab_prime_p (B->op[i], B->reps);
+}
+
+void
+mpz_probab_prime_batch (int *rop, const mpz_srcptr *op, size_t n, int reps)
+{
+  struct pprime_batch B;
+
+  B.rop = rop;
+  B.op = op;
+  B.reps = reps;
+  __gmp_parallel_run (pprime_batch_item, &B, n);
+}
+
+
+/* For the first prime only, the items share the lowest index found prime
+   so far, and each gives up, before or between its rounds, once that's
+   below its own.  best is read and lowered without a lock.  Two items
+   lowering it at once can leave the higher of their indexes, and a stale
+   read means some rounds not skipped, but best only ever holds the index
+   of a prime, so no item below the first prime gives up, and the answer is
+   the same as a serial search.  */
+
+struct millerrabin_first
+{
+  int *res;
+  const mpz_srcptr *op;
+  int reps;
+  volatile mp_size_t best;
+};
+
+struct millerrabin_first_stop
+{
+  struct millerrabin_first *F;
+  mp_size_t i;
+};
+
+static int
+millerrabin_first_stop (void *arg)
+{
+  const struct millerrabin_first_stop *S
+    = (const struct millerrabin_first_stop *) arg;
+  return S->F->best < S->i;
+}
+
+static void
+millerrabin_first_item (void *arg, mp_size_t i)
+{
+  struct millerrabin_first *F = (struct millerrabin_first *) arg;
+  struct millerrabin_first_stop S;
+  int r;
+
+  S.F = F;
+  S.i = i;
+  r = millerrabin_first_stop (&S)
+    ? 0 : mpz_millerrabin_stop (F->op[i], F->reps, millerrabin_first_stop, &S);
+  F->res[i] = r;
+  if (r != 0 && i < F->best)
+    F->best = i;
+}
+
+mp_size_t
+mpz_millerrabin_first (int *is_prime, const mpz_srcptr *op, mp_size_t n,
+		       int reps)
+{
+  struct millerrabin_first F;
+  mp_size_t i;
+  int *res;
+  TMP_DECL;
+
+  TMP_MARK;
+  res = TMP_ALLOC_TYPE (n, int);
+  F.res = res;
+  F.op = op;
+  F.reps = reps;
+  F.best = n;
+  __gmp_parallel_run (millerrabin_first_item, &F, n);
+
+  for (i = 0; i < n; i++)
+    if (res[i] != 0)
+      {
+	*is_prime = res[i];
+	break;
+      }
+  TMP_FREE;
+  return i;
+}
@@ -0,0 +1,536 @@
+/* mpz_product_tree, mpz_remainder_tree, mpz_multi_mod -- products of many
+   numbers and remainders modulo many moduli.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "gmp.h"
+#include "gmp-impl.h"
+
+
+/* The tree is kept as a heap of 2k-1 nodes, node i having children 2i+1
+   and 2i+2, so nodes 0 to k-2 are products and k-1 to 2k-2 are the
+   moduli (made positive).  The depth is at most ceil(log2(k)).
+
+   The remainder tree is the scaled one.  Rather than x mod P at each node
+   P, which needs a division per node, it carries T ~= B^p frac(x/P).  For
+   a child C with sibling S, frac(x/C) = frac(frac(x/P) S), so T for C is
+   the middle part of T S, a middle product (mpn_mulmid) below the FFT
+   sizes, where it's cheaper than the full product.  At a leaf m, x mod m
+   is then T m / B^p rounded.  Only the root needs a division.
+
+   T is always truncated, never rounded, so the errors all go one way, and
+   they just add, by at most sn+2 units of the last limb per level.  With
+   the precision p at each node chosen so that the leaves get one limb
+   more than their modulus, the total stays far below B/2 and the rounding
+   at the leaves is exact.  A node's p is the most any path to a leaf
+   below it needs, which is at most its size plus 1 plus its depth.
+
+   Memory for the descent is one T per level, depth first, so a few times
+   the root size, on top of the tree itself.  mpz_multi_mod bounds the
+   tree too, by working through the moduli in groups with a product about
+   the size of x.
+
+   With threads, the nodes at the first level with as many nodes as
+   threads are the roots of subtrees built, and descended, in parallel,
+   the levels above being done serially.  */
+
+#define TREE_LEAF_P(k,i)  ((i) + 1 >= (k))
+
+/* The level whose nodes are the roots of subtrees worth one thread each,
+   returned as the index of its first node, or 0 if threads aren't
+   worth it.  size is the size of the root, or near enough.  */
+size_t
+mpz_product_tree_split (size_t k, mp_size_t size)
+{
+  size_t f;
+  int threads;
+
+  threads = __gmp_parallel_threads ();
+  if (threads <= 1 || size < PRODUCT_TREE_PARALLEL_THRESHOLD)
+    return 0;
+  for (f = 1; f + 1 < (size_t) threads; f = 2 * f + 1)
+    ;
+  /* the level 2^L-1 to 2^(L+1)-2 must be complete */
+  if (f + 1 > k)
+    return 0;
+  return f;
+}
+
+
+/* Product tree.  */
+
+struct tree_build
+{
+  __mpz_struct *node;
+  size_t k;
+  size_t f;
+};
+
+static void
+tree_build (__mpz_struct *node, size_t k, size_t i)
+{
+  if (TREE_LEAF_P (k, i))
+    return;
+  tree_build (node, k, 2 * i + 1);
+  tree_build (node, k, 2 * i + 2);
+  mpz_mul (&node[i], &node[2 * i + 1], &node[2 * i + 2]);
+}
+
+static void
+tree_build_item (void *arg, mp_size_t c)
+{
+  struct tree_build *b = (struct tree_build *) arg;
+  tree_build (b->node, b->k, b->f + c);
+}
+
+void
+mpz_product_tree_init (mpz_product_tree_t t, const mpz_srcptr *m, size_t k)
+{
+  __mpz_struct *node;
+  struct tree_build b;
+  mp_size_t size;
+  size_t i, f;
+
+  t->_mp_k = k;
+  if (k == 0)
+    {
+      t->_mp_node = NULL;
+      return;
+    }
+
+  node = __GMP_ALLOCATE_FUNC_TYPE (2 * k - 1, __mpz_struct);
+  t->_mp_node = node;
+  size = 0;
+  for (i = 0; i < k; i++)
+    {
+      if (UNLIKELY (SIZ (m[i]) == 0))
+	DIVIDE_BY_ZERO;
+      mpz_init_set (&node[k - 1 + i], m[i]);
+      mpz_abs (&node[k - 1 + i], &node[k - 1 + i]);
+      size += ABSIZ (m[i]);
+    }
+  for (i = 0; i < k - 1; i++)
+    mpz_init (&node[i]);
+
+  f = mpz_product_tree_split (k, size);
+  if (f != 0)
+    {
+      b.node = node;
+      b.k = k;
+      b.f = f;
+      __gmp_parallel_run (tree_build_item, &b, f + 1);
+    }
+  else
+    f = k - 1;
+  for (i = f; i-- > 0; )
+    mpz_mul (&node[i], &node[2 * i + 1], &node[2 * i + 2]);
+}
+
+void
+mpz_product_tree_clear (mpz_product_tree_t t)
+{
+  size_t i, k;
+
+  k = t->_mp_k;
+  if (k == 0)
+    return;
+  for (i = 0; i < 2 * k - 1; i++)
+    mpz_clear (&t->_mp_node[i]);
+  __GMP_FREE_FUNC_TYPE (t->_mp_node, 2 * k - 1, __mpz_struct);
+}
+
+
+/* Product of a list.  Balanced, so the big multiplications get operands
+   of similar size, and everything's read before rop is first written, so
+   rop can be in the list.  */
+
+static void
+list_prod (mpz_ptr rop, const mpz_srcptr *m, size_t k)
+{
+  mpz_t t;
+  size_t h;
+
+  if (k == 1)
+    {
+      mpz_set (rop, m[0]);
+      return;
+    }
+  if (k == 2)
+    {
+      mpz_mul (rop, m[0], m[1]);
+      return;
+    }
+  h = k / 2;
+  mpz_init (t);
+  list_prod (t, m, h);
+  list_prod (rop, m + h, k - h);
+  mpz_mul (rop, rop, t);
+  mpz_clear (t);
+}
+
+struct list_prod
+{
+  const mpz_srcptr *m;
+  mpz_ptr part;
+  size_t k;
+  size_t chunks;
+};
+
+#define LIST_CHUNK_START(p,c)  ((p)->k * (c) / (p)->chunks)
+
+static void
+list_prod_item (void *arg, mp_size_t c)
+{
+  struct list_prod *p = (struct list_prod *) arg;
+  size_t lo, hi;
+
+  lo = LIST_CHUNK_START (p, c);
+  hi = LIST_CHUNK_START (p, c + 1);
+  list_prod (&p->part[c], p->m + lo, hi - lo);
+}
+
+void
+mpz_product_tree (mpz_ptr rop, const mpz_srcptr *m, size_t k)
+{
+  struct list_prod p;
+  mpz_srcptr *pp;
+  mp_size_t size;
+  mp_ptr factors;
+  size_t i;
+  int threads, neg, ones;
+  TMP_DECL;
+
+  if (k <= 1)
+    {
+      if (k == 0)
+	mpz_set_ui (rop, 1);
+      else
+	mpz_set (rop, m[0]);
+      return;
+    }
+
+  size = 0;
+  neg = 0;
+  ones = 1;
+  for (i = 0; i < k; i++)
+    {
+      size += ABSIZ (m[i]);
+      neg ^= SIZ (m[i]) < 0;
+      ones &= ABSIZ (m[i]) == 1;
+    }
+
+  TMP_MARK;
+  threads = __gmp_parallel_threads ();
+  p.chunks = MIN (threads, k / 2);
+  if (threads > 1 && p.chunks > 1 && size >= PRODUCT_TREE_PARALLEL_THRESHOLD)
+    {
+      p.m = m;
+      p.k = k;
+      p.part = TMP_ALLOC_TYPE (p.chunks, __mpz_struct);
+      for (i = 0; i < p.chunks; i++)
+	mpz_init (&p.part[i]);
+      __gmp_parallel_run (list_prod_item, &p, p.chunks);
+
+      pp = TMP_ALLOC_TYPE (p.chunks, mpz_srcptr);
+      for (i = 0; i < p.chunks; i++)
+	pp[i] = &p.part[i];
+      list_prod (rop, pp, p.chunks);
+      for (i = 0; i < p.chunks; i++)
+	mpz_clear (&p.part[i]);
+    }
+  else if (ones)
+    {
+      /* all single limbs, as from trial division primes */
+      factors = TMP_ALLOC_LIMBS (k);
+      for (i = 0; i < k; i++)
+	factors[i] = PTR (m[i])[0];
+      mpz_prodlimbs (rop, factors, k);
+      if (neg)
+	SIZ (rop) = -SIZ (rop);
+    }
+  else
+    list_prod (rop, m, k);
+  TMP_FREE;
+}
+
+
+/* Scaled remainder tree.  */
+
+struct remainder_tree
+{
+  const __mpz_struct *node;
+  size_t k;
+  const mp_size_t *prec;	/* p at each node */
+  const mpz_ptr *r;
+  int neg;
+  size_t stop;			/* first node to save T at, or none */
+  mp_ptr *saved;
+};
+
+/* r = x mod m from {tp,p} at leaf i.  */
+static void
+remainder_leaf (const struct remainder_tree *R, size_t i, mp_srcptr tp)
+{
+  mpz_srcptr m;
+  mpz_ptr r;
+  mp_srcptr mp;
+  mp_ptr pp, rp;
+  mp_size_t mn, p;
+  TMP_DECL;
+
+  m = &R->node[i];
+  mp = PTR (m);
+  mn = SIZ (m);
+  p = R->prec[i];
+  ASSERT (p == mn + 1);
+
+  TMP_MARK;
+  pp = TMP_ALLOC_LIMBS (p + mn);
+  mpn_mul (pp, tp, p, mp, mn);
+  rp = pp + p;
+  mpn_incr_u (rp, pp[p - 1] >> (GMP_NUMB_BITS - 1));
+  if (mpn_cmp (rp, mp, mn) == 0)
+    mn = 0;
+  else if (R->neg)
+    {
+      MPN_NORMALIZE (rp, mn);
+      if (mn != 0)
+	{
+	  mpn_sub (rp, mp, SIZ (m), rp, mn);
+	  mn = SIZ (m);
+	}
+    }
+  MPN_NORMALIZE (rp, mn);
+
+  r = R->r[i - (R->k - 1)];
+  MPN_COPY (MPZ_NEWALLOC (r, mn), rp, mn);
+  SIZ (r) = mn;
+  TMP_FREE;
+}
+
+/* Descend from node i, with {tp,prec[i]} its T.  */
+static void
+remainder_descend (const struct remainder_tree *R, size_t i, mp_srcptr tp)
+{
+  mpz_srcptr s;
+  mp_ptr rp;
+  mp_size_t p, pc, sn, an;
+  size_t c, j;
+  TMP_DECL;
+
+  if (TREE_LEAF_P (R->k, i))
+    {
+      remainder_leaf (R, i, tp);
+      return;
+    }
+  if (i >= R->stop)
+    {
+      MPN_COPY (R->saved[i - R->stop], tp, R->prec[i]);
+      return;
+    }
+
+  p = R->prec[i];
+  for (j = 1; j <= 2; j++)
+    {
+      c = 2 * i + j;
+      s = &R->node[2 * i + 3 - j];
+      sn = SIZ (s);
+      pc = R->prec[c];
+      an = pc + sn;
+      ASSERT (an <= p);
+
+      /* T for c is limbs sn to an-1 of the top an limbs of T times s */
+      TMP_MARK;
+      if (BELOW_THRESHOLD (sn, MUL_FFT_THRESHOLD))
+	{
+	  rp = TMP_ALLOC_LIMBS (pc + 3);
+	  mpn_mulmid (rp, tp + p - an, an, PTR (s), sn);
+	  rp++;
+	}
+      else
+	{
+	  rp = TMP_ALLOC_LIMBS (an + sn);
+	  mpn_mul (rp, tp + p - an, an, PTR (s), sn);
+	  rp += sn;
+	}
+      remainder_descend (R, c, rp);
+      TMP_FREE;
+    }
+}
+
+static void
+remainder_item (void *arg, mp_size_t c)
+{
+  const struct remainder_tree *R = (const struct remainder_tree *) arg;
+  struct remainder_tree sub;
+  size_t i;
+
+  i = R->stop + c;
+  if (TREE_LEAF_P (R->k, i))
+    return;			/* done on the way down */
+  sub = *R;
+  sub.stop = 2 * R->k;
+  remainder_descend (&sub, i, R->saved[c]);
+}
+
+void
+mpz_remainder_tree (const mpz_ptr *r, mpz_srcptr x, mpz_product_tree_t t)
+{
+  struct remainder_tree R;
+  const __mpz_struct *node;
+  mp_size_t *prec;
+  mp_size_t xn, pn, qn, p, a, b;
+  mp_ptr np, qp, tp;
+  size_t k, i, f;
+  TMP_DECL;
+
+  k = t->_mp_k;
+  node = t->_mp_node;
+  if (k <= 1)
+    {
+      if (k == 1)
+	mpz_mod (r[0], x, &node[0]);
+      return;
+    }
+
+  xn = ABSIZ (x);
+  if (xn == 0)
+    {
+      for (i = 0; i < k; i++)
+	SIZ (r[i]) = 0;
+      return;
+    }
+
+  TMP_MARK;
+
+  /* The precision each node needs for its leaves.  */
+  prec = TMP_ALLOC_TYPE (2 * k - 1, mp_size_t);
+  for (i = 2 * k - 1; i-- > 0; )
+    {
+      if (TREE_LEAF_P (k, i))
+	prec[i] = SIZ (&node[i]) + 1;
+      else
+	{
+	  a = prec[2 * i + 1] + SIZ (&node[2 * i + 2]);
+	  b = prec[2 * i + 2] + SIZ (&node[2 * i + 1]);
+	  prec[i] = MAX (a, b);
+	}
+    }
+
+  /* T at the root is the low p limbs of floor(|x| B^p / P).  */
+  p = prec[0];
+  pn = SIZ (&node[0]);
+  ASSERT (p > pn);
+  np = TMP_ALLOC_LIMBS (xn + p);
+  MPN_ZERO (np, p);
+  MPN_COPY (np + p, PTR (x), xn);
+  qn = xn + p - pn + 1;
+  qp = TMP_ALLOC_LIMBS (MAX (qn, p));
+  tp = TMP_ALLOC_LIMBS (pn);
+  mpn_tdiv_qr (qp, tp, 0L, np, xn + p, PTR (&node[0]), pn);
+  if (qn < p)
+    MPN_ZERO (qp + qn, p - qn);
+  tp = qp;
+
+  /* Everything needed from x is in T now, so r[i] can be x.  */
+  R.node = node;
+  R.k = k;
+  R.prec = prec;
+  R.r = r;
+  R.neg = SIZ (x) < 0;
+
+  f = mpz_product_tree_split (k, pn);
+  if (f != 0)
+    {
+      R.stop = f;
+      R.saved = TMP_ALLOC_TYPE (f + 1, mp_ptr);
+      for (i = 0; i <= f; i++)
+	R.saved[i] = TMP_ALLOC_LIMBS (prec[f + i]);
+      remainder_descend (&R, 0, tp);
+      __gmp_parallel_run (remainder_item, &R, f + 1);
+    }
+  else
+    {
+      R.stop = 2 * k;
+      remainder_descend (&R, 0, tp);
+    }
+  TMP_FREE;
+}
+
+
+/* The moduli in groups, each with a product about the size of x, so the
+   trees stay no bigger than needed.  Past that size a bigger tree would
+   only make the descent longer, while the root division of x by the
+   group product is no dearer than the descent from it.  Below
+   MULTI_MOD_THRESHOLD limbs in x, plain divisions are quicker.  */
+
+#ifndef MULTI_MOD_THRESHOLD
+#define MULTI_MOD_THRESHOLD  400
+#endif
+
+void
+mpz_multi_mod (const mpz_ptr *r, mpz_srcptr x, const mpz_srcptr *m, size_t k)
+{
+  mpz_product_tree_t t;
+  mpz_t xs;
+  mp_size_t xn, size;
+  size_t lo, hi, i;
+  TMP_DECL;
+
+  xn = ABSIZ (x);
+  TMP_MARK;
+  /* x is read again after some r[i] are written.  */
+  for (i = 0; i < k; i++)
+    if (r[i] == x)
+      {
+	MPZ_TMP_INIT (xs, xn);
+	mpz_set (xs, x);
+	x = xs;
+	break;
+      }
+
+  if (BELOW_THRESHOLD (xn, MULTI_MOD_THRESHOLD))
+    {
+      for (i = 0; i < k; i++)
+	mpz_mod (r[i], x, m[i]);
+      TMP_FREE;
+      return;
+    }
+
+  for (lo = 0; lo < k; lo = hi)
+    {
+      size = 0;
+      for (hi = lo; hi < k && size < xn; hi++)
+	size += ABSIZ (m[hi]);
+      mpz_product_tree_init (t, m + lo, hi - lo);
+      mpz_remainder_tree (r + lo, x, t);
+      mpz_product_tree_clear (t);
+    }
+  TMP_FREE;
+}
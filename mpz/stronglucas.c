@@ -0,0 +1,156 @@
+/* mpz_stronglucas(n) -- strong Lucas probable prime test.
+
+   THE FUNCTIONS IN THIS FILE ARE FOR INTERNAL USE ONLY.  THEY'RE ALMOST
+   CERTAIN TO BE SUBJECT TO INCOMPATIBLE CHANGES OR DISAPPEAR COMPLETELY IN
+   FUTURE GNU MP RELEASES.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "gmp.h"
+#include "gmp-impl.h"
+
+
+/* With Selfridge's parameters, D the first of 5, -7, 9, -11, 13, ... with
+   (D/n) = -1, P = 1 and Q = (1-D)/4, and n+1 = d 2^s with d odd, n is a
+   strong Lucas probable prime if U_d = 0 or V_(d 2^r) = 0 mod n for some
+   0 <= r < s.  See Baillie and Wagstaff, "Lucas pseudoprimes", Math. Comp.
+   35 (1980), 1391-1417.
+
+   U_d, V_d and Q^d are formed left to right with
+
+     U_2k = U_k V_k,  V_2k = V_k^2 - 2 Q^k,
+     U_k+1 = (U_k + V_k) / 2,  V_k+1 = (D U_k + V_k) / 2,
+
+   which is three multiplications mod n for each bit of d.  The reductions
+   use a precomputed divisor.
+
+   n must be odd and above 1.  If n is a perfect square there's no such D,
+   that's noticed after a few D's.  If (D/n) = 0 then n has a factor in
+   common with D, and is composite unless it's |D|.  Every odd number from
+   5 up to |D|-2 was coprime to n, so n = |D| is prime, except n = 9 whose
+   only factor 3 isn't among the D's.  */
+
+/* x = x/2 mod n, for 0 <= x < n */
+static void
+half_mod (mpz_ptr x, mpz_srcptr n)
+{
+  if (mpz_odd_p (x))
+    mpz_add (x, x, n);
+  mpz_tdiv_q_2exp (x, x, 1);
+}
+
+int
+mpz_stronglucas (mpz_srcptr n)
+{
+  long D, Q;
+  int j;
+  mp_bitcnt_t s, b;
+  mpz_divisor_t nd;
+  mpz_t d, U, V, Qk, t;
+  int is_prime;
+
+  ASSERT (mpz_odd_p (n));
+  ASSERT (mpz_cmp_ui (n, 1) > 0);
+
+  for (D = 5; ; D = D > 0 ? -D - 2 : -D + 2)
+    {
+      j = mpz_si_kronecker (D, n);
+      if (j == -1)
+	break;
+      if (j == 0)
+	return D != 9 && mpz_cmp_ui (n, (unsigned long) ABS (D)) == 0;
+      if (D == 13 && mpz_perfect_square_p (n))
+	return 0;
+    }
+  Q = (1 - D) / 4;
+
+  mpz_init (d);
+  mpz_init (U);
+  mpz_init (V);
+  mpz_init (Qk);
+  mpz_init (t);
+  mpz_divisor_init (nd, n);
+
+  mpz_add_ui (d, n, 1);
+  s = mpz_scan1 (d, 0);
+  mpz_tdiv_q_2exp (d, d, s);
+
+  /* k = 1 */
+  mpz_set_ui (U, 1);
+  mpz_set_ui (V, 1);
+  mpz_set_si (Qk, Q);
+  mpz_mod_pre (Qk, Qk, nd);
+
+  for (b = mpz_sizeinbase (d, 2) - 1; b-- > 0; )
+    {
+      mpz_mul (U, U, V);
+      mpz_mod_pre (U, U, nd);
+      mpz_mul (V, V, V);
+      mpz_submul_ui (V, Qk, 2);
+      mpz_mod_pre (V, V, nd);
+      mpz_mul (Qk, Qk, Qk);
+      mpz_mod_pre (Qk, Qk, nd);
+
+      if (mpz_tstbit (d, b))
+	{
+	  mpz_mul_si (t, U, D);
+	  mpz_add (t, t, V);
+	  mpz_mod_pre (t, t, nd);
+	  half_mod (t, n);
+	  mpz_add (U, U, V);
+	  mpz_mod_pre (U, U, nd);
+	  half_mod (U, n);
+	  mpz_swap (V, t);
+	  mpz_mul_si (Qk, Qk, Q);
+	  mpz_mod_pre (Qk, Qk, nd);
+	}
+    }
+
+  is_prime = SIZ (U) == 0 || SIZ (V) == 0;
+  for (b = 1; b < s && ! is_prime; b++)
+    {
+      mpz_mul (V, V, V);
+      mpz_submul_ui (V, Qk, 2);
+      mpz_mod_pre (V, V, nd);
+      is_prime = SIZ (V) == 0;
+      if (b + 1 < s)
+	{
+	  mpz_mul (Qk, Qk, Qk);
+	  mpz_mod_pre (Qk, Qk, nd);
+	}
+    }
+
+  mpz_divisor_clear (nd);
+  mpz_clear (d);
+  mpz_clear (U);
+  mpz_clear (V);
+  mpz_clear (Qk);
+  mpz_clear (t);
+  return is_prime;
+}
@@ -0,0 +1,229 @@
+/* Thread pool for parallel multiplication.
+
+   THE FUNCTIONS __gmp_parallel_run AND __gmp_parallel_threads ARE INTERNAL
+   WITH MUTABLE INTERFACES.  IT IS ONLY SAFE TO REACH THEM THROUGH DOCUMENTED
+   INTERFACES.  IN FACT, IT IS ALMOST GUARANTEED THAT THEY WILL CHANGE OR
+   DISAPPEAR IN A FUTURE GNU MP RELEASE.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "gmp.h"
+#include "gmp-impl.h"
+
+#if WANT_THREADS
+#include <pthread.h>
+#endif
+
+
+/* The pool is created lazily, the first time __gmp_parallel_run is asked to
+   spread work over more than one thread.  Workers are never destroyed;
+   lowering the thread count just leaves the surplus ones asleep.
+
+   A caller of __gmp_parallel_run puts a job on a list, then takes items
+   from that job itself, the same as the workers do.  Once all items are
+   taken it waits for those still running elsewhere.  Since a caller always
+   makes progress on its own job, a job item may itself call
+   __gmp_parallel_run (as the recursive FFT does) without any risk of
+   deadlock, even if every worker is busy.
+
+   The result of any computation done through here must not depend on which
+   thread ran which item, nor on the order they ran in.  That's up to the
+   callers, who give each item disjoint output and scratch space.
+
+   num_threads is only read or written with pool_lock held, and each run
+   reads it once, so an mp_set_num_threads in another thread can't give a
+   run two different counts.  */
+
+#if WANT_THREADS
+
+static int num_threads = 1;
+
+struct gmp_parallel_job
+{
+  gmp_parallel_func_t func;
+  void *arg;
+  mp_size_t n;			/* number of items */
+  mp_size_t next;		/* next item to hand out */
+  mp_size_t running;		/* items handed out but not finished */
+  struct gmp_parallel_job *link;
+};
+
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t pool_work = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t pool_done = PTHREAD_COND_INITIALIZER;
+static struct gmp_parallel_job *pool_jobs;	/* jobs with items to hand out */
+static int pool_workers;			/* workers started */
+
+/* Take the next item of job, unlinking the job once its last item is
+   gone.  Must be called with pool_lock held.  */
+static mp_size_t
+job_take (struct gmp_parallel_job *job)
+{
+  struct gmp_parallel_job **pp;
+  mp_size_t i;
+
+  i = job->next++;
+  job->running++;
+  if (job->next == job->n)
+    {
+      for (pp = &pool_jobs; *pp != job; pp = &(*pp)->link)
+	;
+      *pp = job->link;
+    }
+  return i;
+}
+
+/* Run item i of job, with pool_lock held on entry and exit.  */
+static void
+job_run (struct gmp_parallel_job *job, mp_size_t i)
+{
+  pthread_mutex_unlock (&pool_lock);
+  (*job->func) (job->arg, i);
+  pthread_mutex_lock (&pool_lock);
+  if (--job->running == 0 && job->next == job->n)
+    pthread_cond_broadcast (&pool_done);
+}
+
+static void *
+worker (void *p)
+{
+  int id = (int) (size_t) p;
+  struct gmp_parallel_job *job;
+
+  pthread_mutex_lock (&pool_lock);
+  for (;;)
+    {
+      job = pool_jobs;
+      if (job == NULL || id >= num_threads - 1)
+	{
+	  pthread_cond_wait (&pool_work, &pool_lock);
+	  continue;
+	}
+      job_run (job, job_take (job));
+    }
+  /* not reached */
+  return NULL;
+}
+
+void
+__gmp_parallel_run (gmp_parallel_func_t func, void *arg, mp_size_t n)
+{
+  struct gmp_parallel_job job;
+  pthread_t thread;
+  mp_size_t i;
+  int threads;
+
+  threads = n <= 1 ? 1 : __gmp_parallel_threads ();
+  if (threads <= 1)
+    {
+      for (i = 0; i < n; i++)
+	(*func) (arg, i);
+      return;
+    }
+
+  job.func = func;
+  job.arg = arg;
+  job.n = n;
+  job.next = 0;
+  job.running = 0;
+
+  pthread_mutex_lock (&pool_lock);
+
+  while (pool_workers < threads - 1)
+    {
+      if (pthread_create (&thread, NULL, worker,
+			  (void *) (size_t) pool_workers) != 0)
+	break;			/* make do with what we've got */
+      pthread_detach (thread);
+      pool_workers++;
+    }
+
+  job.link = pool_jobs;
+  pool_jobs = &job;
+  pthread_cond_broadcast (&pool_work);
+
+  while (job.next < job.n)
+    job_run (&job, job_take (&job));
+
+  while (job.running != 0)
+    pthread_cond_wait (&pool_done, &pool_lock);
+
+  pthread_mutex_unlock (&pool_lock);
+}
+
+int
+__gmp_parallel_threads (void)
+{
+  int threads;
+
+  pthread_mutex_lock (&pool_lock);
+  threads = num_threads;
+  pthread_mutex_unlock (&pool_lock);
+  return threads;
+}
+
+void
+mp_set_num_threads (int n) __GMP_NOTHROW
+{
+  pthread_mutex_lock (&pool_lock);
+  num_threads = MAX (n, 1);
+  pthread_mutex_unlock (&pool_lock);
+}
+
+#else /* ! WANT_THREADS */
+
+void
+__gmp_parallel_run (gmp_parallel_func_t func, void *arg, mp_size_t n)
+{
+  mp_size_t i;
+
+  for (i = 0; i < n; i++)
+    (*func) (arg, i);
+}
+
+int
+__gmp_parallel_threads (void)
+{
+  return 1;
+}
+
+/* Without threads there's only ever one, so a request is ignored.  */
+void
+mp_set_num_threads (int n) __GMP_NOTHROW
+{
+}
+
+#endif /* ! WANT_THREADS */
+
+
+int
+mp_get_num_threads (void) __GMP_NOTHROW
+{
+  return __gmp_parallel_threads ();
+}
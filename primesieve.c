@@ -1,13 +1,15 @@
 /* primesieve (BIT_ARRAY, N) -- Fills the BIT_ARRAY with a mask for primes up to N.
 
+   gmp_primeiter_next -- Primes in a range, sieved a block at a time.
+
 Contributed to the GNU project by Marco Bodrato.
 
-THE FUNCTION IN THIS FILE IS INTERNAL WITH A MUTABLE INTERFACE.
-IT IS ONLY SAFE TO REACH IT THROUGH DOCUMENTED INTERFACES.
+THE gmp_primesieve FUNCTION IN THIS FILE IS INTERNAL WITH A MUTABLE
+INTERFACE.  IT IS ONLY SAFE TO REACH IT THROUGH DOCUMENTED INTERFACES.
 IN FACT, IT IS ALMOST GUARANTEED THAT IT WILL CHANGE OR
 DISAPPEAR IN A FUTURE GNU MP RELEASE.
 
-Copyright 2010-2012 Free Software Foundation, Inc.
+Copyright 2010-2012, 2026 Free Software Foundation, Inc.
 
 This file is part of the GNU MP Library.
 
@@ -37,6 +39,7 @@ see https://www.gnu.org/licenses/.  */
 
 #include "gmp.h"
 #include "gmp-impl.h"
+#include "longlong.h"
 
 /**************************************************************/
 /* Section macros: common macros, for mswing/fac/bin (&sieve) */
@@ -76,10 +79,8 @@ see https://www.gnu.org/licenses/.  */
 /* Section sieve: sieving functions and tools for primes */
 /*********************************************************/
 
-#if 0
 static mp_limb_t
 bit_to_n (mp_limb_t bit) { return (bit*3+4)|1; }
-#endif
 
 /* id_to_n (x) = bit_to_n (x-1) = (id*3+1)|1*/
 static mp_limb_t
@@ -89,10 +90,8 @@ id_to_n  (mp_limb_t id)  { return id*3+1+(id&1); }
 static mp_limb_t
 n_to_bit (mp_limb_t n) { return ((n-5)|1)/3U; }
 
-#if 0
 static mp_size_t
 primesieve_size (mp_limb_t n) { return n_to_bit(n) / GMP_LIMB_BITS + 1; }
-#endif
 
 #if GMP_LIMB_BITS > 61
 #define SIEVE_SEED CNST_LIMB(0x3294C9E069128480)
@@ -117,6 +116,44 @@ primesieve_size (mp_limb_t n) { return n_to_bit(n) / GMP_LIMB_BITS + 1; }
 #endif /* 30 */
 #endif /* 61 */
 
+/* Fill limbs limbs at bit_array with the multiples of 5 and 7, bit 0
+   being the bit of offset.  In the bits for numbers coprime to 6 those
+   have periods of 10 and 14, so each limb is an or of one of 10 and one of
+   14 patterns.  The sieving loops can then start from 11.  */
+static void
+wheel_fill (mp_ptr bit_array, mp_size_t limbs, mp_limb_t offset)
+{
+  mp_limb_t p5[10], p7[14];
+  unsigned i, j, k, b;
+
+  for (i = 0; i < 14; i++)
+    {
+      if (i < 10)
+	p5[i] = 0;
+      p7[i] = 0;
+      for (b = 0; b < GMP_LIMB_BITS; b++)
+	{
+	  if (i < 10 && bit_to_n (i + b) % 5 == 0)
+	    p5[i] |= CNST_LIMB(1) << b;
+	  if (bit_to_n (i + b) % 7 == 0)
+	    p7[i] |= CNST_LIMB(1) << b;
+	}
+    }
+
+  j = offset % 10;
+  k = offset % 14;
+  for (i = 0; i < limbs; i++)
+    {
+      bit_array[i] = p5[j] | p7[k];
+      j = (j + GMP_LIMB_BITS) % 10;
+      k = (k + GMP_LIMB_BITS) % 14;
+    }
+
+  /* 5 and 7 themselves */
+  if (offset == 0)
+    bit_array[0] &= ~CNST_LIMB(3);
+}
+
 static void
 first_block_primesieve (mp_ptr bit_array, mp_limb_t n)
 {
@@ -127,9 +164,8 @@ first_block_primesieve (mp_ptr bit_array, mp_limb_t n)
   bits  = n_to_bit(n);
   limbs = bits / GMP_LIMB_BITS + 1;
 
-  /* FIXME: We can skip 5 too, filling with a 5-part pattern. */
-  MPN_ZERO (bit_array, limbs);
-  bit_array[0] = SIEVE_SEED;
+  wheel_fill (bit_array, limbs, 0);
+  bit_array[0] |= SIEVE_SEED;
 
   if ((bits + 1) % GMP_LIMB_BITS != 0)
     bit_array[limbs-1] |= MP_LIMB_T_MAX << ((bits + 1) % GMP_LIMB_BITS);
@@ -139,9 +175,9 @@ first_block_primesieve (mp_ptr bit_array, mp_limb_t n)
 
     ASSERT (n > 49);
 
-    mask = 1;
+    mask = CNST_LIMB(1) << 2;
     index = 0;
-    i = 1;
+    i = 3;
     do {
       if ((bit_array[index] & mask) == 0)
 	{
@@ -182,20 +218,22 @@ first_block_primesieve (mp_ptr bit_array, mp_limb_t n)
   }
 }
 
+/* Mark in limbs limbs at bit_array, bit 0 being the bit of offset, the
+   multiples of the primes whose bits from first to last are clear in
+   sieve, a piece of a sieve starting at bit sieve_offset.  */
 static void
-block_resieve (mp_ptr bit_array, mp_size_t limbs, mp_limb_t offset,
-		      mp_srcptr sieve, mp_limb_t sieve_bits)
+block_sieve_with (mp_ptr bit_array, mp_size_t limbs, mp_limb_t offset,
+		  mp_srcptr sieve, mp_limb_t sieve_offset,
+		  mp_limb_t first, mp_limb_t last)
 {
   mp_size_t bits, step;
 
   ASSERT (limbs > 0);
+  ASSERT (first >= 2);
 
   bits = limbs * GMP_LIMB_BITS - 1;
 
-  /* FIXME: We can skip 5 too, filling with a 5-part pattern. */
-  MPN_ZERO (bit_array, limbs);
-
-  LOOP_ON_SIEVE_BEGIN(step,0,sieve_bits,0,sieve);
+  LOOP_ON_SIEVE_BEGIN(step,first,last,sieve_offset,sieve);
   {
     mp_size_t lindex;
     mp_limb_t lmask;
@@ -240,8 +278,42 @@ block_resieve (mp_ptr bit_array, mp_size_t limbs, mp_limb_t offset,
   LOOP_ON_SIEVE_END;
 }
 
+static void
+block_resieve (mp_ptr bit_array, mp_size_t limbs, mp_limb_t offset,
+		      mp_srcptr sieve, mp_limb_t sieve_bits)
+{
+  wheel_fill (bit_array, limbs, offset);
+
+  /* nothing from 11 on to sieve with */
+  if (sieve_bits < 2)
+    return;
+
+  block_sieve_with (bit_array, limbs, offset, sieve, 0, 2, sieve_bits);
+}
+
 #define BLOCK_SIZE 2048
 
+/* Blocks past the one holding the square root of n only need the sieving
+   primes before them, so they're independent of each other, and with
+   threads they're resieved in parallel.  */
+
+struct resieve
+{
+  mp_ptr bit_array;
+  mp_size_t off;		/* first limb of the parallel blocks */
+};
+
+static void
+block_resieve_item (void *arg, mp_size_t i)
+{
+  const struct resieve *R = (const struct resieve *) arg;
+  mp_size_t off;
+
+  off = R->off + i * BLOCK_SIZE;
+  block_resieve (R->bit_array + off, BLOCK_SIZE, off * GMP_LIMB_BITS,
+		 R->bit_array, R->off * GMP_LIMB_BITS - 1);
+}
+
 /* Fills bit_array with the characteristic function of composite
    numbers up to the parameter n. I.e. a bit set to "1" represent a
    composite, a "0" represent a prime.
@@ -271,10 +343,22 @@ gmp_primesieve (mp_ptr bit_array, mp_limb_t n)
 
   if (size > BLOCK_SIZE * 2) {
     mp_size_t off;
+    mp_limb_t root;
     off = BLOCK_SIZE + (size % BLOCK_SIZE);
     first_block_primesieve (bit_array, id_to_n (off * GMP_LIMB_BITS));
-    for ( ; off < size; off += BLOCK_SIZE)
-      block_resieve (bit_array + off, BLOCK_SIZE, off * GMP_LIMB_BITS, bit_array, off * GMP_LIMB_BITS - 1);
+    if (__gmp_parallel_threads () > 1) {
+      struct resieve R;
+      mpn_sqrtrem (&root, NULL, &n, 1);
+      for ( ; off < size && off * GMP_LIMB_BITS <= n_to_bit (root);
+	    off += BLOCK_SIZE)
+	block_resieve (bit_array + off, BLOCK_SIZE, off * GMP_LIMB_BITS, bit_array, off * GMP_LIMB_BITS - 1);
+      R.bit_array = bit_array;
+      R.off = off;
+      __gmp_parallel_run (block_resieve_item, &R, (size - off) / BLOCK_SIZE);
+    } else {
+      for ( ; off < size; off += BLOCK_SIZE)
+	block_resieve (bit_array + off, BLOCK_SIZE, off * GMP_LIMB_BITS, bit_array, off * GMP_LIMB_BITS - 1);
+    }
   } else {
     first_block_primesieve (bit_array, n);
   }
@@ -286,6 +370,168 @@ gmp_primesieve (mp_ptr bit_array, mp_limb_t n)
   return size * GMP_LIMB_BITS - mpn_popcount (bit_array, size);
 }
 
+/* The primes in [lo,hi], a block of the sieve at a time.  A block only
+   needs the sieving primes up to the square root of its end, and those
+   are themselves sieved a window at a time, of at most BLOCK_SIZE limbs,
+   with the base primes up to the fourth root of hi.  The memory used is
+   then two blocks, plus sqrt(sqrt(hi))/24 bytes for the base, at most
+   about 2.7 kbytes.  When all the sieving primes fit in one window,
+   up to hi around 10^11, it's kept from block to block.  Above that each
+   block sieves the windows again, which near 2^64 about doubles the time
+   for a block, to around 10 seconds.  */
+
+static void
+primeiter_window (gmp_primeiter_t it, mp_limb_t offset)
+{
+  if (it->_mp_roffset == offset)
+    return;
+  block_resieve (it->_mp_root, it->_mp_rsize, offset, it->_mp_base,
+		 it->_mp_baselim < 11 ? 0 : n_to_bit (it->_mp_baselim));
+  it->_mp_roffset = offset;
+}
+
+static void
+primeiter_block (gmp_primeiter_t it, mp_limb_t bit)
+{
+  mp_limb_t last, need, root, offset, wbits;
+
+  it->_mp_offset = bit - bit % GMP_LIMB_BITS;
+  wheel_fill (it->_mp_block, it->_mp_bsize, it->_mp_offset);
+
+  /* the bit of the end of the block, or of hi */
+  last = MIN (it->_mp_offset + it->_mp_bsize * GMP_LIMB_BITS - 1,
+	      it->_mp_end);
+  last = bit_to_n (last);
+  mpn_sqrtrem (&need, NULL, &last, 1);
+  /* nothing from 11 on to sieve with */
+  if (need < 11)
+    return;
+
+  if (it->_mp_base == NULL)
+    {
+      mpn_sqrtrem (&root, NULL, &it->_mp_hi, 1);
+      mpn_sqrtrem (&it->_mp_baselim, NULL, &root, 1);
+      it->_mp_baselim = MAX (it->_mp_baselim, 5);
+      it->_mp_basesize = primesieve_size (it->_mp_baselim);
+      it->_mp_base = __GMP_ALLOCATE_FUNC_LIMBS (it->_mp_basesize);
+      gmp_primesieve (it->_mp_base, it->_mp_baselim);
+
+      it->_mp_rsize = MIN (BLOCK_SIZE, primesieve_size (root));
+      it->_mp_root = __GMP_ALLOCATE_FUNC_LIMBS (it->_mp_rsize);
+      it->_mp_roffset = MP_LIMB_T_MAX;
+    }
+
+  need = n_to_bit (need);
+  wbits = it->_mp_rsize * GMP_LIMB_BITS;
+  for (offset = 0; offset <= need; offset += wbits)
+    {
+      primeiter_window (it, offset);
+      block_sieve_with (it->_mp_block, it->_mp_bsize, it->_mp_offset,
+			it->_mp_root, offset, MAX (offset, 2),
+			MIN (offset + wbits - 1, need));
+    }
+}
+
+void
+gmp_primeiter_init (gmp_primeiter_t it, unsigned long lo, unsigned long hi)
+{
+  mp_limb_t bit;
+
+  ASSERT (hi <= GMP_NUMB_MAX);
+
+  it->_mp_base = NULL;
+  it->_mp_root = NULL;
+  it->_mp_block = NULL;
+  it->_mp_hi = hi;
+  it->_mp_end = hi < 5 ? 0 : n_to_bit (hi);
+
+  /* the block is needed for no more than the range */
+  bit = lo <= 5 ? 0 : n_to_bit (lo - 1) + 1;
+  if (hi >= 5 && bit <= it->_mp_end)
+    it->_mp_bsize = MIN (BLOCK_SIZE, it->_mp_end / GMP_LIMB_BITS
+			 - bit / GMP_LIMB_BITS + 1);
+  else
+    it->_mp_bsize = 1;
+
+  gmp_primeiter_skip (it, lo);
+}
+
+/* Go to the first prime from lo on, which can be before or after the
+   current position.  A block already sieved is used if lo is in it.  */
+void
+gmp_primeiter_skip (gmp_primeiter_t it, unsigned long lo)
+{
+  mp_limb_t hi = it->_mp_hi;
+
+  it->_mp_small = (lo <= 2 && hi >= 2) | (lo <= 3 && hi >= 3) << 1;
+  if (hi < 5)
+    {
+      /* nothing past 3 */
+      it->_mp_bit = 1;
+      return;
+    }
+  it->_mp_bit = lo <= 5 ? 0 : n_to_bit (lo - 1) + 1;
+  if (lo > hi)
+    it->_mp_bit = it->_mp_end + 1;
+}
+
+/* Return the next prime, or 0 once they're all done.  */
+unsigned long
+gmp_primeiter_next (gmp_primeiter_t it)
+{
+  mp_limb_t bit, i, w;
+  int cnt;
+
+  if (it->_mp_small != 0)
+    {
+      if (it->_mp_small & 1)
+	{
+	  it->_mp_small &= ~1;
+	  return 2;
+	}
+      it->_mp_small = 0;
+      return 3;
+    }
+
+  for (bit = it->_mp_bit; bit <= it->_mp_end;
+       bit += GMP_LIMB_BITS - i % GMP_LIMB_BITS)
+    {
+      /* outside the block, either way, wraps around to big */
+      i = bit - it->_mp_offset;
+      if (it->_mp_block == NULL || i >= it->_mp_bsize * GMP_LIMB_BITS)
+	{
+	  if (it->_mp_block == NULL)
+	    it->_mp_block = __GMP_ALLOCATE_FUNC_LIMBS (it->_mp_bsize);
+	  primeiter_block (it, bit);
+	  i = bit - it->_mp_offset;
+	}
+      w = ~it->_mp_block[i / GMP_LIMB_BITS] >> (i % GMP_LIMB_BITS);
+      if (w != 0)
+	{
+	  count_trailing_zeros (cnt, w);
+	  bit += cnt;
+	  if (bit > it->_mp_end)
+	    break;
+	  it->_mp_bit = bit + 1;
+	  return bit_to_n (bit);
+	}
+    }
+  it->_mp_bit = it->_mp_end + 1;
+  return 0;
+}
+
+void
+gmp_primeiter_clear (gmp_primeiter_t it)
+{
+  if (it->_mp_base != NULL)
+    {
+      __GMP_FREE_FUNC_LIMBS (it->_mp_base, it->_mp_basesize);
+      __GMP_FREE_FUNC_LIMBS (it->_mp_root, it->_mp_rsize);
+    }
+  if (it->_mp_block != NULL)
+    __GMP_FREE_FUNC_LIMBS (it->_mp_block, it->_mp_bsize);
+}
+
 #undef BLOCK_SIZE
 #undef SEED_LIMIT
 #undef SIEVE_SEED
@@ -0,0 +1,301 @@
+/* Test mpn_mod_2expc, mpn_powm_2expc, and mpz_mod and mpz_powm by such
+   moduli.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library test suite.
+
+The GNU MP Library test suite is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 3 of the License,
+or (at your option) any later version.
+
+The GNU MP Library test suite is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+the GNU MP Library test suite.  If not, see https://www.gnu.org/licenses/.  */
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "tests.h"
+
+#ifndef COUNT
+#define COUNT 500
+#endif
+
+#define MAX_N 40
+#define MAX_XN (5 * MAX_N)
+#define MAX_EN 3
+
+/* A dividend of 100000 limbs, which used to take quadratic time with
+   every fold working on all of it.  */
+static void
+check_long (gmp_randstate_ptr rands)
+{
+  static const struct {
+    unsigned long k;
+    long c;
+  } data[] = {
+    { 521, -1 }, { 255, -19 }, { 1279, -1 }, { 256, 0x1000003d1 },
+    { 127, 45 }, { 4253, -1 },
+  };
+  mpz_t m, x, r, ref;
+  unsigned i;
+
+  mpz_init (m);
+  mpz_init (x);
+  mpz_init (r);
+  mpz_init (ref);
+
+  mpz_rrandomb (x, rands, 100000 * GMP_NUMB_BITS);
+  for (i = 0; i < numberof (data); i++)
+    {
+      mpz_set_ui (m, 0);
+      mpz_setbit (m, data[i].k);
+      if (data[i].c < 0)
+	mpz_sub_ui (m, m, - data[i].c);
+      else
+	mpz_add_ui (m, m, data[i].c);
+
+      mpz_mod (r, x, m);
+      mpz_fdiv_r (ref, x, m);
+      if (mpz_cmp (r, ref) != 0)
+	{
+	  printf ("ERROR, long dividend mod 2^%lu%+ld\n", data[i].k, data[i].c);
+	  abort ();
+	}
+
+      mpz_neg (x, x);
+      mpz_mod (r, x, m);
+      mpz_fdiv_r (ref, x, m);
+      if (mpz_cmp (r, ref) != 0)
+	{
+	  printf ("ERROR, negative long dividend mod 2^%lu%+ld\n",
+		  data[i].k, data[i].c);
+	  abort ();
+	}
+      mpz_neg (x, x);
+    }
+
+  mpz_clear (m);
+  mpz_clear (x);
+  mpz_clear (r);
+  mpz_clear (ref);
+}
+
+/* x = 2^(2 GMP_NUMB_BITS) mod 2^k + c, for two limb moduli.  The first fold
+   borrows, and the -cc for the carry out of the one after borrows again,
+   which used to go round forever.  2^115 + 71 turned up in mpz_nextprime.  */
+static void
+check_wrap (void)
+{
+  static const struct {
+    unsigned long k;
+    unsigned long c;
+  } data[] = {
+    { 115, 71 }, { 100, 1 }, { 127, 45 }, { 65, 3 },
+  };
+  mpz_t m, x, r, ref;
+  unsigned i;
+
+  mpz_init (m);
+  mpz_init (x);
+  mpz_init (r);
+  mpz_init (ref);
+
+  mpz_set_ui (x, 0);
+  mpz_setbit (x, 2 * GMP_NUMB_BITS);
+  for (i = 0; i < numberof (data); i++)
+    {
+      mpz_set_ui (m, 0);
+      mpz_setbit (m, data[i].k);
+      mpz_add_ui (m, m, data[i].c);
+
+      mpz_mod (r, x, m);
+      mpz_fdiv_r (ref, x, m);
+      if (mpz_cmp (r, ref) != 0)
+	{
+	  printf ("ERROR, 2^%d mod 2^%lu+%lu\n",
+		  2 * GMP_NUMB_BITS, data[i].k, data[i].c);
+	  abort ();
+	}
+    }
+
+  mpz_clear (m);
+  mpz_clear (x);
+  mpz_clear (r);
+  mpz_clear (ref);
+}
+
+/* r = b^e mod m by plain squaring and division, for the even moduli that
+   mpn_powm doesn't take.  */
+static void
+ref_powm (mpz_ptr r, mpz_srcptr b, mpz_srcptr e, mpz_srcptr m)
+{
+  mp_bitcnt_t i;
+
+  mpz_set_ui (r, 1);
+  for (i = mpz_sizeinbase (e, 2); i-- > 0; )
+    {
+      mpz_mul (r, r, r);
+      mpz_tdiv_r (r, r, m);
+      if (mpz_tstbit (e, i))
+	{
+	  mpz_mul (r, r, b);
+	  mpz_tdiv_r (r, r, m);
+	}
+    }
+  if (mpz_sgn (r) < 0)
+    mpz_add (r, r, m);
+}
+
+int
+main (int argc, char **argv)
+{
+  gmp_2expc_t red;
+  mpz_t mz, cz, bz, rz, refz, xz, ez;
+  mp_ptr mp, cp, xp, rp, ref, qp, ep, tp;
+  mp_size_t n, xn, en;
+  mp_bitcnt_t k, cbits;
+  int neg;
+  gmp_randstate_ptr rands;
+  int reps = COUNT;
+  int test;
+  TMP_DECL;
+
+  tests_start ();
+  TESTS_REPS (reps, argv, argc);
+  rands = RANDS;
+
+  TMP_MARK;
+  mp = TMP_ALLOC_LIMBS (MAX_N);
+  cp = TMP_ALLOC_LIMBS (MAX_N);
+  xp = TMP_ALLOC_LIMBS (MAX_XN);
+  rp = TMP_ALLOC_LIMBS (MAX_N);
+  ref = TMP_ALLOC_LIMBS (MAX_N);
+  qp = TMP_ALLOC_LIMBS (MAX_XN + 1);
+  ep = TMP_ALLOC_LIMBS (MAX_EN);
+  tp = TMP_ALLOC_LIMBS (MAX (mpn_mod_2expc_itch (MAX_XN, MAX_N),
+			     MAX (mpn_binvert_itch (MAX_N), 2 * MAX_N)));
+  mpz_init (mz);
+  mpz_init (cz);
+  mpz_init (bz);
+  mpz_init (rz);
+  mpz_init (refz);
+
+  for (test = 0; test < reps; test++)
+    {
+      /* m = 2^k - c or 2^k + c, of n limbs */
+      n = 2 + gmp_urandomm_ui (rands, MAX_N - 1);
+      neg = test & 1;
+      k = (n - 1) * GMP_NUMB_BITS + 1 - neg
+	+ gmp_urandomm_ui (rands, GMP_NUMB_BITS);
+      cbits = 1 + gmp_urandomm_ui (rands, MAX (GMP_NUMB_BITS, k / 4));
+      cbits = MIN (cbits, k - 2);	/* else 2^k - c is 2^(k-1) + c' */
+      mpz_rrandomb (cz, rands, cbits);
+      if (test % 3 == 0)
+	mpz_setbit (cz, 0);
+      mpz_set_ui (mz, 0);
+      mpz_setbit (mz, k);
+      if (neg)
+	mpz_add (mz, mz, cz);
+      else
+	mpz_sub (mz, mz, cz);
+      ASSERT_ALWAYS (mpz_size (mz) == n);
+      mpz_export (mp, NULL, -1, sizeof (mp_limb_t), 0, GMP_NAIL_BITS, mz);
+
+      if (! mpn_mod_2expc_init (&red, cp, mp, n)
+	  || red.k != k || red.neg != neg)
+	{
+	  printf ("ERROR, test %d: not recognised\n", test);
+	  mpz_trace ("  m", mz);
+	  abort ();
+	}
+
+      /* reduction, against division */
+      xn = 1 + gmp_urandomm_ui (rands, MAX_XN);
+      if (test & 2)
+	mpn_random2 (xp, xn);
+      else
+	mpn_random (xp, xn);
+      mpn_mod_2expc (rp, xp, xn, mp, n, &red, tp);
+      if (xn >= n)
+	mpn_tdiv_qr (qp, ref, 0L, xp, xn, mp, n);
+      else
+	{
+	  MPN_COPY (ref, xp, xn);
+	  MPN_ZERO (ref + xn, n - xn);
+	  if (mpn_cmp (ref, mp, n) >= 0)
+	    mpn_sub_n (ref, ref, mp, n);
+	}
+      if (mpn_cmp (rp, ref, n) != 0)
+	{
+	  printf ("ERROR, test %d: mod, xn = %ld\n", test, (long) xn);
+	  mpz_trace ("  m", mz);
+	  mpn_dump (xp, xn);
+	  mpn_dump (rp, n);
+	  mpn_dump (ref, n);
+	  abort ();
+	}
+
+      /* exponentiation, against mpn_powm for odd m, and plain squaring
+	 for even m */
+      en = 1 + gmp_urandomm_ui (rands, MAX_EN);
+      mpn_random2 (ep, en);
+      if (ep[en - 1] == 0)
+	ep[en - 1] = 1;
+      if (en == 1 && ep[0] < 2)
+	ep[0] = 2;
+      xn = 1 + gmp_urandomm_ui (rands, 2 * n);
+      mpn_random2 (xp, xn);
+      mpn_powm_2expc (rp, xp, xn, ep, en, mp, n, &red);
+      if ((mp[0] & 1) != 0)
+	mpn_powm (ref, xp, xn, ep, en, mp, n, tp);
+      else
+	{
+	  ref_powm (rz, mpz_roinit_n (xz, xp, xn), mpz_roinit_n (ez, ep, en), mz);
+	  MPN_COPY (ref, PTR (rz), SIZ (rz));
+	  MPN_ZERO (ref + SIZ (rz), n - SIZ (rz));
+	}
+      if (mpn_cmp (rp, ref, n) != 0)
+	{
+	  printf ("ERROR, test %d: powm, en = %ld\n", test, (long) en);
+	  mpz_trace ("  m", mz);
+	  abort ();
+	}
+
+      /* mpz_powm takes the same path, even m and negative b included */
+      mpz_set (bz, mpz_roinit_n (xz, xp, xn));
+      if (test & 4)
+	mpz_neg (bz, bz);
+      mpz_powm (rz, bz, mpz_roinit_n (ez, ep, en), mz);
+      ref_powm (refz, bz, ez, mz);
+      if (mpz_cmp (rz, refz) != 0)
+	{
+	  printf ("ERROR, test %d: mpz_powm, en = %ld\n", test, (long) en);
+	  mpz_trace ("  m  ", mz);
+	  mpz_trace ("  b  ", bz);
+	  mpz_trace ("  got", rz);
+	  mpz_trace ("  want", refz);
+	  abort ();
+	}
+    }
+
+  check_long (rands);
+  check_wrap ();
+
+  mpz_clear (mz);
+  mpz_clear (cz);
+  mpz_clear (bz);
+  mpz_clear (rz);
+  mpz_clear (refz);
+  TMP_FREE;
+  tests_end ();
+  return 0;
+}
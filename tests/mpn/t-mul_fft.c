@@ -0,0 +1,151 @@
+/* Test mpn_mul_fft, in particular that splitting it over threads gives
+   exactly the same result, the sqrt(2) weights, and mpn_mul_fft_precomp.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library test suite.
+
+The GNU MP Library test suite is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 3 of the License,
+or (at your option) any later version.
+
+The GNU MP Library test suite is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+the GNU MP Library test suite.  If not, see https://www.gnu.org/licenses/.  */
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "tests.h"
+
+#ifndef COUNT
+#define COUNT 20
+#endif
+
+#define MAX_PL (3 * MUL_FFT_PARALLEL_THRESHOLD)
+
+/* Check {rp,pl} + h*B^pl == a*b mod B^pl+1.  */
+static int
+check_modF (mp_srcptr rp, mp_limb_t h, mp_size_t pl,
+	    mp_srcptr ap, mp_size_t an, mp_srcptr bp, mp_size_t bn)
+{
+  mpz_t a, b, r, m, t;
+  int ok;
+
+  mpz_init_set (a, mpz_roinit_n (t, ap, an));
+  mpz_init_set (b, mpz_roinit_n (t, bp, bn));
+  mpz_init_set (r, mpz_roinit_n (t, rp, pl));
+  if (h != 0)
+    mpz_setbit (r, pl * GMP_NUMB_BITS);
+
+  mpz_init (m);
+  mpz_setbit (m, pl * GMP_NUMB_BITS);
+  mpz_add_ui (m, m, 1);
+
+  mpz_mul (a, a, b);
+  mpz_mod (a, a, m);
+  ok = mpz_cmp (a, r) == 0;
+
+  mpz_clear (a);
+  mpz_clear (b);
+  mpz_clear (r);
+  mpz_clear (m);
+  return ok;
+}
+
+static void
+dump (const char *msg, mp_size_t pl, int k, mp_size_t an, mp_size_t bn)
+{
+  printf ("ERROR, %s: pl = %ld, k = %d, an = %ld, bn = %ld\n",
+	  msg, (long) pl, k, (long) an, (long) bn);
+  abort ();
+}
+
+int
+main (int argc, char **argv)
+{
+  mp_ptr ap, bp, rp, sp, pp;
+  mp_limb_t h, hs;
+  mp_size_t pl, an, bn;
+  struct mul_fft_precomp P;
+  gmp_randstate_ptr rands;
+  int count = COUNT;
+  int test, k;
+  TMP_DECL;
+
+  tests_start ();
+  TESTS_REPS (count, argv, argc);
+  rands = RANDS;
+
+  TMP_MARK;
+  ap = TMP_ALLOC_LIMBS (MAX_PL);
+  bp = TMP_ALLOC_LIMBS (MAX_PL);
+  rp = TMP_ALLOC_LIMBS (MAX_PL);
+  sp = TMP_ALLOC_LIMBS (MAX_PL);
+  pp = TMP_ALLOC_LIMBS (4 * MAX_PL);
+
+  for (test = 0; test < count; test++)
+    {
+      /* up to k=12, where N' = j*K/2 with j odd is common and the weights
+	 need sqrt(2) */
+      k = FFT_FIRST_K + gmp_urandomm_ui (rands, 9);
+      pl = MUL_FFT_PARALLEL_THRESHOLD / 2
+	+ gmp_urandomm_ui (rands, MAX_PL - MUL_FFT_PARALLEL_THRESHOLD / 2);
+      pl = mpn_fft_next_size (pl, k);
+      if (pl > MAX_PL)
+	pl -= (mp_size_t) 1 << k;
+
+      an = 1 + gmp_urandomm_ui (rands, pl);
+      bn = 1 + gmp_urandomm_ui (rands, an);
+      mpn_random2 (ap, an);
+      mpn_random2 (bp, bn);
+
+      mp_set_num_threads (1);
+      hs = mpn_mul_fft (sp, pl, ap, an, bp, bn, k);
+      if (!check_modF (sp, hs, pl, ap, an, bp, bn))
+	dump ("wrong product", pl, k, an, bn);
+
+      mp_set_num_threads (2 + test % 7);
+      h = mpn_mul_fft (rp, pl, ap, an, bp, bn, k);
+      if (h != hs || mpn_cmp (rp, sp, pl) != 0)
+	dump ("threaded product differs", pl, k, an, bn);
+
+      h = mpn_mul_fft (rp, pl, ap, an, ap, an, k);
+      mp_set_num_threads (1);
+      hs = mpn_mul_fft (sp, pl, ap, an, ap, an, k);
+      if (h != hs || mpn_cmp (rp, sp, pl) != 0)
+	dump ("threaded square differs", pl, k, an, an);
+
+      /* The same product with b transformed beforehand.  */
+      mpn_mul_fft_precomp_init (&P, pl, bp, bn, k);
+      mp_set_num_threads (1 + test % 3);
+      hs = mpn_mul_fft (sp, pl, ap, an, bp, bn, k);
+      h = mpn_mul_fft_precomp (rp, ap, an, &P);
+      if (h != hs || mpn_cmp (rp, sp, pl) != 0)
+	dump ("precomputed product differs", pl, k, an, bn);
+      h = mpn_mul_fft_precomp (rp, bp, bn, &P);
+      hs = mpn_mul_fft (sp, pl, bp, bn, bp, bn, k);
+      if (h != hs || mpn_cmp (rp, sp, pl) != 0)
+	dump ("precomputed square differs", pl, k, bn, bn);
+      mpn_mul_fft_precomp_clear (&P);
+
+      /* A full product, through mpn_nussbaumer_mul.  */
+      mpn_mul (pp, ap, an, bp, bn);
+      mp_set_num_threads (4);
+      mpn_mul (pp + an + bn, ap, an, bp, bn);
+      if (mpn_cmp (pp, pp + an + bn, an + bn) != 0)
+	dump ("threaded mpn_mul differs", an + bn, 0, an, bn);
+    }
+
+  mp_set_num_threads (1);
+  TMP_FREE;
+  tests_end ();
+  return 0;
+}
@@ -0,0 +1,112 @@
+/* Test mpn_mul_ntt.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library test suite.
+
+The GNU MP Library test suite is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 3 of the License,
+or (at your option) any later version.
+
+The GNU MP Library test suite is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+the GNU MP Library test suite.  If not, see https://www.gnu.org/licenses/.  */
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "tests.h"
+
+#ifndef COUNT
+#define COUNT 50
+#endif
+
+#define MAX_N 20000
+
+static void
+dump (const char *msg, mp_size_t an, mp_size_t bn)
+{
+  printf ("ERROR, %s: an = %ld, bn = %ld\n", msg, (long) an, (long) bn);
+  abort ();
+}
+
+int
+main (int argc, char **argv)
+{
+  mp_ptr ap, bp, rp, sp;
+  mp_size_t an, bn;
+  gmp_randstate_ptr rands;
+  int count = COUNT;
+  int test;
+  TMP_DECL;
+
+  tests_start ();
+  TESTS_REPS (count, argv, argc);
+  rands = RANDS;
+
+  TMP_MARK;
+  ap = TMP_ALLOC_LIMBS (MAX_N);
+  bp = TMP_ALLOC_LIMBS (MAX_N);
+  rp = TMP_ALLOC_LIMBS (2 * MAX_N);
+  sp = TMP_ALLOC_LIMBS (2 * MAX_N);
+
+  for (test = 0; test < count; test++)
+    {
+      /* mostly small, so the odd transform lengths get a look in */
+      if (test % 4 == 0)
+	an = 1 + gmp_urandomm_ui (rands, MAX_N);
+      else
+	an = 1 + gmp_urandomm_ui (rands, 200);
+      bn = 1 + gmp_urandomm_ui (rands, an);
+
+      /* mpn_random2 gives long runs of ones, the largest coefficients */
+      if (test & 1)
+	{
+	  mpn_random2 (ap, an);
+	  mpn_random2 (bp, bn);
+	}
+      else
+	{
+	  mpn_random (ap, an);
+	  mpn_random (bp, bn);
+	}
+
+      mpn_mul (sp, ap, an, bp, bn);
+      mpn_mul_ntt (rp, ap, an, bp, bn);
+      if (mpn_cmp (rp, sp, an + bn) != 0)
+	dump ("wrong product", an, bn);
+
+      mpn_sqr (sp, ap, an);
+      mpn_mul_ntt (rp, ap, an, ap, an);
+      if (mpn_cmp (rp, sp, 2 * an) != 0)
+	dump ("wrong square", an, an);
+
+      mp_set_num_threads (3);
+      mpn_mul_ntt (rp, ap, an, bp, bn);
+      mp_set_num_threads (1);
+      mpn_mul (sp, ap, an, bp, bn);
+      if (mpn_cmp (rp, sp, an + bn) != 0)
+	dump ("threaded product differs", an, bn);
+    }
+
+  /* all ones, the largest possible coefficients */
+  for (an = 1; an <= MAX_N; an *= 7)
+    {
+      MPN_FILL (ap, an, GMP_NUMB_MAX);
+      mpn_sqr (sp, ap, an);
+      mpn_mul_ntt (rp, ap, an, ap, an);
+      if (mpn_cmp (rp, sp, 2 * an) != 0)
+	dump ("wrong square of all ones", an, an);
+    }
+
+  TMP_FREE;
+  tests_end ();
+  return 0;
+}
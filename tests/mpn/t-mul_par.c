@@ -0,0 +1,80 @@
+/* Test the threaded splitting of unbalanced mpn_mul products.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library test suite.
+
+The GNU MP Library test suite is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 3 of the License,
+or (at your option) any later version.
+
+The GNU MP Library test suite is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+the GNU MP Library test suite.  If not, see https://www.gnu.org/licenses/.  */
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "tests.h"
+
+#ifndef COUNT
+#define COUNT 10
+#endif
+
+/* Up to a dozen pieces of the smallest size that gets split.  */
+#define MAX_VN (2 * PARALLEL_MUL_THRESHOLD)
+#define MAX_UN (12 * PARALLEL_MUL_THRESHOLD)
+
+int
+main (int argc, char **argv)
+{
+  mp_ptr ap, bp, pp, refp;
+  mp_size_t an, bn;
+  gmp_randstate_ptr rands;
+  int count = COUNT;
+  int test;
+  TMP_DECL;
+
+  tests_start ();
+  TESTS_REPS (count, argv, argc);
+  rands = RANDS;
+
+  TMP_MARK;
+  ap = TMP_ALLOC_LIMBS (MAX_UN);
+  bp = TMP_ALLOC_LIMBS (MAX_VN);
+  pp = TMP_ALLOC_LIMBS (MAX_UN + MAX_VN);
+  refp = TMP_ALLOC_LIMBS (MAX_UN + MAX_VN);
+
+  for (test = 0; test < count; test++)
+    {
+      bn = PARALLEL_MUL_THRESHOLD
+	+ gmp_urandomm_ui (rands, MAX_VN - PARALLEL_MUL_THRESHOLD + 1);
+      an = 2 * bn + gmp_urandomm_ui (rands, MAX_UN - 2 * bn + 1);
+      mpn_random2 (ap, an);
+      mpn_random2 (bp, bn);
+
+      mp_set_num_threads (1);
+      mpn_mul (refp, ap, an, bp, bn);
+
+      mp_set_num_threads (2 + test % 5);
+      mpn_mul (pp, ap, an, bp, bn);
+      if (mpn_cmp (pp, refp, an + bn) != 0)
+	{
+	  printf ("ERROR, threaded mpn_mul: an = %ld, bn = %ld\n",
+		  (long) an, (long) bn);
+	  abort ();
+	}
+    }
+
+  mp_set_num_threads (1);
+  TMP_FREE;
+  tests_end ();
+  return 0;
+}
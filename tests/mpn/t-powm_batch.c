@@ -0,0 +1,197 @@
+/* Test mpn_powm_batch, mpn_powm_52x8 and mpn_amm52_8.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library test suite.
+
+The GNU MP Library test suite is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 3 of the License,
+or (at your option) any later version.
+
+The GNU MP Library test suite is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+the GNU MP Library test suite.  If not, see https://www.gnu.org/licenses/.  */
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "tests.h"
+
+#ifndef COUNT
+#define COUNT 20
+#endif
+
+#define MAX_N 70
+#define MAX_EN 5
+#define MAX_BATCH 20
+#define MAX_D 60
+
+#if GMP_NAIL_BITS == 0 && GMP_LIMB_BITS == 64
+#define DMASK ((CNST_LIMB(1) << 52) - 1)
+
+/* mpn_amm52_8 against refmpn_amm52_8, for a, b < 2m and 4m < 2^(52d).  */
+static void
+check_amm (gmp_randstate_ptr rands)
+{
+  mp_limb_t ap[8 * MAX_D], bp[8 * MAX_D], mp[8 * MAX_D];
+  mp_limb_t rp[8 * MAX_D], ref[8 * MAX_D], kp[8];
+  mp_limb_t inv, top;
+  mp_size_t d, j;
+  int l, test;
+
+  for (test = 0; test < 50; test++)
+    {
+      d = 2 + gmp_urandomm_ui (rands, MAX_D - 1);
+      for (l = 0; l < 8; l++)
+	{
+	  for (j = 0; j < d; j++)
+	    {
+	      mpn_random2 (mp + 8 * j + l, 1);
+	      mpn_random2 (ap + 8 * j + l, 1);
+	      mpn_random2 (bp + 8 * j + l, 1);
+	      mp[8 * j + l] &= DMASK;
+	      ap[8 * j + l] &= DMASK;
+	      bp[8 * j + l] &= DMASK;
+	    }
+	  mp[l] |= 1;
+	  top = mp[8 * (d - 1) + l] >> 2;
+	  top += top == 0;
+	  mp[8 * (d - 1) + l] = top;
+	  ap[8 * (d - 1) + l] %= 2 * top;
+	  bp[8 * (d - 1) + l] %= 2 * top;
+	  binvert_limb (inv, mp[l]);
+	  kp[l] = -inv & DMASK;
+	}
+
+      mpn_amm52_8 (rp, ap, bp, mp, kp, d);
+      refmpn_amm52_8 (ref, ap, bp, mp, kp, d);
+      if (mpn_cmp (rp, ref, 8 * d) != 0)
+	{
+	  printf ("ERROR, mpn_amm52_8, d = %ld\n", (long) d);
+	  for (j = 0; j < 8 * d; j++)
+	    if (rp[j] != ref[j])
+	      {
+		printf ("  lane %d digit %ld\n", (int) (j % 8), (long) (j / 8));
+		break;
+	      }
+	  abort ();
+	}
+
+      /* squaring, as mpn_powm_52x8 does */
+      mpn_amm52_8 (rp, ap, ap, mp, kp, d);
+      refmpn_amm52_8 (ref, ap, ap, mp, kp, d);
+      if (mpn_cmp (rp, ref, 8 * d) != 0)
+	{
+	  printf ("ERROR, mpn_amm52_8 a = b, d = %ld\n", (long) d);
+	  abort ();
+	}
+    }
+}
+#endif
+
+int
+main (int argc, char **argv)
+{
+  mp_ptr rp[MAX_BATCH];
+  mp_srcptr bp[MAX_BATCH], ep[MAX_BATCH], mp[MAX_BATCH];
+  mp_ptr b, e, m, r, ref, tp;
+  mp_size_t n, en, count, i, j;
+  gmp_randstate_ptr rands;
+  int reps = COUNT;
+  int test;
+  TMP_DECL;
+
+  tests_start ();
+  TESTS_REPS (reps, argv, argc);
+  rands = RANDS;
+
+#if GMP_NAIL_BITS == 0 && GMP_LIMB_BITS == 64
+  check_amm (rands);
+#endif
+
+  TMP_MARK;
+  b = TMP_ALLOC_LIMBS (MAX_BATCH * MAX_N);
+  e = TMP_ALLOC_LIMBS (MAX_BATCH * MAX_EN);
+  m = TMP_ALLOC_LIMBS (MAX_BATCH * MAX_N);
+  r = TMP_ALLOC_LIMBS (MAX_BATCH * MAX_N);
+  ref = TMP_ALLOC_LIMBS (MAX_N);
+  tp = TMP_ALLOC_LIMBS (MAX (mpn_binvert_itch (MAX_N), 2 * MAX_N));
+
+  for (test = 0; test < reps; test++)
+    {
+      n = 1 + gmp_urandomm_ui (rands, MAX_N);
+      en = 1 + gmp_urandomm_ui (rands, MAX_EN);
+      count = gmp_urandomm_ui (rands, MAX_BATCH + 1);
+      if (test % 4 == 0)
+	count = MAX (count, 8);
+
+      for (i = 0; i < count; i++)
+	{
+	  mpn_random2 (b + i * n, n);
+	  mpn_random2 (m + i * n, n);
+	  m[i * n] |= 1;
+	  m[i * n + n - 1] |= GMP_NUMB_HIGHBIT >> (i % GMP_NUMB_BITS);
+	  /* some bases of m or more, and some exponents with high zero
+	     limbs */
+	  if (i % 5 == 2)
+	    MPN_COPY (b + i * n, m + i * n, n);
+	  mpn_random2 (e + i * en, en);
+	  if (en > 1 && (i & 1))
+	    e[i * en + en - 1] = 0;
+	  if (mpn_zero_p (e + i * en + 1, en - 1) && e[i * en] < 2)
+	    e[i * en] = 2;
+	  bp[i] = b + i * n;
+	  ep[i] = e + i * en;
+	  mp[i] = m + i * n;
+	  rp[i] = r + i * n;
+	}
+
+      mp_set_num_threads (1 + test % 4);
+      mpn_powm_batch (rp, bp, ep, en, mp, n, count);
+      mp_set_num_threads (1);
+
+      for (i = 0; i < count; i++)
+	{
+	  j = en;
+	  MPN_NORMALIZE (e + i * en, j);
+	  mpn_powm (ref, bp[i], n, ep[i], j, mp[i], n, tp);
+	  if (mpn_cmp (rp[i], ref, n) != 0)
+	    {
+	      printf ("ERROR, item %ld of %ld: n = %ld, en = %ld\n",
+		      (long) i, (long) count, (long) n, (long) en);
+	      abort ();
+	    }
+	}
+
+#if GMP_NAIL_BITS == 0 && GMP_LIMB_BITS == 64
+      /* the 8 lanes directly, whatever mpn_powm_batch chose */
+      if (count >= 8)
+	{
+	  mpn_powm_52x8 (rp, bp, ep, en, mp, n);
+	  for (i = 0; i < 8; i++)
+	    {
+	      j = en;
+	      MPN_NORMALIZE (e + i * en, j);
+	      mpn_powm (ref, bp[i], n, ep[i], j, mp[i], n, tp);
+	      if (mpn_cmp (rp[i], ref, n) != 0)
+		{
+		  printf ("ERROR, mpn_powm_52x8 lane %ld: n = %ld, en = %ld\n",
+			  (long) i, (long) n, (long) en);
+		  abort ();
+		}
+	    }
+	}
+#endif
+    }
+
+  TMP_FREE;
+  tests_end ();
+  return 0;
+}
@@ -0,0 +1,158 @@
+/* Test the threaded products of mpn_toom44_mul, mpn_toom6h_mul and
+   mpn_toom8h_mul, and the threaded squares of mpn_toom4_sqr, mpn_toom6_sqr
+   and mpn_toom8_sqr.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library test suite.
+
+The GNU MP Library test suite is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 3 of the License,
+or (at your option) any later version.
+
+The GNU MP Library test suite is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+the GNU MP Library test suite.  If not, see https://www.gnu.org/licenses/.  */
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "tests.h"
+
+#ifndef COUNT
+#define COUNT 10
+#endif
+
+#define MAX_AN (3 * MAX (MUL_TOOM_PARALLEL_THRESHOLD,			\
+			 SQR_TOOM_PARALLEL_THRESHOLD))
+
+/* The smallest bn each function takes, as in t-toom44.c, t-toom6h.c and
+   t-toom8h.c.  */
+static mp_size_t
+min_bn (int f, mp_size_t an)
+{
+  switch (f) {
+  case 0:
+    return 1 + 3*((an + 3) >> 2);
+  case 1:
+    return MAX ((an*3) >> 3, 46);
+  default:
+    return MAX (GMP_NUMB_BITS <= 10*3 ? (an*6)/10 :
+		GMP_NUMB_BITS <= 11*3 ? (an*5)/11 :
+		GMP_NUMB_BITS <= 12*3 ? (an*4)/12 :
+		(an*4)/13, 86);
+  }
+}
+
+static void
+toom (int f, mp_ptr pp, mp_srcptr ap, mp_size_t an, mp_srcptr bp, mp_size_t bn,
+      mp_ptr scratch)
+{
+  switch (f) {
+  case 0:
+    mpn_toom44_mul (pp, ap, an, bp, bn, scratch);
+    break;
+  case 1:
+    mpn_toom6h_mul (pp, ap, an, bp, bn, scratch);
+    break;
+  default:
+    mpn_toom8h_mul (pp, ap, an, bp, bn, scratch);
+    break;
+  }
+}
+
+static void
+toom_sqr (int f, mp_ptr pp, mp_srcptr ap, mp_size_t an, mp_ptr scratch)
+{
+  switch (f) {
+  case 0:
+    mpn_toom4_sqr (pp, ap, an, scratch);
+    break;
+  case 1:
+    mpn_toom6_sqr (pp, ap, an, scratch);
+    break;
+  default:
+    mpn_toom8_sqr (pp, ap, an, scratch);
+    break;
+  }
+}
+
+static const char *const name[3] = { "toom44", "toom6h", "toom8h" };
+static const char *const sqr_name[3] = { "toom4_sqr", "toom6_sqr", "toom8_sqr" };
+
+int
+main (int argc, char **argv)
+{
+  mp_ptr ap, bp, pp, refp, scratch;
+  mp_size_t an, bn, itch;
+  gmp_randstate_ptr rands;
+  int count = COUNT;
+  int test, f;
+  TMP_DECL;
+
+  tests_start ();
+  TESTS_REPS (count, argv, argc);
+  rands = RANDS;
+
+  TMP_MARK;
+  ap = TMP_ALLOC_LIMBS (MAX_AN);
+  bp = TMP_ALLOC_LIMBS (MAX_AN);
+  pp = TMP_ALLOC_LIMBS (2 * MAX_AN);
+  refp = TMP_ALLOC_LIMBS (2 * MAX_AN);
+  itch = MAX (mpn_toom44_mul_itch (MAX_AN, MAX_AN),
+	      MAX (mpn_toom6h_mul_itch (MAX_AN, MAX_AN),
+		   mpn_toom8h_mul_itch (MAX_AN, MAX_AN)));
+  itch = MAX (itch, MAX (mpn_toom4_sqr_itch (MAX_AN),
+			 MAX (mpn_toom6_sqr_itch (MAX_AN),
+			      mpn_toom8_sqr_itch (MAX_AN))));
+  scratch = TMP_ALLOC_LIMBS (itch);
+
+  for (test = 0; test < count; test++)
+    {
+      f = test % 3;
+      an = MUL_TOOM_PARALLEL_THRESHOLD
+	+ gmp_urandomm_ui (rands, MAX_AN - MUL_TOOM_PARALLEL_THRESHOLD + 1);
+      bn = min_bn (f, an) + gmp_urandomm_ui (rands, an - min_bn (f, an) + 1);
+      mpn_random2 (ap, an);
+      mpn_random2 (bp, bn);
+
+      mp_set_num_threads (1);
+      mpn_mul (refp, ap, an, bp, bn);
+
+      mp_set_num_threads (2 + test % 5);
+      toom (f, pp, ap, an, bp, bn, scratch);
+      if (mpn_cmp (pp, refp, an + bn) != 0)
+	{
+	  printf ("ERROR, threaded %s: an = %ld, bn = %ld\n",
+		  name[f], (long) an, (long) bn);
+	  abort ();
+	}
+
+      an = SQR_TOOM_PARALLEL_THRESHOLD
+	+ gmp_urandomm_ui (rands, MAX_AN - SQR_TOOM_PARALLEL_THRESHOLD + 1);
+      mpn_random2 (ap, an);
+
+      mp_set_num_threads (1);
+      mpn_sqr (refp, ap, an);
+
+      mp_set_num_threads (2 + test % 5);
+      toom_sqr (f, pp, ap, an, scratch);
+      if (mpn_cmp (pp, refp, 2 * an) != 0)
+	{
+	  printf ("ERROR, threaded %s: an = %ld\n", sqr_name[f], (long) an);
+	  abort ();
+	}
+    }
+
+  mp_set_num_threads (1);
+  TMP_FREE;
+  tests_end ();
+  return 0;
+}
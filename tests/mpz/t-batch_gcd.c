@@ -0,0 +1,146 @@
+/* Test mpz_batch_gcd and mpz_batch_gcd_bounded.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library test suite.
+
+The GNU MP Library test suite is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 3 of the License,
+or (at your option) any later version.
+
+The GNU MP Library test suite is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+the GNU MP Library test suite.  If not, see https://www.gnu.org/licenses/.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "tests.h"
+
+#ifndef COUNT
+#define COUNT 100
+#endif
+
+#define MAX_N 100
+#define MAX_PBITS 300
+
+int
+main (int argc, char **argv)
+{
+  mpz_t *a, *g, *p;
+  mpz_ptr *gp;
+  mpz_srcptr *ap;
+  mpz_t want, t;
+  size_t n, np, i, j, group;
+  gmp_randstate_ptr rands;
+  int count = COUNT;
+  int test;
+
+  tests_start ();
+  TESTS_REPS (count, argv, argc);
+  rands = RANDS;
+
+  a = (mpz_t *) tests_allocate (MAX_N * sizeof (mpz_t));
+  g = (mpz_t *) tests_allocate (MAX_N * sizeof (mpz_t));
+  p = (mpz_t *) tests_allocate (2 * MAX_N * sizeof (mpz_t));
+  ap = (mpz_srcptr *) tests_allocate (MAX_N * sizeof (mpz_srcptr));
+  gp = (mpz_ptr *) tests_allocate (MAX_N * sizeof (mpz_ptr));
+  for (i = 0; i < MAX_N; i++)
+    {
+      mpz_init (a[i]);
+      mpz_init (g[i]);
+    }
+  for (i = 0; i < 2 * MAX_N; i++)
+    mpz_init (p[i]);
+  mpz_init (want);
+  mpz_init (t);
+
+  for (test = 0; test < count; test++)
+    {
+      n = gmp_urandomm_ui (rands, MAX_N + 1);
+
+      /* products of two primes from a pool, some of them shared */
+      np = 1 + gmp_urandomm_ui (rands, 2 * n + 1);
+      for (j = 0; j < np; j++)
+	{
+	  mpz_urandomb (p[j], rands, 2 + gmp_urandomm_ui (rands, MAX_PBITS));
+	  mpz_nextprime (p[j], p[j]);
+	}
+      for (i = 0; i < n; i++)
+	{
+	  mpz_mul (a[i], p[gmp_urandomm_ui (rands, np)],
+		   p[gmp_urandomm_ui (rands, np)]);
+	  if (gmp_urandomm_ui (rands, 40) == 0)
+	    mpz_set_ui (a[i], 1);
+	  if (gmp_urandomb_ui (rands, 2) == 0)
+	    mpz_neg (a[i], a[i]);
+	  ap[i] = a[i];
+	  gp[i] = g[i];
+	}
+
+      if (test % 5 == 4)
+	mp_set_num_threads (2 + test % 4);
+
+      group = test & 1 ? 0 : gmp_urandomm_ui (rands, n + 2);
+      mpz_batch_gcd_bounded (gp, ap, n, group);
+
+      for (i = 0; i < n; i++)
+	{
+	  mpz_set_ui (t, 1);
+	  for (j = 0; j < n; j++)
+	    if (j != i)
+	      mpz_mul (t, t, a[j]);
+	  mpz_gcd (want, t, a[i]);
+	  MPZ_CHECK_FORMAT (g[i]);
+	  if (mpz_cmp (g[i], want) != 0)
+	    {
+	      printf ("ERROR, test %d: element %lu of %lu, group %lu\n",
+		      test, (unsigned long) i, (unsigned long) n,
+		      (unsigned long) group);
+	      mpz_trace ("  a   ", a[i]);
+	      mpz_trace ("  got ", g[i]);
+	      mpz_trace ("  want", want);
+	      abort ();
+	    }
+	}
+
+      /* results in place */
+      if (test % 3 == 0)
+	{
+	  mpz_batch_gcd ((const mpz_ptr *) ap, ap, n);
+	  for (i = 0; i < n; i++)
+	    if (mpz_cmp (a[i], g[i]) != 0)
+	      {
+		printf ("ERROR, test %d: in place, element %lu\n",
+			test, (unsigned long) i);
+		abort ();
+	      }
+	}
+
+      mp_set_num_threads (1);
+    }
+
+  for (i = 0; i < MAX_N; i++)
+    {
+      mpz_clear (a[i]);
+      mpz_clear (g[i]);
+    }
+  for (i = 0; i < 2 * MAX_N; i++)
+    mpz_clear (p[i]);
+  tests_free (a, MAX_N * sizeof (mpz_t));
+  tests_free (g, MAX_N * sizeof (mpz_t));
+  tests_free (p, 2 * MAX_N * sizeof (mpz_t));
+  tests_free (ap, MAX_N * sizeof (mpz_srcptr));
+  tests_free (gp, MAX_N * sizeof (mpz_ptr));
+  mpz_clear (want);
+  mpz_clear (t);
+  tests_end ();
+  return 0;
+}
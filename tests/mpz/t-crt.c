@@ -0,0 +1,178 @@
+/* Test mpz_crt_basis_t functions.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library test suite.
+
+The GNU MP Library test suite is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 3 of the License,
+or (at your option) any later version.
+
+The GNU MP Library test suite is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+the GNU MP Library test suite.  If not, see https://www.gnu.org/licenses/.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "tests.h"
+
+#ifndef COUNT
+#define COUNT 100
+#endif
+
+#define MAX_K 200
+#define MAX_MBITS 500
+
+int
+main (int argc, char **argv)
+{
+  mpz_t *m, *r;
+  mpz_srcptr *mp, *rp;
+  mpz_crt_basis_t b;
+  mpz_t x, got, prod, g;
+  size_t k, i;
+  unsigned long mbits;
+  gmp_randstate_ptr rands;
+  int count = COUNT;
+  int test, ok;
+
+  tests_start ();
+  TESTS_REPS (count, argv, argc);
+  rands = RANDS;
+
+  m = (mpz_t *) tests_allocate (MAX_K * sizeof (mpz_t));
+  r = (mpz_t *) tests_allocate (MAX_K * sizeof (mpz_t));
+  mp = (mpz_srcptr *) tests_allocate (MAX_K * sizeof (mpz_srcptr));
+  rp = (mpz_srcptr *) tests_allocate (MAX_K * sizeof (mpz_srcptr));
+  for (i = 0; i < MAX_K; i++)
+    {
+      mpz_init (m[i]);
+      mpz_init (r[i]);
+      mp[i] = m[i];
+      rp[i] = r[i];
+    }
+  mpz_init (x);
+  mpz_init (got);
+  mpz_init (prod);
+  mpz_init (g);
+
+  for (test = 0; test < count; test++)
+    {
+      k = gmp_urandomm_ui (rands, MAX_K + 1);
+      mbits = test % 4 == 0 ? GMP_NUMB_BITS : MAX_MBITS;
+
+      /* coprime moduli, primes and some prime powers and ones */
+      mpz_set_ui (prod, 1);
+      for (i = 0; i < k; i++)
+	{
+	  do
+	    {
+	      mpz_urandomb (m[i], rands, 1 + gmp_urandomm_ui (rands, mbits));
+	      mpz_nextprime (m[i], m[i]);
+	      if (gmp_urandomm_ui (rands, 8) == 0)
+		mpz_mul (m[i], m[i], m[i]);
+	      if (gmp_urandomm_ui (rands, 50) == 0)
+		mpz_set_ui (m[i], 1);
+	      mpz_gcd (g, m[i], prod);
+	    }
+	  while (mpz_cmp_ui (g, 1) != 0);
+	  mpz_mul (prod, prod, m[i]);
+	  if (gmp_urandomb_ui (rands, 2) == 0)
+	    mpz_neg (m[i], m[i]);
+	}
+
+      if (test % 5 == 4)
+	mp_set_num_threads (2 + test % 4);
+
+      ok = mpz_crt_basis_init (b, mp, k);
+      if (! ok)
+	{
+	  printf ("ERROR, test %d: coprime moduli rejected\n", test);
+	  abort ();
+	}
+
+      /* residues of some x in [0,M), not necessarily reduced */
+      mpz_urandomm (x, rands, prod);
+      for (i = 0; i < k; i++)
+	{
+	  mpz_mod (r[i], x, m[i]);
+	  if (gmp_urandomm_ui (rands, 4) == 0)
+	    {
+	      mpz_urandomb (g, rands, gmp_urandomm_ui (rands, 2 * MAX_MBITS));
+	      if (gmp_urandomb_ui (rands, 1))
+		mpz_submul (r[i], g, m[i]);
+	      else
+		mpz_addmul (r[i], g, m[i]);
+	    }
+	  else if (gmp_urandomm_ui (rands, 4) == 0)
+	    mpz_sub (r[i], r[i], m[i]);
+	}
+
+      mpz_crt_combine (got, rp, b);
+      MPZ_CHECK_FORMAT (got);
+      if (mpz_cmp (got, x) != 0)
+	{
+	  printf ("ERROR, test %d: k=%lu\n", test, (unsigned long) k);
+	  mpz_trace ("  got ", got);
+	  mpz_trace ("  want", x);
+	  abort ();
+	}
+
+      /* result in place of a residue */
+      if (k != 0)
+	{
+	  i = gmp_urandomm_ui (rands, k);
+	  mpz_crt_combine (r[i], rp, b);
+	  if (mpz_cmp (r[i], x) != 0)
+	    {
+	      printf ("ERROR, test %d: in place, k=%lu\n",
+		      test, (unsigned long) k);
+	      mpz_trace ("  got ", r[i]);
+	      mpz_trace ("  want", x);
+	      abort ();
+	    }
+	}
+      mpz_crt_basis_clear (b);
+
+      /* moduli with a common factor */
+      if (k >= 2 && mpz_cmpabs_ui (m[k - 1], 1) != 0)
+	{
+	  i = gmp_urandomm_ui (rands, k - 1);
+	  mpz_set (g, m[i]);
+	  mpz_mul (m[i], m[i], m[k - 1]);
+	  if (mpz_crt_basis_init (b, mp, k))
+	    {
+	      printf ("ERROR, test %d: common factor not found\n", test);
+	      abort ();
+	    }
+	  mpz_crt_basis_clear (b);
+	  mpz_set (m[i], g);
+	}
+
+      mp_set_num_threads (1);
+    }
+
+  for (i = 0; i < MAX_K; i++)
+    {
+      mpz_clear (m[i]);
+      mpz_clear (r[i]);
+    }
+  tests_free (m, MAX_K * sizeof (mpz_t));
+  tests_free (r, MAX_K * sizeof (mpz_t));
+  tests_free (mp, MAX_K * sizeof (mpz_srcptr));
+  tests_free (rp, MAX_K * sizeof (mpz_srcptr));
+  mpz_clear (x);
+  mpz_clear (got);
+  mpz_clear (prod);
+  mpz_clear (g);
+  tests_end ();
+  return 0;
+}
@@ -0,0 +1,137 @@
+/* Test mpz_divisor_t functions.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library test suite.
+
+The GNU MP Library test suite is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 3 of the License,
+or (at your option) any later version.
+
+The GNU MP Library test suite is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+the GNU MP Library test suite.  If not, see https://www.gnu.org/licenses/.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "tests.h"
+
+#ifndef COUNT
+#define COUNT 200
+#endif
+
+#define MAX_DBITS 3000
+#define MAX_BIG_DBITS 40000
+
+static void
+check_one (const char *name, int test, mpz_srcptr n, mpz_srcptr d,
+	   mpz_srcptr got, mpz_srcptr want)
+{
+  MPZ_CHECK_FORMAT (got);
+  if (mpz_cmp (got, want) != 0)
+    {
+      printf ("ERROR, test %d: %s\n", test, name);
+      mpz_trace ("  n   ", n);
+      mpz_trace ("  d   ", d);
+      mpz_trace ("  got ", got);
+      mpz_trace ("  want", want);
+      abort ();
+    }
+}
+
+int
+main (int argc, char **argv)
+{
+  mpz_divisor_t D;
+  mpz_t n, d, q, r, wq, wr, t;
+  gmp_randstate_ptr rands;
+  unsigned long dbits;
+  int count = COUNT;
+  int test, i;
+
+  tests_start ();
+  TESTS_REPS (count, argv, argc);
+  rands = RANDS;
+
+  mpz_init (n);
+  mpz_init (d);
+  mpz_init (q);
+  mpz_init (r);
+  mpz_init (wq);
+  mpz_init (wr);
+  mpz_init (t);
+
+  for (test = 0; test < count; test++)
+    {
+      /* now and then a divisor past the mu thresholds */
+      dbits = 1 + gmp_urandomm_ui (rands, test % 10 == 0
+				   ? MAX_BIG_DBITS : MAX_DBITS);
+      do
+	mpz_rrandomb (d, rands, dbits);
+      while (mpz_sgn (d) == 0);
+      /* even divisors, for the odd part in divexact */
+      if (test % 4 == 1)
+	mpz_mul_2exp (d, d, gmp_urandomm_ui (rands, 3 * GMP_NUMB_BITS));
+      if (test & 2)
+	mpz_neg (d, d);
+
+      mpz_divisor_init (D, d);
+
+      for (i = 0; i < 4; i++)
+	{
+	  if (i & 1)
+	    mpz_rrandomb (n, rands, gmp_urandomm_ui (rands, 3 * dbits + 200));
+	  else
+	    mpz_urandomb (n, rands, gmp_urandomm_ui (rands, 3 * dbits + 200));
+	  if (i & 2)
+	    mpz_neg (n, n);
+
+	  mpz_tdiv_qr (wq, wr, n, d);
+	  mpz_tdiv_qr_pre (q, r, n, D);
+	  check_one ("tdiv_qr q", test, n, d, q, wq);
+	  check_one ("tdiv_qr r", test, n, d, r, wr);
+
+	  /* in place, q = n and r = n */
+	  mpz_set (q, n);
+	  mpz_tdiv_qr_pre (q, r, q, D);
+	  check_one ("tdiv_qr q=n", test, n, d, q, wq);
+	  mpz_set (r, n);
+	  mpz_tdiv_qr_pre (q, r, r, D);
+	  check_one ("tdiv_qr r=n", test, n, d, r, wr);
+
+	  mpz_mod (wr, n, d);
+	  mpz_mod_pre (r, n, D);
+	  check_one ("mod", test, n, d, r, wr);
+	  mpz_set (r, n);
+	  mpz_mod_pre (r, r, D);
+	  check_one ("mod r=n", test, n, d, r, wr);
+
+	  /* an exact n d / d */
+	  mpz_mul (t, n, d);
+	  mpz_divexact_pre (q, t, D);
+	  check_one ("divexact", test, t, d, q, n);
+	  mpz_divexact_pre (t, t, D);
+	  check_one ("divexact q=n", test, t, d, t, n);
+	}
+
+      mpz_divisor_clear (D);
+    }
+
+  mpz_clear (n);
+  mpz_clear (d);
+  mpz_clear (q);
+  mpz_clear (r);
+  mpz_clear (wq);
+  mpz_clear (wr);
+  mpz_clear (t);
+  tests_end ();
+  return 0;
+}
@@ -0,0 +1,143 @@
+/* Test mpz_invert_batch.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library test suite.
+
+The GNU MP Library test suite is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 3 of the License,
+or (at your option) any later version.
+
+The GNU MP Library test suite is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+the GNU MP Library test suite.  If not, see https://www.gnu.org/licenses/.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "tests.h"
+
+#ifndef COUNT
+#define COUNT 100
+#endif
+
+#define MAX_K 600
+#define MAX_MBITS 1000
+
+int
+main (int argc, char **argv)
+{
+  mpz_t *a, *r;
+  mpz_ptr *rp;
+  mpz_srcptr *ap;
+  mpz_t m, want;
+  size_t k, i, got, expect;
+  gmp_randstate_ptr rands;
+  int count = COUNT;
+  int test;
+
+  tests_start ();
+  TESTS_REPS (count, argv, argc);
+  rands = RANDS;
+
+  a = (mpz_t *) tests_allocate (MAX_K * sizeof (mpz_t));
+  r = (mpz_t *) tests_allocate (MAX_K * sizeof (mpz_t));
+  ap = (mpz_srcptr *) tests_allocate (MAX_K * sizeof (mpz_srcptr));
+  rp = (mpz_ptr *) tests_allocate (MAX_K * sizeof (mpz_ptr));
+  for (i = 0; i < MAX_K; i++)
+    {
+      mpz_init (a[i]);
+      mpz_init (r[i]);
+    }
+  mpz_init (m);
+  mpz_init (want);
+
+  for (test = 0; test < count; test++)
+    {
+      k = gmp_urandomm_ui (rands, MAX_K + 1);
+      mpz_rrandomb (m, rands, 1 + gmp_urandomm_ui (rands, MAX_MBITS));
+      /* mostly prime moduli, as in the usual use, where only zeros fail */
+      if (test % 4 != 0)
+	mpz_nextprime (m, m);
+      if (test % 50 == 1)
+	mpz_set_ui (m, 1);
+      if (test & 1)
+	mpz_neg (m, m);
+
+      for (i = 0; i < k; i++)
+	{
+	  mpz_urandomb (a[i], rands,
+			gmp_urandomm_ui (rands, 2 * MAX_MBITS));
+	  if (gmp_urandomm_ui (rands, 30) == 0)
+	    mpz_mul (a[i], a[i], m);
+	  if (gmp_urandomb_ui (rands, 1))
+	    mpz_neg (a[i], a[i]);
+	  ap[i] = a[i];
+	  rp[i] = r[i];
+	}
+
+      /* now and then results in place */
+      if (test % 3 == 2)
+	{
+	  for (i = 0; i < k; i++)
+	    mpz_set (r[i], a[i]);
+	  for (i = 0; i < k; i++)
+	    ap[i] = r[i];
+	}
+
+      if (test % 5 == 4)
+	mp_set_num_threads (2 + test % 4);
+      got = mpz_invert_batch (rp, ap, k, m);
+      mp_set_num_threads (1);
+
+      expect = 0;
+      for (i = 0; i < k; i++)
+	{
+	  MPZ_CHECK_FORMAT (r[i]);
+	  if (mpz_invert (want, a[i], m))
+	    expect++;
+	  else
+	    mpz_set_ui (want, 0);
+	  if (mpz_cmpabs_ui (m, 1) == 0)
+	    mpz_set_ui (want, 0);
+	  if (mpz_cmp (r[i], want) != 0)
+	    {
+	      printf ("ERROR, test %d: element %lu of %lu\n",
+		      test, (unsigned long) i, (unsigned long) k);
+	      mpz_trace ("  m   ", m);
+	      mpz_trace ("  a   ", a[i]);
+	      mpz_trace ("  got ", r[i]);
+	      mpz_trace ("  want", want);
+	      abort ();
+	    }
+	}
+      if (got != expect)
+	{
+	  printf ("ERROR, test %d: returned %lu, expected %lu\n",
+		  test, (unsigned long) got, (unsigned long) expect);
+	  mpz_trace ("  m", m);
+	  abort ();
+	}
+    }
+
+  for (i = 0; i < MAX_K; i++)
+    {
+      mpz_clear (a[i]);
+      mpz_clear (r[i]);
+    }
+  tests_free (a, MAX_K * sizeof (mpz_t));
+  tests_free (r, MAX_K * sizeof (mpz_t));
+  tests_free (ap, MAX_K * sizeof (mpz_srcptr));
+  tests_free (rp, MAX_K * sizeof (mpz_ptr));
+  mpz_clear (m);
+  mpz_clear (want);
+  tests_end ();
+  return 0;
+}
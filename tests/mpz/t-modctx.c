@@ -0,0 +1,165 @@
+/* Test mpz_modctx_t functions.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library test suite.
+
+The GNU MP Library test suite is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 3 of the License,
+or (at your option) any later version.
+
+The GNU MP Library test suite is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+the GNU MP Library test suite.  If not, see https://www.gnu.org/licenses/.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "tests.h"
+
+#ifndef COUNT
+#define COUNT 200
+#endif
+
+#define MAX_MBITS 3000
+#define MAX_EBITS 500
+
+static void
+check_one (const char *name, int test, mpz_srcptr m,
+	   mpz_srcptr got, mpz_srcptr want)
+{
+  MPZ_CHECK_FORMAT (got);
+  if (mpz_cmp (got, want) != 0)
+    {
+      printf ("ERROR, test %d: %s\n", test, name);
+      mpz_trace ("  m   ", m);
+      mpz_trace ("  got ", got);
+      mpz_trace ("  want", want);
+      abort ();
+    }
+}
+
+int
+main (int argc, char **argv)
+{
+  mpz_modctx_t ctx;
+  mpz_t m, a, b, e, am, bm, got, want, t;
+  gmp_randstate_ptr rands;
+  int count = COUNT;
+  int test;
+
+  tests_start ();
+  TESTS_REPS (count, argv, argc);
+  rands = RANDS;
+
+  mpz_init (m);
+  mpz_init (a);
+  mpz_init (b);
+  mpz_init (e);
+  mpz_init (am);
+  mpz_init (bm);
+  mpz_init (got);
+  mpz_init (want);
+  mpz_init (t);
+
+  for (test = 0; test < count; test++)
+    {
+      mpz_rrandomb (m, rands, 1 + gmp_urandomm_ui (rands, MAX_MBITS));
+      /* mostly odd moduli, the even ones and 1 have no table */
+      if (test % 8 != 0)
+	mpz_setbit (m, 0);
+      if (test % 50 == 1)
+	mpz_set_ui (m, 1);
+      /* some 2^k - c and 2^k + c, which are reduced by folding */
+      if (test % 5 == 2)
+	{
+	  mpz_urandomb (t, rands, gmp_urandomm_ui (rands, 2 * GMP_NUMB_BITS));
+	  mpz_set_ui (m, 0);
+	  mpz_setbit (m, 3 * GMP_NUMB_BITS
+		      + gmp_urandomm_ui (rands, MAX_MBITS));
+	  if (test & 4)
+	    mpz_add (m, m, t);
+	  else
+	    mpz_sub (m, m, t);
+	}
+      if (test & 1)
+	mpz_neg (m, m);
+
+      mpz_rrandomb (a, rands, gmp_urandomm_ui (rands, 2 * MAX_MBITS));
+      mpz_urandomb (b, rands, gmp_urandomm_ui (rands, 2 * MAX_MBITS));
+      if (test & 2)
+	mpz_neg (a, a);
+      mpz_urandomb (e, rands, gmp_urandomm_ui (rands, MAX_EBITS));
+
+      mpz_modctx_init (ctx, m);
+
+      /* round trip */
+      mpz_to_mont_ctx (am, a, ctx);
+      mpz_to_mont_ctx (bm, b, ctx);
+      MPZ_CHECK_FORMAT (am);
+      mpz_from_mont_ctx (got, am, ctx);
+      mpz_mod (want, a, m);
+      check_one ("to/from", test, m, got, want);
+
+      /* product */
+      mpz_mulmod_ctx (got, am, bm, ctx);
+      mpz_from_mont_ctx (got, got, ctx);
+      mpz_mul (want, a, b);
+      mpz_mod (want, want, m);
+      check_one ("mulmod", test, m, got, want);
+
+      /* square, and in place */
+      mpz_set (got, am);
+      mpz_sqrmod_ctx (got, got, ctx);
+      mpz_from_mont_ctx (got, got, ctx);
+      mpz_mul (want, a, a);
+      mpz_mod (want, want, m);
+      check_one ("sqrmod", test, m, got, want);
+
+      /* power, including zero exponents */
+      if (test % 10 == 5)
+	mpz_set_ui (e, 0);
+      mpz_powm_ctx (got, am, e, ctx);
+      mpz_from_mont_ctx (got, got, ctx);
+      mpz_powm (want, a, e, m);
+      check_one ("powm", test, m, got, want);
+
+      /* negative exponent, when invertible */
+      if (mpz_invert (t, a, m))
+	{
+	  mpz_neg (e, e);
+	  mpz_powm_ctx (got, am, e, ctx);
+	  mpz_from_mont_ctx (got, got, ctx);
+	  mpz_powm (want, a, e, m);
+	  check_one ("powm negative", test, m, got, want);
+	}
+
+      /* operands not already in [0,m) are reduced first */
+      mpz_mulmod_ctx (got, a, b, ctx);
+      mpz_mod (t, a, m);
+      mpz_mod (want, b, m);
+      mpz_mulmod_ctx (want, t, want, ctx);
+      check_one ("unreduced", test, m, got, want);
+
+      mpz_modctx_clear (ctx);
+    }
+
+  mpz_clear (m);
+  mpz_clear (a);
+  mpz_clear (b);
+  mpz_clear (e);
+  mpz_clear (am);
+  mpz_clear (bm);
+  mpz_clear (got);
+  mpz_clear (want);
+  mpz_clear (t);
+  tests_end ();
+  return 0;
+}
@@ -0,0 +1,100 @@
+/* Test mpz_mul_precomp.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library test suite.
+
+The GNU MP Library test suite is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 3 of the License,
+or (at your option) any later version.
+
+The GNU MP Library test suite is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+the GNU MP Library test suite.  If not, see https://www.gnu.org/licenses/.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "tests.h"
+
+#ifndef COUNT
+#define COUNT 10
+#endif
+
+/* Enough to get well into FFT range, both for the precomputed operand and
+   for the other one.  */
+#define MAX_BITS (3 * MUL_FFT_THRESHOLD * GMP_NUMB_BITS)
+
+static void
+dump (const char *msg, mpz_srcptr a, mpz_srcptr b, mp_bitcnt_t abits)
+{
+  printf ("ERROR, %s: abits = %lu\n", msg, (unsigned long) abits);
+  printf ("  a size %ld, b size %ld\n", (long) SIZ (a), (long) SIZ (b));
+  abort ();
+}
+
+int
+main (int argc, char **argv)
+{
+  mpz_mul_precomp_t P;
+  mpz_t a, b, got, want;
+  mp_bitcnt_t abits;
+  gmp_randstate_ptr rands;
+  int count = COUNT;
+  int test, j;
+
+  tests_start ();
+  TESTS_REPS (count, argv, argc);
+  rands = RANDS;
+
+  mpz_init (a);
+  mpz_init (b);
+  mpz_init (got);
+  mpz_init (want);
+
+  for (test = 0; test < count; test++)
+    {
+      mpz_rrandomb (b, rands, 1 + gmp_urandomm_ui (rands, MAX_BITS));
+      if (test & 1)
+	mpz_neg (b, b);
+      abits = 1 + gmp_urandomm_ui (rands, MAX_BITS);
+      mpz_mul_precomp_init (P, b, abits);
+
+      for (j = 0; j < 4; j++)
+	{
+	  /* sizes from zero to a bit over abits, the latter go to mpz_mul */
+	  mpz_rrandomb (a, rands, gmp_urandomm_ui (rands, abits + abits / 8));
+	  if (j & 1)
+	    mpz_neg (a, a);
+	  /* a full sized operand too, the ones that use the transform */
+	  if (j == 3)
+	    mpz_rrandomb (a, rands, abits);
+
+	  mpz_mul (want, a, b);
+	  mpz_mul_precomp (got, a, P);
+	  MPZ_CHECK_FORMAT (got);
+	  if (mpz_cmp (got, want) != 0)
+	    dump ("wrong product", a, b, abits);
+
+	  mpz_mul_precomp (a, a, P);
+	  if (mpz_cmp (a, want) != 0)
+	    dump ("wrong product in place", a, b, abits);
+	}
+
+      mpz_mul_precomp_clear (P);
+    }
+
+  mpz_clear (a);
+  mpz_clear (b);
+  mpz_clear (got);
+  mpz_clear (want);
+  tests_end ();
+  return 0;
+}
@@ -33,6 +33,14 @@ refmpz_nextprime (mpz_ptr p, mpz_srcptr t)
     mpz_add_ui (p, p, 1L);
 }
 
+void
+refmpz_prevprime (mpz_ptr p, mpz_srcptr t)
+{
+  mpz_sub_ui (p, t, 1L);
+  while (! mpz_probab_prime_p (p, 10))
+    mpz_sub_ui (p, p, 1L);
+}
+
 void
 run (const char *start, int reps, const char *end, short diffs[])
 {
@@ -72,6 +80,96 @@ extern short diff3[];
 extern short diff4[];
 extern short diff5[];
 
+/* Step back through the same primes as run() with diff1.  */
+void
+run_prev (void)
+{
+  mpz_t x, y;
+  int i, ret;
+
+  mpz_init_set_ui (x, 0x1ef7);
+  mpz_init (y);
+
+  for (i = 999; i >= 0; i--)
+    {
+      ret = mpz_prevprime (y, x);
+      mpz_sub (x, x, y);
+      if (ret != 2 || diff1[i] != mpz_get_ui (x))
+	{
+	  gmp_printf ("prevprime diff list discrepancy at %d\n", i);
+	  abort ();
+	}
+      mpz_set (x, y);
+    }
+  if (mpz_cmp_ui (x, 2) != 0)
+    abort ();
+
+  /* nothing below 2 */
+  for (i = -3; i <= 2; i++)
+    {
+      mpz_set_si (x, i);
+      mpz_set_ui (y, 17);
+      if (mpz_prevprime (y, x) != 0 || mpz_cmp_ui (y, 17) != 0)
+	{
+	  printf ("prevprime of %d\n", i);
+	  abort ();
+	}
+    }
+
+  mpz_clear (y);
+  mpz_clear (x);
+}
+
+/* With threads the candidates are tested in parallel, which mustn't change
+   the prime found.  */
+static void
+run_threads (int reps)
+{
+  gmp_randstate_ptr rands = RANDS;
+  mpz_t x, p, want;
+  int i, threads;
+
+  mpz_init (x);
+  mpz_init (p);
+  mpz_init (want);
+
+  for (i = 0; i < reps; i++)
+    {
+      mpz_urandomb (x, rands, 200 + gmp_urandomm_ui (rands, 600));
+      threads = 2 + i % 4;
+
+      mpz_nextprime (want, x);
+      mp_set_num_threads (threads);
+      mpz_nextprime (p, x);
+      mp_set_num_threads (1);
+      if (mpz_cmp (p, want) != 0)
+	{
+	  printf ("nextprime with %d threads\n", threads);
+	  mpz_trace ("  x   ", x);
+	  mpz_trace ("  got ", p);
+	  mpz_trace ("  want", want);
+	  abort ();
+	}
+
+      mpz_prevprime (want, x);
+      mp_set_num_threads (threads);
+      mpz_prevprime (p, x);
+      mp_set_num_threads (1);
+      if (mpz_cmp (p, want) != 0)
+	{
+	  printf ("prevprime with %d threads\n", threads);
+	  mpz_trace ("  x   ", x);
+	  mpz_trace ("  got ", p);
+	  mpz_trace ("  want", want);
+	  abort ();
+	}
+    }
+
+  mpz_clear (x);
+  mpz_clear (p);
+  mpz_clear (want);
+}
+
 int
 main (int argc, char **argv)
 {
@@ -88,6 +186,8 @@ main (int argc, char **argv)
 
   run ("3", 1000 - 1, "0x1ef7", NULL);
 
+  run_prev ();
+
   run ("0x8a43866f5776ccd5b02186e90d28946aeb0ed914", 50,
        "0x8a43866f5776ccd5b02186e90d28946aeb0eeec5", diff3);
 
@@ -119,8 +219,18 @@ main (int argc, char **argv)
       refmpz_nextprime (ref_nxtp, x);
       if (mpz_cmp (nxtp, ref_nxtp) != 0)
 	abort ();
+
+      if (mpz_cmp_ui (x, 2) > 0)
+	{
+	  mpz_prevprime (nxtp, x);
+	  refmpz_prevprime (ref_nxtp, x);
+	  if (mpz_cmp (nxtp, ref_nxtp) != 0)
+	    abort ();
+	}
     }
 
+  run_threads (reps / 2);
+
   mpz_clear (bs);
   mpz_clear (x);
   mpz_clear (nxtp);
@@ -0,0 +1,149 @@
+/* Test mpz_powm_multi.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library test suite.
+
+The GNU MP Library test suite is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 3 of the License,
+or (at your option) any later version.
+
+The GNU MP Library test suite is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+the GNU MP Library test suite.  If not, see https://www.gnu.org/licenses/.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "tests.h"
+
+#ifndef COUNT
+#define COUNT 100
+#endif
+
+/* Every fourth test has many bases with small exponents, which is where
+   the bucket method gets used.  */
+#define MAX_K 12
+#define MAX_MANY_K 1500
+#define MAX_MBITS 3000
+#define MAX_EBITS 1000
+
+int
+main (int argc, char **argv)
+{
+  mpz_t *b, *e;
+  mpz_srcptr *bp, *ep;
+  mpz_t m, got, want, t;
+  size_t k, i;
+  gmp_randstate_ptr rands;
+  int count = COUNT;
+  int test;
+  unsigned long ebits;
+
+  tests_start ();
+  TESTS_REPS (count, argv, argc);
+  rands = RANDS;
+
+  b = (mpz_t *) tests_allocate (MAX_MANY_K * sizeof (mpz_t));
+  e = (mpz_t *) tests_allocate (MAX_MANY_K * sizeof (mpz_t));
+  bp = (mpz_srcptr *) tests_allocate (MAX_MANY_K * sizeof (mpz_srcptr));
+  ep = (mpz_srcptr *) tests_allocate (MAX_MANY_K * sizeof (mpz_srcptr));
+  for (i = 0; i < MAX_MANY_K; i++)
+    {
+      mpz_init (b[i]);
+      mpz_init (e[i]);
+      bp[i] = b[i];
+      ep[i] = e[i];
+    }
+  mpz_init (m);
+  mpz_init (got);
+  mpz_init (want);
+  mpz_init (t);
+
+  for (test = 0; test < count; test++)
+    {
+      if (test % 4 == 3)
+	{
+	  k = gmp_urandomm_ui (rands, MAX_MANY_K + 1);
+	  ebits = 1 + gmp_urandomm_ui (rands, 100);
+	  mpz_rrandomb (m, rands, 1 + gmp_urandomm_ui (rands, 300));
+	}
+      else
+	{
+	  k = gmp_urandomm_ui (rands, MAX_K + 1);
+	  ebits = 1 + gmp_urandomm_ui (rands, MAX_EBITS);
+	  mpz_rrandomb (m, rands, 1 + gmp_urandomm_ui (rands, MAX_MBITS));
+	}
+      /* mostly odd moduli, the even ones take another path */
+      if (test % 16 != 0)
+	mpz_setbit (m, 0);
+      if (test & 1)
+	mpz_neg (m, m);
+
+      for (i = 0; i < k; i++)
+	{
+	  mpz_rrandomb (b[i], rands, gmp_urandomm_ui (rands, 2 * MAX_MBITS));
+	  if (i & 1)
+	    mpz_neg (b[i], b[i]);
+	  mpz_urandomb (e[i], rands, gmp_urandomm_ui (rands, ebits + 1));
+	  /* a few negative exponents, of invertible bases */
+	  if (i % 5 == 4 && mpz_invert (t, b[i], m))
+	    mpz_neg (e[i], e[i]);
+	}
+
+      mpz_set_ui (want, 1);
+      for (i = 0; i < k; i++)
+	{
+	  mpz_powm (t, b[i], e[i], m);
+	  mpz_mul (want, want, t);
+	  mpz_mod (want, want, m);
+	}
+      mpz_mod (want, want, m);
+
+      mpz_powm_multi (got, bp, ep, k, m);
+      MPZ_CHECK_FORMAT (got);
+      if (mpz_cmp (got, want) != 0)
+	{
+	  printf ("ERROR, test %d: k = %lu, ebits = %lu\n",
+		  test, (unsigned long) k, ebits);
+	  mpz_trace ("  m   ", m);
+	  mpz_trace ("  got ", got);
+	  mpz_trace ("  want", want);
+	  abort ();
+	}
+
+      if (k != 0)
+	{
+	  mpz_powm_multi (b[0], bp, ep, k, m);
+	  if (mpz_cmp (b[0], want) != 0)
+	    {
+	      printf ("ERROR, test %d: in place, k = %lu\n",
+		      test, (unsigned long) k);
+	      abort ();
+	    }
+	}
+    }
+
+  for (i = 0; i < MAX_MANY_K; i++)
+    {
+      mpz_clear (b[i]);
+      mpz_clear (e[i]);
+    }
+  tests_free (b, MAX_MANY_K * sizeof (mpz_t));
+  tests_free (e, MAX_MANY_K * sizeof (mpz_t));
+  tests_free (bp, MAX_MANY_K * sizeof (mpz_srcptr));
+  tests_free (ep, MAX_MANY_K * sizeof (mpz_srcptr));
+  mpz_clear (m);
+  mpz_clear (got);
+  mpz_clear (want);
+  mpz_clear (t);
+  tests_end ();
+  return 0;
+}
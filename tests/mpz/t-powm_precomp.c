@@ -0,0 +1,111 @@
+/* Test mpz_powm_precomp.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library test suite.
+
+The GNU MP Library test suite is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 3 of the License,
+or (at your option) any later version.
+
+The GNU MP Library test suite is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+the GNU MP Library test suite.  If not, see https://www.gnu.org/licenses/.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "tests.h"
+
+#ifndef COUNT
+#define COUNT 40
+#endif
+
+/* Enough for moduli past the usual REDC_2_TO_REDC_N_THRESHOLD, to get
+   all kinds of REDC.  */
+#define MAX_MBITS 8000
+#define MAX_EBITS 3000
+
+static void
+dump (const char *msg, mpz_srcptr b, mpz_srcptr e, mpz_srcptr m,
+      mp_bitcnt_t ebits)
+{
+  printf ("ERROR, %s: ebits = %lu\n", msg, (unsigned long) ebits);
+  mpz_trace ("  b", b);
+  mpz_trace ("  e", e);
+  mpz_trace ("  m", m);
+  abort ();
+}
+
+int
+main (int argc, char **argv)
+{
+  mpz_powm_precomp_t P;
+  mpz_t b, e, m, got, want;
+  mp_bitcnt_t ebits;
+  gmp_randstate_ptr rands;
+  int count = COUNT;
+  int test, j;
+
+  tests_start ();
+  TESTS_REPS (count, argv, argc);
+  rands = RANDS;
+
+  mpz_init (b);
+  mpz_init (e);
+  mpz_init (m);
+  mpz_init (got);
+  mpz_init (want);
+
+  for (test = 0; test < count; test++)
+    {
+      mpz_rrandomb (m, rands, 1 + gmp_urandomm_ui (rands, MAX_MBITS));
+      /* mostly odd moduli, the ones the table is for */
+      if (test % 8 != 0)
+	mpz_setbit (m, 0);
+      if (mpz_sgn (m) == 0)
+	mpz_set_ui (m, 1);
+      if (test & 2)
+	mpz_neg (m, m);
+      mpz_rrandomb (b, rands, gmp_urandomm_ui (rands, 2 * mpz_sizeinbase (m, 2)));
+      if (test & 1)
+	mpz_neg (b, b);
+      ebits = gmp_urandomm_ui (rands, MAX_EBITS);
+      mpz_powm_precomp_init (P, b, m, ebits);
+
+      for (j = 0; j < 4; j++)
+	{
+	  /* up to a bit over ebits, the latter go to mpz_powm */
+	  mpz_urandomb (e, rands, gmp_urandomm_ui (rands, ebits + ebits / 8 + 2));
+	  if (j == 3)
+	    mpz_rrandomb (e, rands, ebits);
+
+	  mpz_powm (want, b, e, m);
+	  mpz_powm_precomp (got, e, P);
+	  MPZ_CHECK_FORMAT (got);
+	  if (mpz_cmp (got, want) != 0)
+	    dump ("wrong result", b, e, m, ebits);
+
+	  mpz_powm_precomp (e, e, P);
+	  if (mpz_cmp (e, want) != 0)
+	    dump ("wrong result in place", b, e, m, ebits);
+	}
+
+      mpz_powm_precomp_clear (P);
+    }
+
+  mpz_clear (b);
+  mpz_clear (e);
+  mpz_clear (m);
+  mpz_clear (got);
+  mpz_clear (want);
+  tests_end ();
+  return 0;
+}
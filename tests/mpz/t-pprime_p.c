@@ -172,6 +172,129 @@ check_primes (void)
   mpz_clear (n);
 }
 
+/* Odd composites passing the strong Lucas test with Selfridge's
+   parameters, from OEIS A217255.  Starting from 3 checks that small
+   composites sharing a factor with some D, such as 9, are rejected.  */
+static void
+check_lucas (void)
+{
+  static const unsigned long slpsp[] = {
+    5459, 5777, 10877, 16109, 18971, 22499, 24569, 25199, 40309, 58519,
+    75077, 97439, 100127, 113573, 115639, 130139, 0
+  };
+  mpz_t n;
+  unsigned long i;
+  int got, want, j;
+
+  mpz_init (n);
+
+  for (i = 3, j = 0; i < 130200; i += 2)
+    {
+      mpz_set_ui (n, i);
+      got = mpz_stronglucas (n);
+      want = mpz_probab_prime_p (n, 25) != 0;	/* exact below 10^6 */
+      if (slpsp[j] == i)
+	{
+	  want = 1;
+	  j++;
+	}
+      if (got != want)
+	{
+	  printf ("mpz_stronglucas\n");
+	  printf ("  n    =%lu\n", i);
+	  printf ("  got =%d", got);
+	  printf ("  want=%d", want);
+	  abort ();
+	}
+    }
+
+  mpz_clear (n);
+}
+
+/* Strong pseudoprimes to several bases, which must not pass.  */
+static void
+check_pseudoprimes (void)
+{
+  static const char * const spsp[] = {
+    /* bases 2 to 23 */
+    "3825123056546413051",
+    /* bases 2 to 37 */
+    "318665857834031151167461",
+    "3317044064679887385961981",
+    /* base 2, above 2^64, 17179871389 * 34359742777 */
+    "590295961867981707253",
+    NULL
+  };
+  mpz_t n;
+  int i;
+
+  mpz_init (n);
+
+  for (i = 0; spsp[i]; i++)
+    {
+      mpz_set_str_or_abort (n, spsp[i], 0);
+      check_pn (n, 0);
+    }
+
+  /* below 2^64, BPSW is certain */
+  mpz_set_str_or_abort (n, "18446744073709551557", 0);
+  check_pn (n, 2);
+
+  mpz_clear (n);
+}
+
+/* mpz_probab_prime_batch against mpz_probab_prime_p, some of the numbers
+   prime, on one thread and on several.  */
+#define BATCH_MAX  50
+static void
+check_batch (int count)
+{
+  mpz_t n[BATCH_MAX];
+  mpz_srcptr np[BATCH_MAX];
+  int got[BATCH_MAX];
+  gmp_randstate_ptr rands = RANDS;
+  int i, k, test, want;
+
+  for (i = 0; i < BATCH_MAX; i++)
+    {
+      mpz_init (n[i]);
+      np[i] = n[i];
+    }
+
+  for (test = 0; test < count / 20; test++)
+    {
+      k = gmp_urandomm_ui (rands, BATCH_MAX + 1);
+      for (i = 0; i < k; i++)
+	{
+	  mpz_urandomb (n[i], rands, gmp_urandomm_ui (rands, 400));
+	  if (gmp_urandomb_ui (rands, 1))
+	    mpz_nextprime (n[i], n[i]);
+	  if (gmp_urandomm_ui (rands, 8) == 0)
+	    mpz_neg (n[i], n[i]);
+	}
+
+      if (test & 1)
+	mp_set_num_threads (2 + test % 3);
+      mpz_probab_prime_batch (got, np, k, 25 + test % 3);
+      mp_set_num_threads (1);
+
+      for (i = 0; i < k; i++)
+	{
+	  want = mpz_probab_prime_p (n[i], 25 + test % 3);
+	  if (got[i] != want)
+	    {
+	      printf ("mpz_probab_prime_batch, element %d of %d\n", i, k);
+	      printf ("  got %d want %d\n", got[i], want);
+	      mpz_trace ("  n", n[i]);
+	      abort ();
+	    }
+	}
+    }
+
+  for (i = 0; i < BATCH_MAX; i++)
+    mpz_clear (n[i]);
+}
+
 int
 main (int argc, char **argv)
 {
@@ -184,6 +307,9 @@ main (int argc, char **argv)
   check_small ();
   check_composites (count);
   check_primes ();
+  check_lucas ();
+  check_pseudoprimes ();
+  check_batch (count);
 
   tests_end ();
   exit (0);
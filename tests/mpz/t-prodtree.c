@@ -0,0 +1,178 @@
+/* Test mpz_product_tree, mpz_remainder_tree and mpz_multi_mod.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library test suite.
+
+The GNU MP Library test suite is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 3 of the License,
+or (at your option) any later version.
+
+The GNU MP Library test suite is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+the GNU MP Library test suite.  If not, see https://www.gnu.org/licenses/.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "tests.h"
+
+#ifndef COUNT
+#define COUNT 100
+#endif
+
+#define MAX_K 300
+#define MAX_MBITS 800
+
+static void
+check_one (const char *name, int test, size_t i, mpz_srcptr x, mpz_srcptr m,
+	   mpz_srcptr got, mpz_srcptr want)
+{
+  MPZ_CHECK_FORMAT (got);
+  if (mpz_cmp (got, want) != 0)
+    {
+      printf ("ERROR, test %d: %s, element %lu\n",
+	      test, name, (unsigned long) i);
+      mpz_trace ("  x   ", x);
+      mpz_trace ("  m   ", m);
+      mpz_trace ("  got ", got);
+      mpz_trace ("  want", want);
+      abort ();
+    }
+}
+
+int
+main (int argc, char **argv)
+{
+  mpz_t *m, *r;
+  mpz_ptr *rp;
+  mpz_srcptr *mp;
+  mpz_product_tree_t t;
+  mpz_t x, want, xs;
+  size_t k, i;
+  unsigned long mbits;
+  gmp_randstate_ptr rands;
+  int count = COUNT;
+  int test;
+
+  tests_start ();
+  TESTS_REPS (count, argv, argc);
+  rands = RANDS;
+
+  m = (mpz_t *) tests_allocate (MAX_K * sizeof (mpz_t));
+  r = (mpz_t *) tests_allocate (MAX_K * sizeof (mpz_t));
+  mp = (mpz_srcptr *) tests_allocate (MAX_K * sizeof (mpz_srcptr));
+  rp = (mpz_ptr *) tests_allocate (MAX_K * sizeof (mpz_ptr));
+  for (i = 0; i < MAX_K; i++)
+    {
+      mpz_init (m[i]);
+      mpz_init (r[i]);
+      mp[i] = m[i];
+      rp[i] = r[i];
+    }
+  mpz_init (x);
+  mpz_init (want);
+  mpz_init (xs);
+
+  for (test = 0; test < count; test++)
+    {
+      k = gmp_urandomm_ui (rands, MAX_K + 1);
+      /* now and then all single limbs */
+      mbits = test % 4 == 0 ? GMP_NUMB_BITS : MAX_MBITS;
+      for (i = 0; i < k; i++)
+	{
+	  do
+	    mpz_rrandomb (m[i], rands, 1 + gmp_urandomm_ui (rands, mbits));
+	  while (mpz_sgn (m[i]) == 0);
+	  if (gmp_urandomb_ui (rands, 2) == 0)
+	    mpz_neg (m[i], m[i]);
+	}
+
+      if (test % 5 == 4)
+	mp_set_num_threads (2 + test % 4);
+
+      /* the product, against a plain loop */
+      mpz_set_ui (want, 1);
+      for (i = 0; i < k; i++)
+	mpz_mul (want, want, m[i]);
+      mpz_product_tree (x, mp, k);
+      check_one ("product", test, 0, x, x, x, want);
+      if (k != 0)
+	{
+	  mpz_set (xs, m[k - 1]);
+	  mpz_product_tree (m[k - 1], mp, k);
+	  check_one ("product in place", test, 0, x, x, m[k - 1], want);
+	  mpz_set (m[k - 1], xs);
+	}
+
+      /* x sometimes much smaller than the product, sometimes bigger */
+      mpz_urandomb (x, rands, gmp_urandomm_ui (rands, 2 * k * MAX_MBITS + 100));
+      if (test % 7 == 3)
+	mpz_rrandomb (x, rands, gmp_urandomm_ui (rands, 3 * k * mbits + 100));
+      if (test % 11 == 5 && k != 0)
+	mpz_mul (x, x, m[gmp_urandomm_ui (rands, k)]);
+      if (test & 1)
+	mpz_neg (x, x);
+
+      mpz_product_tree_init (t, mp, k);
+      mpz_remainder_tree (rp, x, t);
+      for (i = 0; i < k; i++)
+	{
+	  mpz_mod (want, x, m[i]);
+	  check_one ("remainder_tree", test, i, x, m[i], r[i], want);
+	}
+
+      /* results in place of x */
+      if (k != 0)
+	{
+	  i = gmp_urandomm_ui (rands, k);
+	  mpz_set (r[i], x);
+	  mpz_remainder_tree (rp, r[i], t);
+	  mpz_mod (want, x, m[i]);
+	  check_one ("remainder_tree r=x", test, i, x, m[i], r[i], want);
+	}
+      mpz_product_tree_clear (t);
+
+      mpz_multi_mod (rp, x, mp, k);
+      for (i = 0; i < k; i++)
+	{
+	  mpz_mod (want, x, m[i]);
+	  check_one ("multi_mod", test, i, x, m[i], r[i], want);
+	}
+      if (k != 0)
+	{
+	  i = gmp_urandomm_ui (rands, k);
+	  mpz_set (r[i], x);
+	  mpz_multi_mod (rp, r[i], mp, k);
+	  for (i = 0; i < k; i++)
+	    {
+	      mpz_mod (want, x, m[i]);
+	      check_one ("multi_mod r=x", test, i, x, m[i], r[i], want);
+	    }
+	}
+
+      mp_set_num_threads (1);
+    }
+
+  for (i = 0; i < MAX_K; i++)
+    {
+      mpz_clear (m[i]);
+      mpz_clear (r[i]);
+    }
+  tests_free (m, MAX_K * sizeof (mpz_t));
+  tests_free (r, MAX_K * sizeof (mpz_t));
+  tests_free (mp, MAX_K * sizeof (mpz_srcptr));
+  tests_free (rp, MAX_K * sizeof (mpz_ptr));
+  mpz_clear (x);
+  mpz_clear (want);
+  mpz_clear (xs);
+  tests_end ();
+  return 0;
+}
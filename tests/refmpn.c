@@ -2342,6 +2342,74 @@ refmpn_redc_1 (mp_ptr rp, mp_ptr up, mp_srcptr mp, mp_size_t n, mp_limb_t invm)
   return cy;
 }
 
+/* Lane l of 8 interleaved d digit operands of 52 bits, to and from limbs.  */
+static void
+refmpn_from_52x8 (mp_ptr rp, mp_size_t rn, mp_srcptr xp, int l, mp_size_t d)
+{
+  unsigned long i;
+
+  refmpn_zero (rp, rn);
+  for (i = 0; i < 52 * (unsigned long) d; i++)
+    if ((xp[8 * (i / 52) + l] >> (i % 52)) & 1)
+      refmpn_setbit (rp, i);
+}
+
+static void
+refmpn_to_52x8 (mp_ptr xp, int l, mp_srcptr up, mp_size_t d)
+{
+  unsigned long i;
+
+  for (i = 0; i < 52 * (unsigned long) d; i++)
+    {
+      if (i % 52 == 0)
+	xp[8 * (i / 52) + l] = 0;
+      if (refmpn_tstbit (up, i))
+	xp[8 * (i / 52) + l] |= CNST_LIMB(1) << (i % 52);
+    }
+}
+
+/* In each lane, (a b + q m) / 2^(52d) for the q < 2^(52d) which makes it
+   exact, found a bit at a time.  */
+void
+refmpn_amm52_8 (mp_ptr rp, mp_srcptr ap, mp_srcptr bp, mp_srcptr mp,
+		mp_srcptr kp, mp_size_t d)
+{
+  mp_ptr a, b, m, t;
+  mp_size_t n;
+  unsigned long i;
+  int l;
+
+  ASSERT (GMP_NUMB_BITS == 64);
+  n = (52 * d) / GMP_NUMB_BITS + 1;
+  a = refmpn_malloc_limbs (n);
+  b = refmpn_malloc_limbs (n);
+  m = refmpn_malloc_limbs (n);
+  t = refmpn_malloc_limbs (2 * n + 1);
+
+  for (l = 0; l < 8; l++)
+    {
+      refmpn_from_52x8 (a, n, ap, l, d);
+      refmpn_from_52x8 (b, n, bp, l, d);
+      refmpn_from_52x8 (m, n, mp, l, d);
+      ASSERT ((((kp[l] * m[0]) + 1) & ((CNST_LIMB(1) << 52) - 1)) == 0);
+
+      refmpn_mul (t, a, n, b, n);
+      t[2 * n] = 0;
+      for (i = 0; i < 52 * (unsigned long) d; i++)
+	{
+	  if (t[0] & 1)
+	    t[2 * n] += refmpn_add (t, t, 2 * n, m, n);
+	  refmpn_rshift (t, t, 2 * n + 1, 1);
+	}
+      refmpn_to_52x8 (rp, l, t, d);
+    }
+
+  free (a);
+  free (b);
+  free (m);
+  free (t);
+}
+
 size_t
 refmpn_get_str (unsigned char *dst, int base, mp_ptr src, mp_size_t size)
 {
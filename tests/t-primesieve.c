@@ -0,0 +1,233 @@
+/* Test gmp_primesieve and the gmp_primeiter_t functions.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library test suite.
+
+The GNU MP Library test suite is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 3 of the License,
+or (at your option) any later version.
+
+The GNU MP Library test suite is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+the GNU MP Library test suite.  If not, see https://www.gnu.org/licenses/.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "tests.h"
+
+#ifndef COUNT
+#define COUNT 50
+#endif
+
+/* Past 2*2048 limbs gmp_primesieve goes block by block.  */
+#define MAX_N 3000000
+
+static char *composite;
+
+static void
+ref_sieve (void)
+{
+  unsigned long i, j;
+
+  composite = (char *) tests_allocate (MAX_N + 1);
+  memset (composite, 0, MAX_N + 1);
+  composite[0] = composite[1] = 1;
+  for (i = 2; i * i <= MAX_N; i++)
+    if (! composite[i])
+      for (j = i * i; j <= MAX_N; j += i)
+	composite[j] = 1;
+}
+
+/* The bit for the largest number coprime to 6 up to n, at least 5.  */
+#define N_TO_BIT(n)  ((((n) - 5) | 1) / 3)
+
+static void
+check_sieve (unsigned long n)
+{
+  mp_ptr sieve;
+  mp_size_t size;
+  mp_limb_t count, want, bit;
+  unsigned long m;
+
+  size = N_TO_BIT (n) / GMP_LIMB_BITS + 1;
+  sieve = refmpn_malloc_limbs (size);
+  count = gmp_primesieve (sieve, n);
+
+  want = 0;
+  for (m = 5; m <= n; m += 2)
+    {
+      if (m % 3 == 0)
+	continue;
+      bit = N_TO_BIT (m);
+      if (((sieve[bit / GMP_LIMB_BITS] >> (bit % GMP_LIMB_BITS)) & 1)
+	  != composite[m])
+	{
+	  printf ("gmp_primesieve (%lu), wrong for %lu\n", n, m);
+	  abort ();
+	}
+      want += ! composite[m];
+    }
+  if (count != want)
+    {
+      printf ("gmp_primesieve (%lu), count %lu want %lu\n",
+	      n, (unsigned long) count, (unsigned long) want);
+      abort ();
+    }
+  free (sieve);
+}
+
+static void
+check_iter (unsigned long lo, unsigned long hi)
+{
+  gmp_primeiter_t it;
+  unsigned long m, p;
+
+  gmp_primeiter_init (it, lo, hi);
+  for (m = lo; m <= hi; m++)
+    {
+      if (composite[m])
+	continue;
+      p = gmp_primeiter_next (it);
+      if (p != m)
+	{
+	  printf ("gmp_primeiter [%lu,%lu], got %lu want %lu\n",
+		  lo, hi, p, m);
+	  abort ();
+	}
+    }
+  p = gmp_primeiter_next (it);
+  if (p != 0 || gmp_primeiter_next (it) != 0)
+    {
+      printf ("gmp_primeiter [%lu,%lu], got %lu past the end\n", lo, hi, p);
+      abort ();
+    }
+  gmp_primeiter_clear (it);
+}
+
+/* Skips back and forth within [0,MAX_N], each followed by a few primes.  */
+static void
+check_skip (gmp_randstate_ptr rands)
+{
+  gmp_primeiter_t it;
+  unsigned long m, p, hi;
+  int i, j;
+
+  hi = gmp_urandomm_ui (rands, MAX_N + 1);
+  gmp_primeiter_init (it, gmp_urandomm_ui (rands, hi + 1), hi);
+  for (i = 0; i < 20; i++)
+    {
+      m = gmp_urandomm_ui (rands, MAX_N + 1);
+      if (i % 5 == 0)
+	m = gmp_urandomm_ui (rands, 50);
+      gmp_primeiter_skip (it, m);
+      for (j = 0; j < 50; j++, m++)
+	{
+	  while (m <= hi && composite[m])
+	    m++;
+	  p = gmp_primeiter_next (it);
+	  if (p != (m <= hi ? m : 0))
+	    {
+	      printf ("gmp_primeiter_skip, hi %lu, got %lu want %lu\n",
+		      hi, p, m <= hi ? m : 0);
+	      abort ();
+	    }
+	}
+    }
+  gmp_primeiter_clear (it);
+}
+
+/* Primes near the top of an unsigned long, against mpz_probab_prime_p.
+   For a 64-bit long that's brought down to about 2^50, where the windows
+   of sieving primes are few, to keep the time small.  */
+static void
+check_top (void)
+{
+  gmp_primeiter_t it;
+  unsigned long lo, hi, m, p;
+  mpz_t n;
+
+  hi = GMP_NUMB_MAX < ULONG_MAX ? GMP_NUMB_MAX : ULONG_MAX;
+  while (hi / 1000000 > 1000000000)
+    hi >>= 1;
+  lo = hi - 20000;
+  mpz_init (n);
+  gmp_primeiter_init (it, lo, hi);
+  for (m = lo; ; m++)
+    {
+      mpz_set_ui (n, m);
+      if (mpz_probab_prime_p (n, 25))
+	{
+	  p = gmp_primeiter_next (it);
+	  if (p != m)
+	    {
+	      printf ("gmp_primeiter near %lu, got %lu want %lu\n", hi, p, m);
+	      abort ();
+	    }
+	}
+      if (m == hi)
+	break;
+    }
+  if (gmp_primeiter_next (it) != 0)
+    {
+      printf ("gmp_primeiter near %lu, prime past the end\n", hi);
+      abort ();
+    }
+  gmp_primeiter_clear (it);
+  mpz_clear (n);
+}
+
+int
+main (int argc, char **argv)
+{
+  gmp_randstate_ptr rands;
+  unsigned long n, lo;
+  int count = COUNT;
+  int test;
+
+  tests_start ();
+  TESTS_REPS (count, argv, argc);
+  rands = RANDS;
+  ref_sieve ();
+
+  for (n = 5; n < 1000; n++)
+    check_sieve (n);
+  check_sieve (MAX_N);
+
+  for (n = 0; n < 200; n++)
+    for (lo = 0; lo <= n; lo++)
+      check_iter (lo, n);
+  check_iter (0, MAX_N);
+  check_top ();
+
+  for (test = 0; test < count; test++)
+    {
+      if (test & 1)
+	mp_set_num_threads (2 + test % 4);
+
+      n = 5 + gmp_urandomm_ui (rands, MAX_N - 4);
+      check_sieve (n);
+
+      n = gmp_urandomm_ui (rands, MAX_N + 1);
+      lo = gmp_urandomm_ui (rands, n + 1);
+      if (test % 3 == 0)
+	lo = n - MIN (n, gmp_urandomm_ui (rands, 1000));
+      check_iter (lo, n);
+      check_skip (rands);
+
+      mp_set_num_threads (1);
+    }
+
+  tests_free (composite, MAX_N + 1);
+  tests_end ();
+  exit (0);
+}
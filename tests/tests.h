@@ -196,6 +196,8 @@ mp_limb_t refmpn_addmul_8 (mp_ptr, mp_srcptr, mp_size_t, mp_srcptr);
 mp_limb_t refmpn_add_n_sub_n (mp_ptr, mp_ptr, mp_srcptr, mp_srcptr, mp_size_t);
 mp_limb_t refmpn_add_n_sub_nc (mp_ptr, mp_ptr, mp_srcptr, mp_srcptr, mp_size_t, mp_limb_t);
 
+void refmpn_amm52_8 (mp_ptr, mp_srcptr, mp_srcptr, mp_srcptr, mp_srcptr, mp_size_t);
+
 void refmpn_and_n (mp_ptr, mp_srcptr, mp_srcptr, mp_size_t);
 void refmpn_andn_n (mp_ptr, mp_srcptr, mp_srcptr, mp_size_t);
 
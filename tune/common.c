@@ -1422,6 +1422,19 @@ speed_mpn_nussbaumer_mul_sqr (struct speed_params *s)
     (mpn_nussbaumer_mul (wp, s->xp, s->size, s->xp, s->size));
 }
 
+double
+speed_mpn_mul_ntt (struct speed_params *s)
+{
+  SPEED_ROUTINE_MPN_MUL_N_CALL
+    (mpn_mul_ntt (wp, s->xp, s->size, s->yp, s->size));
+}
+double
+speed_mpn_mul_ntt_sqr (struct speed_params *s)
+{
+  SPEED_ROUTINE_MPN_SQR_CALL
+    (mpn_mul_ntt (wp, s->xp, s->size, s->xp, s->size));
+}
+
 #if WANT_OLD_FFT_FULL
 double
 speed_mpn_mul_fft_full (struct speed_params *s)
@@ -1492,6 +1505,65 @@ speed_mpn_mul_fft_sqr (struct speed_params *s)
     (mpn_mul_fft (wp, pl, s->xp, s->size, s->xp, s->size, k), 1);
 }
 
+/* mpn_mul_fft with its transforms done one layer per pass, to compare
+   against the default two, which matters for large sizes.  */
+double
+speed_mpn_mul_fft_radix2 (struct speed_params *s)
+{
+  SPEED_ROUTINE_MPN_MUL_FFT_CALL
+    (mpn_mul_fft_radix2 (wp, pl, s->xp, s->size, s->yp, s->size, k), 0);
+}
+
+/* mpn_mul_fft as above with the best k, but run with s->r threads (default
+   1), to see how it scales.  */
+double
+speed_mpn_mul_fft_threads (struct speed_params *s)
+{
+  struct speed_params  p = *s;
+  double  t;
+
+  p.r = 0;
+  mp_set_num_threads (s->r != 0 ? s->r : 1);
+  t = speed_mpn_mul_fft (&p);
+  mp_set_num_threads (1);
+  return t;
+}
+
+/* mpn_mul of a 4*size by size product, run with s->r threads (default 1),
+   which is what PARALLEL_MUL_THRESHOLD is tuned on.  */
+double
+speed_mpn_mul_threads (struct speed_params *s)
+{
+  mp_ptr    wp, xp;
+  unsigned  i;
+  double    t;
+  TMP_DECL;
+
+  SPEED_RESTRICT_COND (s->size >= 1);
+
+  TMP_MARK;
+  SPEED_TMP_ALLOC_LIMBS (xp, 4 * s->size, s->align_xp);
+  SPEED_TMP_ALLOC_LIMBS (wp, 5 * s->size, s->align_wp);
+  mpn_random (xp, 4 * s->size);
+
+  speed_operand_src (s, xp, 4 * s->size);
+  speed_operand_src (s, s->yp, s->size);
+  speed_operand_dst (s, wp, 5 * s->size);
+  speed_cache_fill (s);
+
+  mp_set_num_threads (s->r != 0 ? s->r : 1);
+  speed_starttime ();
+  i = s->reps;
+  do
+    mpn_mul (wp, xp, 4 * s->size, s->yp, s->size);
+  while (--i != 0);
+  t = speed_endtime ();
+  mp_set_num_threads (1);
+
+  TMP_FREE;
+  return t;
+}
+
 double
 speed_mpn_fft_mul (struct speed_params *s)
 {
@@ -1626,6 +1698,27 @@ speed_mpn_matrix22_mul (struct speed_params *s)
   return t;
 }
 
+double
+speed_mpn_hgcd2 (struct speed_params *s)
+{
+  SPEED_ROUTINE_MPN_HGCD2 (mpn_hgcd2);
+}
+double
+speed_mpn_hgcd2_1 (struct speed_params *s)
+{
+  SPEED_ROUTINE_MPN_HGCD2 (mpn_hgcd2_1);
+}
+double
+speed_mpn_hgcd2_2 (struct speed_params *s)
+{
+  SPEED_ROUTINE_MPN_HGCD2 (mpn_hgcd2_2);
+}
+double
+speed_mpn_hgcd2_3 (struct speed_params *s)
+{
+  SPEED_ROUTINE_MPN_HGCD2 (mpn_hgcd2_3);
+}
+
 double
 speed_mpn_hgcd (struct speed_params *s)
 {
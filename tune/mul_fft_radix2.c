@@ -0,0 +1,46 @@
+/* mpn/generic/mul_fft.c with transforms done one layer at a time.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "gmp.h"
+#include "gmp-impl.h"
+
+#define FFT_RADIX4  0
+
+#define __gmpn_mul_fft        mpn_mul_fft_radix2
+#define __gmpn_mul_fft_full   mpn_mul_fft_full_radix2
+#define __gmpn_fft_best_k     mpn_fft_best_k_radix2
+#define __gmpn_fft_next_size  mpn_fft_next_size_radix2
+#define __gmpn_mul_fft_precomp_init   mpn_mul_fft_precomp_init_radix2
+#define __gmpn_mul_fft_precomp        mpn_mul_fft_precomp_radix2
+#define __gmpn_mul_fft_precomp_clear  mpn_mul_fft_precomp_clear_radix2
+#define mpn_fft_table3        mpn_fft_table3_radix2
+#define mpn_fft_table         mpn_fft_table_radix2
+
+#include "mpn/generic/mul_fft.c"
@@ -286,6 +286,10 @@ const struct routine_t {
 
   { "mpn_matrix22_mul",  speed_mpn_matrix22_mul     },
 
+  { "mpn_hgcd2",         speed_mpn_hgcd2            },
+  { "mpn_hgcd2_1",       speed_mpn_hgcd2_1          },
+  { "mpn_hgcd2_2",       speed_mpn_hgcd2_2          },
+  { "mpn_hgcd2_3",       speed_mpn_hgcd2_3          },
   { "mpn_hgcd",          speed_mpn_hgcd             },
   { "mpn_hgcd_lehmer",   speed_mpn_hgcd_lehmer      },
   { "mpn_hgcd_appr",     speed_mpn_hgcd_appr        },
@@ -344,12 +348,17 @@ const struct routine_t {
   { "mpn_toom63_mul",    speed_mpn_toom63_mul       },
   { "mpn_nussbaumer_mul",    speed_mpn_nussbaumer_mul    },
   { "mpn_nussbaumer_mul_sqr",speed_mpn_nussbaumer_mul_sqr},
+  { "mpn_mul_ntt",       speed_mpn_mul_ntt          },
+  { "mpn_mul_ntt_sqr",   speed_mpn_mul_ntt_sqr      },
 #if WANT_OLD_FFT_FULL
   { "mpn_mul_fft_full",      speed_mpn_mul_fft_full      },
   { "mpn_mul_fft_full_sqr",  speed_mpn_mul_fft_full_sqr  },
 #endif
   { "mpn_mul_fft",       speed_mpn_mul_fft,     FLAG_R_OPTIONAL },
   { "mpn_mul_fft_sqr",   speed_mpn_mul_fft_sqr, FLAG_R_OPTIONAL },
+  { "mpn_mul_fft_threads", speed_mpn_mul_fft_threads, FLAG_R_OPTIONAL },
+  { "mpn_mul_threads",     speed_mpn_mul_threads,     FLAG_R_OPTIONAL },
+  { "mpn_mul_fft_radix2", speed_mpn_mul_fft_radix2, FLAG_R_OPTIONAL },
 
   { "mpn_sqrlo",          speed_mpn_sqrlo           },
   { "mpn_sqrlo_basecase", speed_mpn_sqrlo_basecase  },
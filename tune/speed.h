@@ -214,6 +214,10 @@ double speed_mpn_div_qr_2n (struct speed_params *);
 double speed_mpn_div_qr_2u (struct speed_params *);
 double speed_mpn_fib2_ui (struct speed_params *);
 double speed_mpn_matrix22_mul (struct speed_params *);
+double speed_mpn_hgcd2 (struct speed_params *);
+double speed_mpn_hgcd2_1 (struct speed_params *);
+double speed_mpn_hgcd2_2 (struct speed_params *);
+double speed_mpn_hgcd2_3 (struct speed_params *);
 double speed_mpn_hgcd (struct speed_params *);
 double speed_mpn_hgcd_lehmer (struct speed_params *);
 double speed_mpn_hgcd_appr (struct speed_params *);
@@ -266,6 +270,9 @@ double speed_mpn_mulmid (struct speed_params *);
 double speed_mpn_mulmid_basecase (struct speed_params *);
 double speed_mpn_mul_fft (struct speed_params *);
 double speed_mpn_mul_fft_sqr (struct speed_params *);
+double speed_mpn_mul_fft_threads (struct speed_params *);
+double speed_mpn_mul_threads (struct speed_params *);
+double speed_mpn_mul_fft_radix2 (struct speed_params *);
 double speed_mpn_fft_mul (struct speed_params *);
 double speed_mpn_fft_sqr (struct speed_params *);
 #if WANT_OLD_FFT_FULL
@@ -274,6 +281,8 @@ double speed_mpn_mul_fft_full_sqr (struct speed_params *);
 #endif
 double speed_mpn_nussbaumer_mul (struct speed_params *);
 double speed_mpn_nussbaumer_mul_sqr (struct speed_params *);
+double speed_mpn_mul_ntt (struct speed_params *);
+double speed_mpn_mul_ntt_sqr (struct speed_params *);
 double speed_mpn_mul_n (struct speed_params *);
 double speed_mpn_mul_n_sqr (struct speed_params *);
 double speed_mpn_mulmid_n (struct speed_params *);
@@ -475,6 +484,7 @@ int mpn_jacobi_base_3 (mp_limb_t, mp_limb_t, int);
 int mpn_jacobi_base_4 (mp_limb_t, mp_limb_t, int);
 
 mp_limb_t mpn_mod_1_div (mp_srcptr, mp_size_t, mp_limb_t);
+mp_limb_t mpn_mul_fft_radix2 (mp_ptr, mp_size_t, mp_srcptr, mp_size_t, mp_srcptr, mp_size_t, int);
 mp_limb_t mpn_mod_1_inv (mp_srcptr, mp_size_t, mp_limb_t);
 
 mp_limb_t mpn_mod_1_1p_1 (mp_srcptr, mp_size_t, mp_limb_t, const mp_limb_t [4]);
@@ -487,6 +497,9 @@ mp_size_t mpn_gcdext_one_double (mp_ptr, mp_ptr, mp_size_t *, mp_ptr, mp_size_t,
 mp_size_t mpn_gcdext_one_single (mp_ptr, mp_ptr, mp_size_t *, mp_ptr, mp_size_t, mp_ptr, mp_size_t);
 mp_size_t mpn_gcdext_single (mp_ptr, mp_ptr, mp_size_t *, mp_ptr, mp_size_t, mp_ptr, mp_size_t);
 mp_size_t mpn_gcdext_double (mp_ptr, mp_ptr, mp_size_t *, mp_ptr, mp_size_t, mp_ptr, mp_size_t);
+int mpn_hgcd2_1 (mp_limb_t, mp_limb_t, mp_limb_t, mp_limb_t, struct hgcd_matrix1 *);
+int mpn_hgcd2_2 (mp_limb_t, mp_limb_t, mp_limb_t, mp_limb_t, struct hgcd_matrix1 *);
+int mpn_hgcd2_3 (mp_limb_t, mp_limb_t, mp_limb_t, mp_limb_t, struct hgcd_matrix1 *);
 mp_size_t mpn_hgcd_lehmer (mp_ptr, mp_ptr, mp_size_t, struct hgcd_matrix *, mp_ptr);
 mp_size_t mpn_hgcd_lehmer_itch (mp_size_t);
 
@@ -2788,6 +2801,45 @@ int speed_routine_count_zeros_setup (struct speed_params *, mp_ptr, int, int);
      function (px[j-1], py[j-1], 0))
 
 
+/* Double limb pairs as mpn_gcd gives them to mpn_hgcd2, with the high bit
+   of one of the high limbs set.  */
+#define SPEED_ROUTINE_MPN_HGCD2(function)				\
+  {									\
+    unsigned  i;							\
+    mp_size_t j;							\
+    mp_ptr    px, py;							\
+    struct hgcd_matrix1 m;						\
+    double    t;							\
+    TMP_DECL;								\
+									\
+    TMP_MARK;								\
+    SPEED_TMP_ALLOC_LIMBS (px, SPEED_BLOCK_SIZE, s->align_xp);		\
+    SPEED_TMP_ALLOC_LIMBS (py, SPEED_BLOCK_SIZE, s->align_yp);		\
+    MPN_COPY (px, s->xp_block, SPEED_BLOCK_SIZE);			\
+    MPN_COPY (py, s->yp_block, SPEED_BLOCK_SIZE);			\
+    for (j = 1; j < SPEED_BLOCK_SIZE; j += 2)				\
+      px[j] |= GMP_NUMB_HIGHBIT;					\
+									\
+    speed_operand_src (s, px, SPEED_BLOCK_SIZE);			\
+    speed_operand_src (s, py, SPEED_BLOCK_SIZE);			\
+    speed_cache_fill (s);						\
+									\
+    speed_starttime ();							\
+    i = s->reps;							\
+    do									\
+      {									\
+	for (j = 0; j < SPEED_BLOCK_SIZE; j += 2)			\
+	  function (px[j+1], px[j], py[j+1], py[j], &m);		\
+      }									\
+    while (--i != 0);							\
+    t = speed_endtime ();						\
+									\
+    TMP_FREE;								\
+									\
+    s->time_divisor = SPEED_BLOCK_SIZE / 2;				\
+    return t;								\
+  }
+
 #define SPEED_ROUTINE_MPN_HGCD_CALL(func, itchfunc)			\
   {									\
     mp_size_t hgcd_init_itch, hgcd_itch;				\
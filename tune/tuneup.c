@@ -169,6 +169,8 @@ mp_size_t  mul_toom42_to_toom63_threshold = MP_SIZE_T_MAX;
 mp_size_t  mul_toom43_to_toom54_threshold = MP_SIZE_T_MAX;
 mp_size_t  mul_fft_threshold            = MP_SIZE_T_MAX;
 mp_size_t  mul_fft_modf_threshold       = MP_SIZE_T_MAX;
+mp_size_t  mul_ntt_threshold            = MP_SIZE_T_MAX;
+mp_size_t  parallel_mul_threshold       = MP_SIZE_T_MAX;
 mp_size_t  sqr_basecase_threshold       = MP_SIZE_T_MAX;
 mp_size_t  sqr_toom2_threshold
   = (TUNE_SQR_TOOM2_MAX == 0 ? MP_SIZE_T_MAX : TUNE_SQR_TOOM2_MAX);
@@ -178,6 +180,7 @@ mp_size_t  sqr_toom6_threshold          = SQR_TOOM6_THRESHOLD_LIMIT;
 mp_size_t  sqr_toom8_threshold          = SQR_TOOM8_THRESHOLD_LIMIT;
 mp_size_t  sqr_fft_threshold            = MP_SIZE_T_MAX;
 mp_size_t  sqr_fft_modf_threshold       = MP_SIZE_T_MAX;
+mp_size_t  sqr_ntt_threshold            = MP_SIZE_T_MAX;
 mp_size_t  mullo_basecase_threshold     = MP_SIZE_T_MAX;
 mp_size_t  mullo_dc_threshold           = MP_SIZE_T_MAX;
 mp_size_t  mullo_mul_n_threshold        = MP_SIZE_T_MAX;
@@ -792,7 +795,7 @@ fftfill (mp_size_t pl, int k, int sqr)
   N = pl * GMP_NUMB_BITS;
   M = N >> k;
 
-  maxLK = mpn_mul_fft_lcm ((unsigned long) GMP_NUMB_BITS, k);
+  maxLK = mpn_mul_fft_lcm ((unsigned long) GMP_NUMB_BITS, k - 1);
 
   Nprime = (1 + (2 * M + k + 2) / maxLK) * maxLK;
   nprime = Nprime / GMP_NUMB_BITS;
@@ -2567,6 +2570,44 @@ tune_modexact_1_odd (void)
 }
 
 
+void
+tune_hgcd2 (void)
+{
+  static struct param_t  param;
+  double   t1, t2, t3;
+  int      method;
+
+  s.size = 1;
+
+  t1 = tuneup_measure (speed_mpn_hgcd2_1, &param, &s);
+  if (option_trace >= 1)
+    printf ("mpn_hgcd2_1 %.9f\n", t1);
+
+  t2 = tuneup_measure (speed_mpn_hgcd2_2, &param, &s);
+  if (option_trace >= 1)
+    printf ("mpn_hgcd2_2 %.9f\n", t2);
+
+  t3 = tuneup_measure (speed_mpn_hgcd2_3, &param, &s);
+  if (option_trace >= 1)
+    printf ("mpn_hgcd2_3 %.9f\n", t3);
+
+  if (t1 == -1.0 || t2 == -1.0 || t3 == -1.0)
+    {
+      printf ("Oops, can't measure all mpn_hgcd2 methods\n");
+      abort ();
+    }
+
+  if (t1 < t2 && t1 < t3)
+    method = 1;
+  else if (t2 < t3)
+    method = 2;
+  else
+    method = 3;
+
+  print_define ("HGCD2_DIV1_METHOD", method);
+}
+
+
 void
 tune_jacobi_base (void)
 {
@@ -2766,6 +2807,69 @@ tune_fft_sqr (void)
   fft (&param);
 }
 
+/* The NTT is only considered above the FFT threshold, and only if it's
+   faster at the largest size we're tuning, since where it wins it keeps
+   winning.  */
+void
+tune_ntt_mul (void)
+{
+  static struct param_t  param;
+
+  if (option_fft_max_size == 0 || GMP_NUMB_BITS != 64)
+    return;
+
+  param.name = "MUL_NTT_THRESHOLD";
+  param.function = speed_mpn_mul_n;
+  param.min_size = MIN (mul_fft_threshold, option_fft_max_size / 2);
+  param.max_size = option_fft_max_size;
+  param.check_size = option_fft_max_size;
+  param.step_factor = 0.1;
+  one (&mul_ntt_threshold, &param);
+}
+
+void
+tune_ntt_sqr (void)
+{
+  static struct param_t  param;
+
+  if (option_fft_max_size == 0 || GMP_NUMB_BITS != 64)
+    return;
+
+  param.name = "SQR_NTT_THRESHOLD";
+  param.function = speed_mpn_sqr;
+  param.min_size = MIN (sqr_fft_threshold, option_fft_max_size / 2);
+  param.max_size = option_fft_max_size;
+  param.check_size = option_fft_max_size;
+  param.step_factor = 0.1;
+  one (&sqr_ntt_threshold, &param);
+}
+
+/* Only tuned when there's more than one processor, using all of them.
+   Above the threshold the pieces are big enough that splitting keeps
+   paying, so if it doesn't win at the largest size it never will.  */
+void
+tune_mul_par (void)
+{
+  static struct param_t  param;
+  long  threads = 1;
+
+#if HAVE_SYSCONF && defined (_SC_NPROCESSORS_ONLN)
+  threads = sysconf (_SC_NPROCESSORS_ONLN);
+#endif
+  if (threads <= 1)
+    return;
+
+  s.r = threads;
+  param.name = "PARALLEL_MUL_THRESHOLD";
+  param.function = speed_mpn_mul_threads;
+  param.min_size = MAX (mul_toom22_threshold, 10);
+  param.max_size = 3000;
+  param.check_size = 3000;
+  param.step_factor = 0.05;
+  one (&parallel_mul_threshold, &param);
+  s.r = 0;
+}
+
 void
 tune_fac_ui (void)
 {
@@ -2880,9 +2984,12 @@ all (void)
   printf("\n");
 
   tune_fft_mul ();
+  tune_ntt_mul ();
+  tune_mul_par ();
   printf("\n");
 
   tune_fft_sqr ();
+  tune_ntt_sqr ();
   printf ("\n");
 
   tune_mullo ();
@@ -2916,6 +3023,7 @@ all (void)
   printf("\n");
 
   tune_matrix22_mul ();
+  tune_hgcd2 ();
   tune_hgcd ();
   tune_hgcd_appr ();
   tune_hgcd_reduce();